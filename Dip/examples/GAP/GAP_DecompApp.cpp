@@ -279,6 +279,31 @@ GAP_DecompApp::solveRelaxed(const int             whichBlock,
                                   varRedCost, varOrigCost);
    var->setBlockId(whichBlock);
    vars.push_back(var);
+   //---
+   //--- near-optimal alternatives (DIP keeps the best few per block)
+   //---
+   if (m_param.SubProbNumColsPerBlock != 1) {
+      vector< vector<int> > altInd;
+      vector<double>        altRedCost;
+      vector<double>        altOrigCost;
+      m_knap[whichBlock]->alternatives(whichBlock,
+                                       redCostXB,
+                                       origCostB,
+                                       solInd,
+                                       target,
+                                       m_param.SubProbNumColsPerBlock - 1,
+                                       altInd,
+                                       altRedCost,
+                                       altOrigCost);
+
+      for (size_t a = 0; a < altInd.size(); a++) {
+         vector<double> altEls(altInd[a].size(), 1.0);
+         var = new DecompVar(altInd[a], altEls,
+                             altRedCost[a], altOrigCost[a]);
+         var->setBlockId(whichBlock);
+         vars.push_back(var);
+      }
+   }
    UtilPrintFuncEnd(m_osLog, m_classTag,
                     "APPsolveRelaxed()", m_appParam.LogLevel, 2);
    return DecompSolStatOptimal;
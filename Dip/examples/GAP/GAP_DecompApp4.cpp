@@ -245,9 +245,6 @@ int GAP_DecompApp::createModelPartKP(DecompConstraintSet* model,
    //----  this is a sparse matrix, so use mapping between original
    //---   rowNames are not needed, they are used for debugging
    //---
-   const map<int, int>&   origToSparse = model->getMapOrigToSparse();
-   map<int, int>::const_iterator mit;
-
    for (it = whichKnaps.begin(); it != whichKnaps.end(); ++it) {
       i = *it;
       CoinPackedVector row;
@@ -255,9 +252,8 @@ int GAP_DecompApp::createModelPartKP(DecompConstraintSet* model,
 
       for (j = 0; j < nTasks; j++) {
          colIndex = getIndexIJ(i, j); //dense
-         mit      = origToSparse.find(colIndex);
-         assert(mit != origToSparse.end());
-         row.insert(mit->second, weight[colIndex]);
+         assert(model->getSparseIndex(colIndex) >= 0);
+         row.insert(model->getSparseIndex(colIndex), weight[colIndex]);
       }
 
       model->appendRow(row, -m_infinity, capacity[i], rowName);
@@ -272,6 +272,90 @@ public:
       }
    }
 
+   //---
+   //--- Near-optimal alternatives to the solution solInd (of solve):
+   //---   for each item k in it (least valuable first), drop k and refill
+   //---   the freed capacity greedily (best redCost per unit weight, k
+   //---   excluded). Up to maxAlt alternatives with redCost < target are
+   //---   returned (maxAlt <= 0 means one per item of solInd).
+   //---
+   void alternatives(const int                      blockB,
+                     const double*                  redCost,
+                     const double*                  origCost,
+                     const vector<int>&             solInd,
+                     const double                   target,
+                     const int                      maxAlt,
+                     vector< vector<int> >&         altInd,
+                     vector<double>&                altRedCost,
+                     vector<double>&                altOrigCost) {
+      int i, j;
+      const int    offset = getIndexIJ(blockB, 0);
+      const int    nSol   = static_cast<int>(solInd.size());
+      vector<char> inSol(m_nItems, 0);
+      int          load   = 0;
+
+      for (i = 0; i < nSol; i++) {
+         j        = solInd[i] - offset;
+         inSol[j] = 1;
+         load    += m_weight[j];
+      }
+
+      //---
+      //--- the items which can improve a column, by redCost per weight
+      //---
+      vector< pair<int, double> > cand;
+      vector< pair<int, double> > drop;
+
+      for (j = 0; j < m_nItems; j++) {
+         if (inSol[j]) {
+            drop.push_back(make_pair(j, -redCost[j]));
+         } else if (redCost[j] < 0.0) {
+            cand.push_back(make_pair(j, redCost[j] / m_weight[j]));
+         }
+      }
+
+      sort(cand.begin(), cand.end(), UtilIsLessThan<int, double>());
+      sort(drop.begin(), drop.end(), UtilIsLessThan<int, double>());
+
+      for (i = 0; i < static_cast<int>(drop.size()); i++) {
+         if (maxAlt > 0 && static_cast<int>(altInd.size()) >= maxAlt) {
+            break;
+         }
+
+         const int   k       = drop[i].first;
+         int         capLeft = m_capacity - load + m_weight[k];
+         double      rc      = 0.0;
+         double      oc      = 0.0;
+         vector<int> ind;
+
+         for (j = 0; j < m_nItems; j++) {
+            if (inSol[j] && j != k) {
+               ind.push_back(offset + j);
+               rc += redCost[j];
+               oc += origCost[j];
+            }
+         }
+
+         for (j = 0; j < static_cast<int>(cand.size()); j++) {
+            const int c = cand[j].first;
+
+            if (m_weight[c] <= capLeft) {
+               capLeft -= m_weight[c];
+               ind.push_back(offset + c);
+               rc += redCost[c];
+               oc += origCost[c];
+            }
+         }
+
+         if (rc < target) {
+            sort(ind.begin(), ind.end());
+            altInd.push_back(ind);
+            altRedCost.push_back(rc);
+            altOrigCost.push_back(oc);
+         }
+      }
+   }
+
 public:
    GAP_KnapPisinger(const int   nItems,
                     const int   capacity,
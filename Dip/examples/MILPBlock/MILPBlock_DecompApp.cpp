@@ -629,7 +629,6 @@ MILPBlock_DecompApp::createModelPartSparse(DecompConstraintSet * model,
    //--- for each row in rowsPart, create the row using sparse mapping
    //---
    int                      i, k, begInd;
-   const map<int,int>     & origToSparse   = model->getMapOrigToSparse();   
    const CoinPackedMatrix * M              = m_mpsIO.getMatrixByRow(); 
    const int              * matInd         = M->getIndices();
    const CoinBigIndex     * matBeg         = M->getVectorStarts();
@@ -641,7 +640,7 @@ MILPBlock_DecompApp::createModelPartSparse(DecompConstraintSet * model,
    vector<CoinBigIndex>   & rowBeg         = model->m_rowBeg;//used as temp
    vector<int         >   & rowInd         = model->m_rowInd;//used as temp
    vector<double      >   & rowVal         = model->m_rowVal;//used as temp
-   map<int,int>::const_iterator mit;
+   int                      sparseIndex;
 
    begInd = 0;
    rowBeg.push_back(0);
@@ -658,10 +657,10 @@ MILPBlock_DecompApp::createModelPartSparse(DecompConstraintSet * model,
       matIndI = matInd + matBeg[r];
       matValI = matVal + matBeg[r];
       for(k = 0; k < matLen[r]; k++){
-	 origIndex = matIndI[k];
-	 mit       = origToSparse.find(origIndex);
-	 assert(mit != origToSparse.end());
-	 rowInd.push_back(mit->second);
+	 origIndex   = matIndI[k];
+	 sparseIndex = model->getSparseIndex(origIndex);
+	 assert(sparseIndex >= 0);
+	 rowInd.push_back(sparseIndex);
 	 rowVal.push_back(matValI[k]);			  
       }
       begInd += matLen[r];
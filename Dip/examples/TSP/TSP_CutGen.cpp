@@ -29,8 +29,28 @@ int TSP_DecompApp::generateCutsSubtour(DecompCutList & newCuts){
    vector<ConcordeSubtourCut> subtourCuts;
 
    int c;
-   int n_subtour  = tspConcorde.generateCutsSubtour(subtourCuts);
+   int n_subtour  = 0;
    int n_prevcuts = static_cast<int>(newCuts.size());
+
+   if(m_appParam.CutSubtoursX == 2){
+      n_subtour = tspConcorde.generateCutsSubtour(subtourCuts);
+   }
+   else{
+      //---
+      //--- native separation (UtilGraphLib) on the support graph
+      //---
+      vector< vector<int> > sets;
+      n_subtour = UtilSeparateSubtours(tspConcorde.m_nVerts,
+				       tspConcorde.m_edgeList,
+				       tspConcorde.m_edgeValue, sets);
+      for(c = 0; c < n_subtour; c++){
+	 ConcordeSubtourCut subtourCut(tspConcorde.m_nVerts);
+	 subtourCut.S = sets[c];
+	 for(size_t i = 0; i < sets[c].size(); i++)
+	    subtourCut.inS[sets[c][i]] = true;
+	 subtourCuts.push_back(subtourCut);
+      }
+   }
    
    for(c = 0; c < n_subtour; c++){
       vector<int>  & S   = subtourCuts[c].S;
@@ -292,7 +292,13 @@ void TSP_DecompApp::solveOneTree(const double               * cost,
    property_map<Graph, edge_weight_t>::type e_weight_g = get(edge_weight, g);
 
    UtilGraphLib & graphLib = m_tsp.m_graphLib;
-   const int max_exchanges = 4; 
+   //---
+   //--- one 1-tree per exchange of the second edge at the depot
+   //---   (DIP keeps the best SubProbNumColsPerBlock of them)
+   //---
+   const int max_exchanges = m_param.SubProbNumColsPerBlock > 0 ?
+                             m_param.SubProbNumColsPerBlock :
+                             static_cast<int>(edge_cost.size());
 
    //---
    //--- (partial) sort in increasing order
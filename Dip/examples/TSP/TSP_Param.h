@@ -34,7 +34,7 @@ public:
    int    LogLevel;
    string DataDir;
    string Instance;
-   int    CutSubtoursX;
+   int    CutSubtoursX;   //0 = off, 1 = native (UtilGraphLib), 2 = Concorde
    //int    CutBlossomsX;
    //int    CutCombsX;
    string ModelNameCore;      //name of model core
@@ -47,6 +47,17 @@ void VRP_DecompApp::initializeApp()  {
    m_concorde.init(&m_vrp);
 #endif
 
+   //---
+   //--- init ESPPRC labeling solver
+   //---
+   if(m_appParam.ModelNameRelax == "ESPPRCC"){
+      m_espprc.init(&m_vrp,
+                    m_appParam.ESPPRCNgSize,
+                    m_appParam.ESPPRCMaxRoutes,
+                    m_appParam.ESPPRCMaxLabels,
+                    m_appParam.ESPPRCNumThreads);
+   }
+
    //---
    //--- read best known lb/ub 
    //---
@@ -182,12 +193,18 @@ void VRP_DecompApp::createModels(){
       setModelRelax(model, m_appParam.ModelNameRelax);
    }
 
+   //---
+   //--- one block per vehicle, each priced by the labeling solver in
+   //---   solveRelaxed (createModelESPPCC builds the same subproblem as
+   //---   a MIP, it is only kept for debugging)
+   //---
    if(m_appParam.ModelNameRelax == "ESPPRCC"){
-      DecompConstraintSet * model = new DecompConstraintSet();
-      createModelESPPCC(model);   
-      m_models.push_back(model);
-      m_modelESPPRC = model;
-      setModelRelax(model, m_appParam.ModelNameRelax);
+      int b;
+      for(b = 0; b < m_appParam.NumRoutes; b++){
+         DecompConstraintSet * model = new DecompConstraintSet();
+         m_models.push_back(model);
+         setModelRelax(model, m_appParam.ModelNameRelax, b);
+      }
    }
    
    UtilPrintFuncEnd(m_osLog, m_classTag,
@@ -303,6 +320,31 @@ int VRP_DecompApp::generateCuts(const double              * x,
 
    UtilGraphLib  & graphLib  = m_vrp.m_graphLib;
    const int       nEdges    = graphLib.n_edges;
+
+   if(m_appParam.CutCapacity == 1){
+      //---
+      //--- native rounded capacity heuristic (UtilGraphLib) on the
+      //---   support graph of x
+      //---
+      const int             nVerts = graphLib.n_vertices;
+      vector<int>           edgeList;
+      vector<double>        edgeValue;
+      vector< vector<int> > sets;
+      UtilSupportGraph(nEdges, x, edgeList, edgeValue, DecompEpsilon);
+      UtilSeparateCapacityCuts(nVerts, edgeList, edgeValue,
+                               graphLib.vertex_wt, graphLib.capacity, sets);
+      for(size_t c = 0; c < sets.size(); c++){
+         dynamic_bitset<> inS(nVerts);
+         for(size_t i = 0; i < sets[c].size(); i++)
+            inS.set(sets[c][i]);
+         newCuts.push_back(new VRP_GSECCut(inS, graphLib.vertex_wt,
+                                           graphLib.capacity, m_infinity));
+      }
+
+      UtilPrintFuncEnd(m_osLog, m_classTag,
+                       "generateCuts()", m_appParam.LogLevel, 2);
+      return newCuts.size();
+   }
    
    //---
    //--- calculate the number of nonzeros in vector x
@@ -387,17 +429,51 @@ DecompSolverStatus VRP_DecompApp::solveRelaxed(const int          whichBlock,
 
 
    if(m_appParam.ModelNameRelax == "ESPPRCC"){
-      const int          blockId         = 0;
-      const DecompAlgo * decompAlgo      = getDecompAlgo();
-      //DecompAlgoModel  & decompAlgoModel 
-        // = decompAlgo->getModelRelax(blockId);
-
-
+      //---
+      //--- the vehicles are identical, so all blocks see the same
+      //---   reduced costs - the solver caches the routes of the last
+      //---   call, so only the first block pays for the search
+      //---
+      const DecompAlgo      * decompAlgo = getDecompAlgo();
+      vector< vector<int> >   routes;
+      vector<double>          costs;
+      bool                    isExact;
+#ifdef _OPENMP
+#pragma omp critical (VRP_ESPPRC)
+#endif
+      {
+         isExact = m_espprc.solve(redCostX,
+                                  decompAlgo->getColLBNode(),
+                                  decompAlgo->getColUBNode(),
+                                  convexDual, routes, costs);
+      }
 
+      for(size_t r = 0; r < routes.size(); r++){
+         m_espprc.routeToEdges(routes[r], vrpRouteInd, vrpRouteEls);
+         double varOrigCost = 0.0;
+         for(i = 0; i < static_cast<int>(vrpRouteInd.size()); i++)
+            varOrigCost += vrpRouteEls[i] * m_objective[vrpRouteInd[i]];
+         UTIL_DEBUG(m_appParam.LogLevel, 5,
+		    (*m_osLog) << "VAR varRedCost=" << costs[r]-convexDual;
+		    (*m_osLog) << "varOrigCost=" << varOrigCost << endl;
+		    );
+
+         //DecompAlgo subtracts the convexity dual itself
+         DecompVar * var = new DecompVar(vrpRouteInd,
+                                         vrpRouteEls,
+                                         costs[r],
+                                         varOrigCost);
+         var->setBlockId(whichBlock);
+         varList.push_back(var);
+      }
 
-      //solve then map back and set to exact - cannot let 
-      // built in solve it
-      exit(1);
+      //---
+      //--- a search which is not exact returns at least a route 0-i-0
+      //---   (or 0-i-j-0) when it found no elementary route with negative
+      //---   reduced cost, so DIP does not fall back on its own solver here -
+      //---   there is no relaxed model for it to use
+      //---
+      solverStatus = isExact ? DecompSolStatOptimal : DecompSolStatFeasible;
    }
 
 
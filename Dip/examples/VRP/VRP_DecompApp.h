@@ -20,6 +20,7 @@
 #include "DecompApp.h"
 #include "VRP_Boost.h"
 #include "VRP_CVRPsep.h"
+#include "VRP_ESPPRC.h"
 #include "VRP_Instance.h"
 #include "VRP_Param.h"
 // --------------------------------------------------------------------- //
@@ -56,6 +57,9 @@ private:
    /** Interface class for Boost methods. */
    VRP_Boost       m_boost;
 
+   /** Labeling solver for the ESPPRC (route) pricing problem. */
+   VRP_ESPPRC      m_espprc;
+
    /** Interface class for Concorde methods. */
 #ifdef VRP_DECOMPAPP_USECONCORDE
    VRP_Concorde    m_concorde;
@@ -66,7 +70,6 @@ private:
 
    /** The various model constraint systems used for different algos. */
    vector<DecompConstraintSet*>   m_models;
-   DecompConstraintSet          * m_modelESPPRC;
 
 public:
    /* @name Inherited (from virtual) methods. */
@@ -119,8 +122,7 @@ public:
    VRP_DecompApp(UtilParameters & utilParam) : 
       DecompApp(utilParam),
       m_classTag("VRP-APP"),
-	m_objective(NULL),
-	m_modelESPPRC(NULL)
+	m_objective(NULL)
    {
       //---
       //--- get application parameters
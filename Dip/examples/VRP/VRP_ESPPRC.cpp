@@ -0,0 +1,715 @@
+//===========================================================================//
+// This file is part of the Decomp Solver Framework.                         //
+//                                                                           //
+// Decomp is distributed under the Common Public License as part of the      //
+// COIN-OR repository (http://www.coin-or.org).                              //
+//                                                                           //
+// Authors: Matthew Galati, SAS Institute Inc. (matthew.galati@sas.com)      //
+//          Ted Ralphs, Lehigh University (ted@lehigh.edu)                   //
+//          Jiadong Wang, Lehigh University (jiw408@lehigh.edu)              //
+//                                                                           //
+// Copyright (C) 2002-2015, Lehigh University, Matthew Galati, and Ted Ralphs//
+// All Rights Reserved.                                                      //
+//===========================================================================//
+
+//===========================================================================//
+#include "Decomp.h"
+#include "UtilMacros.h"
+//===========================================================================//
+#include "VRP_ESPPRC.h"
+//===========================================================================//
+#ifdef _OPENMP
+#include "omp.h"
+#endif
+
+//===========================================================================//
+static bool isElementary(const std::vector<int>& route,
+                         const int          nVertices)
+{
+   std::vector<bool> visited(nVertices, false);
+
+   for (size_t k = 0; k < route.size(); k++) {
+      if (visited[route[k]]) {
+         return false;
+      }
+
+      visited[route[k]] = true;
+   }
+
+   return true;
+}
+
+//===========================================================================//
+void VRP_ESPPRC::init(const VRP_Instance* vrp,
+                      const int           ngSize,
+                      const int           maxRoutes,
+                      const int           maxLabels,
+                      const int           numThreads)
+{
+   const UtilGraphLib& graphLib  = vrp->m_graphLib;
+   const int           nVertices = graphLib.n_vertices;
+   int                 i, j, k;
+   m_vrp        = vrp;
+   m_ngSize     = std::max<int>(1, std::min<int>(ngSize, 64));
+   m_maxRoutes  = std::max<int>(1, maxRoutes);
+   m_maxLabels  = maxLabels;
+   m_numThreads = std::max<int>(1, numThreads);
+   m_nCustomers = nVertices - 1;
+   m_capacity   = graphLib.capacity;
+   m_demand.assign(graphLib.vertex_wt, graphLib.vertex_wt + nVertices);
+   m_demand[0]  = 0;
+   //---
+   //--- the ng-neighborhood of i is i and its NgSize-1 nearest customers
+   //---
+   m_ngSet.assign(nVertices, std::vector<int>());
+   m_ngPos.assign(nVertices, std::vector<int>(nVertices, -1));
+
+   for (i = 1; i < nVertices; i++) {
+      std::vector< std::pair<int, int> > dist;
+
+      for (j = 1; j < nVertices; j++) {
+         if (j != i) {
+            dist.push_back(std::make_pair(graphLib.edge_wt[UtilIndexU(i, j)], j));
+         }
+      }
+
+      const int nNear = std::min<int>(m_ngSize - 1,
+                                      static_cast<int>(dist.size()));
+      std::partial_sort(dist.begin(), dist.begin() + nNear, dist.end());
+      m_ngPos[i][i] = 0;
+      m_ngSet[i].push_back(i);
+
+      for (k = 0; k < nNear; k++) {
+         m_ngPos[i][dist[k].second] = static_cast<int>(m_ngSet[i].size());
+         m_ngSet[i].push_back(dist[k].second);
+      }
+   }
+
+   m_labels.assign(nVertices, std::vector<Label>());
+   m_lastRedCost.clear();
+   m_lastRoutes.clear();
+   m_lastCosts.clear();
+}
+
+//===========================================================================//
+void VRP_ESPPRC::setBounds(const double* colLB)
+{
+   const int nVertices = m_nCustomers + 1;
+   int       i, j;
+   m_forced.assign(nVertices, std::vector<int>());
+   m_forcedSingle.assign(nVertices, false);
+
+   for (i = 1; i < nVertices; i++) {
+      for (j = 0; j < i; j++) {
+         const double lb = colLB[UtilIndexU(i, j)];
+
+         if (lb < 0.5) {
+            continue;
+         }
+
+         if (j == 0 && lb > 1.5) {
+            m_forcedSingle[i] = true;
+            continue;
+         }
+
+         m_forced[i].push_back(j);
+
+         if (j != 0) {
+            m_forced[j].push_back(i);
+         }
+      }
+   }
+}
+
+//===========================================================================//
+void VRP_ESPPRC::runLabeling(const double* redCostX,
+                             const double* colUB)
+{
+   //---
+   //--- Labels are extended one customer at a time: each round extends
+   //---   all the labels created by the previous round. Within a round,
+   //---   the extensions are computed in parallel over the labels, then
+   //---   the dominance checks are done in parallel over the vertices
+   //---   (labels at different vertices never dominate each other).
+   //---
+   //--- L1 dominates L2 (at the same vertex) if it costs no more, loads
+   //---   no more and remembers no more customers. At a customer with a
+   //---   forced edge, the predecessor also has to match.
+   //---
+   const int nVertices = m_nCustomers + 1;
+   const int nThreads  = m_numThreads;
+   int       v, w;
+   int       nLabels   = 0;
+   std::vector< std::pair<int, int> > frontier;
+   m_truncated = false;
+
+   for (v = 0; v < nVertices; v++) {
+      m_labels[v].clear();
+   }
+
+   for (w = 1; w < nVertices; w++) {
+      if (colUB[UtilIndexU(0, w)] < 0.5 ||
+            m_demand[w] > m_capacity) {
+         continue;
+      }
+
+      Label L;
+      L.vertex    = w;
+      L.pred      = 0;
+      L.parent    = -1;
+      L.load      = m_demand[w];
+      L.cost      = redCost(redCostX, 0, w);
+      L.ngMem     = 1ULL << m_ngPos[w][w];
+      L.dominated = false;
+      m_labels[w].push_back(L);
+      frontier.push_back(std::make_pair(w, 0));
+   }
+
+   nLabels = static_cast<int>(frontier.size());
+
+   while (!frontier.empty()) {
+      const int nFront = static_cast<int>(frontier.size());
+      std::vector< std::vector<Label> > threadCands(nThreads);
+      //---
+      //--- extend (only the labels with load <= Q/2, see header)
+      //---
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(static) num_threads(nThreads)
+#endif
+
+      for (int f = 0; f < nFront; f++) {
+#ifdef _OPENMP
+         const int tid = omp_get_thread_num();
+#else
+         const int tid = 0;
+#endif
+         const int    u = frontier[f].first;
+         const Label& L = m_labels[u][frontier[f].second];
+
+         if (L.dominated || 2 * L.load > m_capacity) {
+            continue;
+         }
+
+         for (int x = 1; x < nVertices; x++) {
+            if (x == u                                   ||
+                  L.load + m_demand[x] > m_capacity       ||
+                  colUB[UtilIndexU(u, x)] < 0.5           ||
+                  m_forcedSingle[x]) {
+               continue;
+            }
+
+            const int pos = m_ngPos[u][x];
+
+            if (pos >= 0 && ((L.ngMem >> pos) & 1ULL)) {
+               continue;
+            }
+
+            if (!respectsForced(u, L.pred, x)) {
+               continue;
+            }
+
+            //both edges at x are forced, and (u,x) is not one of them
+            if (m_forced[x].size() >= 2 &&
+                  m_forced[x][0] != u && m_forced[x][1] != u) {
+               continue;
+            }
+
+            Label N;
+            N.vertex    = x;
+            N.pred      = u;
+            N.parent    = frontier[f].second;
+            N.load      = L.load + m_demand[x];
+            N.cost      = L.cost + redCost(redCostX, u, x);
+            N.ngMem     = moveNgMem(L.ngMem, u, x) | (1ULL << m_ngPos[x][x]);
+            N.dominated = false;
+            threadCands[tid].push_back(N);
+         }
+      }
+
+      std::vector< std::vector<Label> > byVertex(nVertices);
+      std::vector< std::vector<int> >   newLabels(nVertices);
+
+      for (int t = 0; t < nThreads; t++) {
+         std::vector<Label>::const_iterator it;
+
+         for (it = threadCands[t].begin(); it != threadCands[t].end(); ++it) {
+            byVertex[it->vertex].push_back(*it);
+         }
+      }
+
+      //---
+      //--- dominance
+      //---
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+
+      for (int x = 1; x < nVertices; x++) {
+         std::vector<Label>& labels      = m_labels[x];
+         const bool     checkPred   = !m_forced[x].empty();
+         std::vector<Label>::const_iterator it;
+
+         for (it = byVertex[x].begin(); it != byVertex[x].end(); ++it) {
+            const Label& N   = *it;
+            bool         dom = false;
+            size_t       k;
+
+            for (k = 0; k < labels.size(); k++) {
+               const Label& L = labels[k];
+
+               if (!L.dominated                           &&
+                     L.cost <= N.cost                      &&
+                     L.load <= N.load                      &&
+                     (L.ngMem & ~N.ngMem) == 0             &&
+                     (!checkPred || L.pred == N.pred)) {
+                  dom = true;
+                  break;
+               }
+            }
+
+            if (dom) {
+               continue;
+            }
+
+            for (k = 0; k < labels.size(); k++) {
+               Label& L = labels[k];
+
+               if (!L.dominated                           &&
+                     N.cost <= L.cost                      &&
+                     N.load <= L.load                      &&
+                     (N.ngMem & ~L.ngMem) == 0             &&
+                     (!checkPred || L.pred == N.pred)) {
+                  L.dominated = true;
+               }
+            }
+
+            labels.push_back(N);
+            newLabels[x].push_back(static_cast<int>(labels.size()) - 1);
+         }
+      }
+
+      frontier.clear();
+
+      for (w = 1; w < nVertices; w++) {
+         std::vector<int>::const_iterator it;
+
+         for (it = newLabels[w].begin(); it != newLabels[w].end(); ++it) {
+            if (!m_labels[w][*it].dominated) {
+               frontier.push_back(std::make_pair(w, *it));
+            }
+         }
+      }
+
+      nLabels += static_cast<int>(frontier.size());
+
+      if (m_maxLabels > 0 && nLabels > m_maxLabels) {
+         m_truncated = true;
+         break;
+      }
+   }
+}
+
+//===========================================================================//
+void VRP_ESPPRC::collectRoutes(const double*       redCostX,
+                               const double*       colUB,
+                               const double        threshold,
+                               std::vector<Candidate>& cands) const
+{
+   //---
+   //--- a route is a label closed at the depot, or two labels at v and w
+   //---   joined by the edge (v,w) - the second one with load <= Q/2
+   //---
+   //--- each thread keeps its best maxCands routes (a max-heap on cost),
+   //---   enough to return MaxRoutes distinct elementary routes in most
+   //---   cases (each route can be found from several splits)
+   //---
+   const int nVertices = m_nCustomers + 1;
+   const int nThreads  = m_numThreads;
+   const int maxCands  = std::max<int>(16, 4 * m_maxRoutes);
+   std::vector< std::vector<Candidate> > heaps(nThreads);
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+
+   for (int v = 1; v < nVertices; v++) {
+#ifdef _OPENMP
+      const int tid = omp_get_thread_num();
+#else
+      const int tid = 0;
+#endif
+      std::vector<Candidate>&   heap    = heaps[tid];
+      const std::vector<Label>& labels1 = m_labels[v];
+      const int            e0      = UtilIndexU(v, 0);
+
+      for (int i1 = 0; i1 < static_cast<int>(labels1.size()); i1++) {
+         const Label& L1 = labels1[i1];
+
+         if (L1.dominated) {
+            continue;
+         }
+
+         Candidate cand;
+         cand.cost = L1.cost + redCostX[e0];
+         cand.v1   = v;
+         cand.i1   = i1;
+         cand.v2   = 0;
+         cand.i2   = -1;
+
+         //0-v-0 uses (0,v) twice
+         if (cand.cost < threshold                     &&
+               colUB[e0] > (L1.pred == 0 ? 1.5 : 0.5)   &&
+               respectsForced(v, L1.pred, 0)) {
+            if (static_cast<int>(heap.size()) < maxCands) {
+               heap.push_back(cand);
+               std::push_heap(heap.begin(), heap.end());
+            } else if (cand.cost < heap.front().cost) {
+               std::pop_heap(heap.begin(), heap.end());
+               heap.back() = cand;
+               std::push_heap(heap.begin(), heap.end());
+            }
+         }
+
+         for (int w = 1; w < nVertices; w++) {
+            const int e = UtilIndexU(v, w);
+
+            if (w == v || colUB[e] < 0.5) {
+               continue;
+            }
+
+            const int pos = m_ngPos[v][w];
+
+            if (pos >= 0 && ((L1.ngMem >> pos) & 1ULL)) {
+               continue;
+            }
+
+            if (!respectsForced(v, L1.pred, w)) {
+               continue;
+            }
+
+            const unsigned long long wBit = 1ULL << m_ngPos[w][w];
+            const unsigned long long mem1 = moveNgMem(L1.ngMem, v, w) | wBit;
+            const double             base = L1.cost + redCostX[e];
+            const std::vector<Label>&     labels2 = m_labels[w];
+
+            for (int i2 = 0; i2 < static_cast<int>(labels2.size()); i2++) {
+               const Label& L2 = labels2[i2];
+
+               if (L2.dominated                          ||
+                     2 * L2.load > m_capacity             ||
+                     L1.load + L2.load > m_capacity       ||
+                     base + L2.cost >= threshold          ||
+                     (mem1 & L2.ngMem) != wBit            ||
+                     !respectsForced(w, L2.pred, v)) {
+                  continue;
+               }
+
+               cand.cost = base + L2.cost;
+               cand.v2   = w;
+               cand.i2   = i2;
+
+               if (static_cast<int>(heap.size()) < maxCands) {
+                  heap.push_back(cand);
+                  std::push_heap(heap.begin(), heap.end());
+               } else if (cand.cost < heap.front().cost) {
+                  std::pop_heap(heap.begin(), heap.end());
+                  heap.back() = cand;
+                  std::push_heap(heap.begin(), heap.end());
+               }
+            }
+         }
+      }
+   }
+
+   cands.clear();
+
+   for (int t = 0; t < nThreads; t++) {
+      cands.insert(cands.end(), heaps[t].begin(), heaps[t].end());
+   }
+
+   std::sort(cands.begin(), cands.end());
+}
+
+//===========================================================================//
+void VRP_ESPPRC::getRoute(const Candidate& cand,
+                          std::vector<int>&     route) const
+{
+   int v = cand.v1;
+   int i = cand.i1;
+   route.clear();
+
+   while (i >= 0) {
+      const Label& L = m_labels[v][i];
+      route.push_back(v);
+      i = L.parent;
+      v = L.pred;
+   }
+
+   std::reverse(route.begin(), route.end());
+   v = cand.v2;
+   i = cand.i2;
+
+   while (i >= 0) {
+      const Label& L = m_labels[v][i];
+      route.push_back(v);
+      i = L.parent;
+      v = L.pred;
+   }
+}
+
+//===========================================================================//
+bool VRP_ESPPRC::augmentNg(const std::vector<int>& route)
+{
+   //---
+   //--- for each cycle u ... u in the route, add u to the neighborhood
+   //---   of every customer inside the cycle, so the next search cannot
+   //---   repeat it
+   //---
+   const int n       = static_cast<int>(route.size());
+   bool      changed = false;
+
+   for (int q = 0; q < n; q++) {
+      const int u = route[q];
+      int       p;
+
+      for (p = q - 1; p >= 0 && route[p] != u; p--) {
+      }
+
+      if (p < 0) {
+         continue;
+      }
+
+      for (int k = p + 1; k < q; k++) {
+         const int x = route[k];
+
+         if (m_ngPos[x][u] < 0 && m_ngSet[x].size() < 64) {
+            m_ngPos[x][u] = static_cast<int>(m_ngSet[x].size());
+            m_ngSet[x].push_back(u);
+            changed = true;
+         }
+      }
+   }
+
+   return changed;
+}
+
+//===========================================================================//
+bool VRP_ESPPRC::solve(const double*          redCostX,
+                       const double*          colLB,
+                       const double*          colUB,
+                       const double           alpha,
+                       std::vector< std::vector<int> >& routes,
+                       std::vector<double>&        costs)
+{
+   const UtilGraphLib& graphLib  = m_vrp->m_graphLib;
+   const int           nEdges    = graphLib.n_edges;
+   const int           nVertices = graphLib.n_vertices;
+   const double        threshold = alpha - DecompEpsilon;
+   //bound on the rounds of neighborhood augmentation
+   const int           maxNgIter = 50;
+   routes.clear();
+   costs.clear();
+
+   //---
+   //--- same reduced costs and bounds as the last call, and the routes
+   //---   we kept then are a superset of what we need now
+   //---
+   if (static_cast<int>(m_lastRedCost.size()) == nEdges         &&
+         alpha <= m_lastAlpha                                    &&
+         std::equal(m_lastRedCost.begin(), m_lastRedCost.end(), redCostX) &&
+         std::equal(m_lastLB.begin(), m_lastLB.end(), colLB)             &&
+         std::equal(m_lastUB.begin(), m_lastUB.end(), colUB)) {
+      for (size_t r = 0; r < m_lastRoutes.size(); r++) {
+         if (m_lastCosts[r] < threshold) {
+            routes.push_back(m_lastRoutes[r]);
+            costs.push_back(m_lastCosts[r]);
+         }
+      }
+
+      if (routes.empty() && !m_lastExact) {
+         addSingleRoute(redCostX, colUB, routes, costs);
+      }
+
+      return m_lastExact;
+   }
+
+   setBounds(colLB);
+   bool              isExact   = false;
+   const int         maxLabels = m_maxLabels;
+   std::vector<Candidate> cands;
+   std::vector<int>       route;
+
+   for (int iter = 0; ; iter++) {
+      runLabeling(redCostX, colUB);
+      collectRoutes(redCostX, colUB, threshold, cands);
+
+      if (cands.empty()) {
+         if (m_truncated) {
+            //nothing found in the truncated search, it has to be proven
+            m_maxLabels = 0;
+            continue;
+         }
+
+         isExact = true;
+         break;
+      }
+
+      getRoute(cands[0], route);
+
+      if (isElementary(route, nVertices)) {
+         isExact = !m_truncated;
+         break;
+      }
+
+      if (iter >= maxNgIter) {
+         break;
+      }
+
+      //---
+      //--- if the cycles of the best route can not be forbidden (its ng
+      //---   sets are full), try those of the next routes
+      //---
+      bool changed = augmentNg(route);
+
+      for (size_t c = 1; !changed && c < cands.size(); c++) {
+         getRoute(cands[c], route);
+         changed = augmentNg(route);
+      }
+
+      if (!changed) {
+         break;
+      }
+   }
+
+   m_maxLabels = maxLabels;
+   //---
+   //--- keep the best distinct elementary routes
+   //---
+   std::set< std::vector<int> > seen;
+   std::vector<Candidate>::const_iterator it;
+
+   for (it = cands.begin(); it != cands.end(); ++it) {
+      getRoute(*it, route);
+
+      if (!isElementary(route, nVertices)) {
+         continue;
+      }
+
+      std::vector<int> key(route);
+
+      if (key.back() < key.front()) {
+         std::reverse(key.begin(), key.end());
+      }
+
+      if (!seen.insert(key).second) {
+         continue;
+      }
+
+      routes.push_back(route);
+      costs.push_back(it->cost);
+
+      if (static_cast<int>(routes.size()) >= m_maxRoutes) {
+         break;
+      }
+   }
+
+   //---
+   //--- a search which is not exact may have found only non-elementary
+   //---   routes; DIP would then fall back on its own solver, but there
+   //---   is no relaxed model for it to use
+   //---
+   if (routes.empty() && !isExact) {
+      addSingleRoute(redCostX, colUB, routes, costs);
+   }
+
+   m_lastRedCost.assign(redCostX, redCostX + nEdges);
+   m_lastLB.assign(colLB, colLB + nEdges);
+   m_lastUB.assign(colUB, colUB + nEdges);
+   m_lastAlpha  = alpha;
+   m_lastExact  = isExact;
+   m_lastRoutes = routes;
+   m_lastCosts  = costs;
+   return isExact;
+}
+
+//===========================================================================//
+bool VRP_ESPPRC::addSingleRoute(const double*                    redCostX,
+                                const double*                    colUB,
+                                std::vector< std::vector<int> >& routes,
+                                std::vector<double>&             costs) const
+{
+   //---
+   //--- the best route 0-i-0, or else 0-i-j-0 (always elementary), within
+   //---   the node bounds
+   //---
+   std::vector<int> best;
+   double           bestCost = 0.0;
+   int              i, j;
+
+   for (i = 1; i <= m_nCustomers; i++) {
+      const double cost = 2.0 * redCost(redCostX, 0, i);
+
+      if (colUB[UtilIndexU(0, i)] < 1.5 || !respectsForced(i, 0, 0) ||
+            m_demand[i] > m_capacity) {
+         continue;
+      }
+
+      if (best.empty() || cost < bestCost) {
+         best.assign(1, i);
+         bestCost = cost;
+      }
+   }
+
+   const bool noSingle = best.empty();
+
+   for (i = 1; noSingle && i <= m_nCustomers; i++) {
+      for (j = i + 1; j <= m_nCustomers; j++) {
+         const double cost = redCost(redCostX, 0, i) + redCost(redCostX, i, j)
+                             + redCost(redCostX, j, 0);
+
+         if (colUB[UtilIndexU(0, i)] < 0.5 || colUB[UtilIndexU(i, j)] < 0.5 ||
+               colUB[UtilIndexU(j, 0)] < 0.5 ||
+               !respectsForced(i, 0, j) || !respectsForced(j, i, 0) ||
+               m_demand[i] + m_demand[j] > m_capacity) {
+            continue;
+         }
+
+         if (best.empty() || cost < bestCost) {
+            best.assign(1, i);
+            best.push_back(j);
+            bestCost = cost;
+         }
+      }
+   }
+
+   if (best.empty()) {
+      return false;
+   }
+
+   routes.push_back(best);
+   costs.push_back(bestCost);
+   return true;
+}
+
+//===========================================================================//
+void VRP_ESPPRC::routeToEdges(const std::vector<int>& route,
+                              std::vector<int>&       edgeInd,
+                              std::vector<double>&    edgeEls) const
+{
+   std::map<int, double> edges;
+   int              prev = 0;
+
+   for (size_t k = 0; k < route.size(); k++) {
+      edges[UtilIndexU(prev, route[k])] += 1.0;
+      prev = route[k];
+   }
+
+   edges[UtilIndexU(prev, 0)] += 1.0;
+   edgeInd.clear();
+   edgeEls.clear();
+   std::map<int, double>::const_iterator mi;
+
+   for (mi = edges.begin(); mi != edges.end(); ++mi) {
+      edgeInd.push_back(mi->first);
+      edgeEls.push_back(mi->second);
+   }
+}
@@ -0,0 +1,221 @@
+//===========================================================================//
+// This file is part of the Decomp Solver Framework.                         //
+//                                                                           //
+// Decomp is distributed under the Common Public License as part of the      //
+// COIN-OR repository (http://www.coin-or.org).                              //
+//                                                                           //
+// Authors: Matthew Galati, SAS Institute Inc. (matthew.galati@sas.com)      //
+//          Ted Ralphs, Lehigh University (ted@lehigh.edu)                   //
+//          Jiadong Wang, Lehigh University (jiw408@lehigh.edu)              //
+//                                                                           //
+// Copyright (C) 2002-2015, Lehigh University, Matthew Galati, and Ted Ralphs//
+// All Rights Reserved.                                                      //
+//===========================================================================//
+
+#ifndef VRP_ESPPRC_INCLUDED
+#define VRP_ESPPRC_INCLUDED
+
+//---
+//--- Labeling solver for the Elementary Shortest Path Problem with
+//---   Resource (capacity) Constraints - the pricing problem of the
+//---   VRP when a column is a single route.
+//---
+//--- Routes start and end at the depot (vertex 0) and are priced in the
+//---   original (undirected) edge space, so the cost of a route is the
+//---   sum of the reduced costs of its edges. Since that cost is
+//---   symmetric, the backward labels of a bidirectional search are the
+//---   forward labels: paths are extended from the depot only while their
+//---   load is at most Q/2, and routes are closed by joining two paths
+//---   over an edge (or one path back to the depot).
+//---
+//--- Elementarity is relaxed to ng-routes: a label only remembers the
+//---   visited customers which are in the ng-neighborhood (the NgSize
+//---   nearest customers) of its last vertex. If the best route found
+//---   has a cycle, the vertices of the cycle are added to the
+//---   neighborhoods and the search is repeated (dynamic ng), so the
+//---   answer is exact once the best route is elementary. Neighborhoods
+//---   hold at most 64 customers (one word of memory per label).
+//---
+//--- Branching bounds on the edges are respected: edges with ub = 0 are
+//---   not used, edges with lb = 1 must be used by any route which visits
+//---   one of their ends.
+//---
+
+// --------------------------------------------------------------------- //
+#include "VRP_Instance.h"
+
+// --------------------------------------------------------------------- //
+class VRP_ESPPRC {
+private:
+   /** A partial path from the depot. */
+   struct Label {
+      int                vertex;   //last customer on the path
+      int                pred;     //vertex before it (0 = depot)
+      int                parent;   //index of the parent label at pred
+      int                load;     //demand of the customers on the path
+      double             cost;     //reduced cost of the edges on the path
+      unsigned long long ngMem;    //bit k: m_ngSet[vertex][k] was visited
+      bool               dominated;
+   };
+
+   /** A route, as two labels joined by an edge (or closed at the depot). */
+   struct Candidate {
+      double cost;
+      int    v1, i1;               //label m_labels[v1][i1]
+      int    v2, i2;               //label m_labels[v2][i2], v2 = 0 if closed
+      bool operator<(const Candidate& rhs) const {
+         return cost < rhs.cost;
+      }
+   };
+
+private:
+   /** Pointer to the VRP instance. */
+   const VRP_Instance* m_vrp;
+
+   /** Parameters. */
+   int    m_ngSize;
+   int    m_maxRoutes;
+   int    m_maxLabels;
+   int    m_numThreads;
+
+   /** Number of customers (1..n), demands (0 = depot) and capacity. */
+   int              m_nCustomers;
+   std::vector<int> m_demand;
+   int              m_capacity;
+
+   /** ng-neighborhoods: m_ngSet[i] (customers), m_ngPos[i][j] = position
+       of j in m_ngSet[i] or -1. */
+   std::vector< std::vector<int> > m_ngSet;
+   std::vector< std::vector<int> > m_ngPos;
+
+   /** Node bounds in this call: forced neighbors of each customer, and
+       customers which can only be served by 0-i-0 (lb(0,i) = 2). */
+   std::vector< std::vector<int> > m_forced;
+   std::vector<bool>               m_forcedSingle;
+
+   /** Labels, by last vertex. */
+   std::vector< std::vector<Label> > m_labels;
+
+   /** Set if the last search stopped at m_maxLabels. */
+   bool m_truncated;
+
+   /** Cache of the last call (all blocks of the VRP have the same
+       reduced costs, only the convexity dual differs). */
+   std::vector<double>             m_lastRedCost;
+   std::vector<double>             m_lastLB;
+   std::vector<double>             m_lastUB;
+   double                          m_lastAlpha;
+   bool                            m_lastExact;
+   std::vector< std::vector<int> > m_lastRoutes;
+   std::vector<double>             m_lastCosts;
+
+private:
+   inline double redCost(const double* redCostX,
+                         const int     i,
+                         const int     j) const {
+      return redCostX[UtilIndexU(i, j)];
+   }
+
+   /** Are the forced edges at v among (a,v) and (v,b)? */
+   inline bool respectsForced(const int v,
+                              const int a,
+                              const int b) const {
+      if (m_forcedSingle[v] && (a != 0 || b != 0)) {
+         return false;
+      }
+
+      std::vector<int>::const_iterator it;
+
+      for (it = m_forced[v].begin(); it != m_forced[v].end(); ++it) {
+         if (*it != a && *it != b) {
+            return false;
+         }
+      }
+
+      return true;
+   }
+
+   /** ng memory of label L (at v) after moving to w (w not included). */
+   inline unsigned long long moveNgMem(const unsigned long long mem,
+                                       const int                v,
+                                       const int                w) const {
+      unsigned long long newMem = 0;
+      const std::vector<int>& ngV = m_ngSet[v];
+      const std::vector<int>& posW = m_ngPos[w];
+
+      for (size_t k = 0; k < ngV.size(); k++) {
+         if ((mem >> k) & 1ULL) {
+            const int pos = posW[ngV[k]];
+
+            if (pos >= 0) {
+               newMem |= 1ULL << pos;
+            }
+         }
+      }
+
+      return newMem;
+   }
+
+   void setBounds(const double* colLB);
+   void runLabeling(const double* redCostX,
+                    const double* colUB);
+   void collectRoutes(const double*            redCostX,
+                      const double*            colUB,
+                      const double             threshold,
+                      std::vector<Candidate>& cands) const;
+   void getRoute(const Candidate&  cand,
+                 std::vector<int>& route) const;
+   bool augmentNg(const std::vector<int>& route);
+   bool addSingleRoute(const double*                    redCostX,
+                       const double*                    colUB,
+                       std::vector< std::vector<int> >& routes,
+                       std::vector<double>&             costs) const;
+
+public:
+   /** Set the instance, build the initial ng-neighborhoods. */
+   void init(const VRP_Instance* vrp,
+             const int           ngSize,
+             const int           maxRoutes,
+             const int           maxLabels,
+             const int           numThreads);
+
+   /**
+    * Find up to maxRoutes elementary routes with cost - alpha < 0 (cost
+    *   is the sum of redCostX over the edges of the route), best first,
+    *   within the node bounds colLB/colUB (edge space).
+    * Returns true if the search was exact, that is, routes[0] (if any)
+    *   is a best route and no route has cost - alpha < 0 otherwise.
+    * A search which is not exact (truncated, or stopped before the ng
+    *   relaxation gave an elementary route) and found no route returns
+    *   the best route 0-i-0 (or 0-i-j-0) within the bounds, whatever its
+    *   cost.
+    */
+   bool solve(const double*                    redCostX,
+              const double*                    colLB,
+              const double*                    colUB,
+              const double                     alpha,
+              std::vector< std::vector<int> >& routes,
+              std::vector<double>&             costs);
+
+   /** Edges of a route (customers in order, depot omitted). */
+   void routeToEdges(const std::vector<int>& route,
+                     std::vector<int>&       edgeInd,
+                     std::vector<double>&    edgeEls) const;
+
+public:
+   VRP_ESPPRC() :
+      m_vrp       (0),
+      m_ngSize    (8),
+      m_maxRoutes (10),
+      m_maxLabels (1000000),
+      m_numThreads(1),
+      m_nCustomers(0),
+      m_capacity  (0),
+      m_truncated (false),
+      m_lastAlpha (0.0),
+      m_lastExact (false)
+   {}
+   ~VRP_ESPPRC() {}
+};
+
+#endif
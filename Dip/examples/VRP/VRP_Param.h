@@ -35,6 +35,11 @@ public:
    string ModelNameCore;      //name of model core
    string ModelNameRelax;     //name of model relax
    string ModelNameRelaxNest; //name of nested model relax
+   int    ESPPRCNgSize;       //initial size of ng-neighborhoods
+   int    ESPPRCMaxRoutes;    //max routes returned per pricing call
+   int    ESPPRCMaxLabels;    //max labels per search (0 = no limit)
+   int    ESPPRCNumThreads;   //threads for label extension
+   int    CutCapacity;        //capacity cuts: 1 = native, 2 = CVRPSEP
    
 public:
    void getSettings(UtilParameters & utilParam){
@@ -49,6 +54,16 @@ public:
          = utilParam.GetSetting("ModelNameRelax", "", common);
       ModelNameRelaxNest 
          = utilParam.GetSetting("ModelNameRelaxNest", "", common);
+      ESPPRCNgSize
+         = utilParam.GetSetting("ESPPRCNgSize",       8, common);
+      ESPPRCMaxRoutes
+         = utilParam.GetSetting("ESPPRCMaxRoutes",   10, common);
+      ESPPRCMaxLabels
+         = utilParam.GetSetting("ESPPRCMaxLabels", 1000000, common);
+      ESPPRCNumThreads
+         = utilParam.GetSetting("ESPPRCNumThreads",   1, common);
+      CutCapacity
+         = utilParam.GetSetting("CutCapacity",        1, common);
    }
 
    void dumpSettings(ostream * os = &cout){
@@ -62,6 +77,11 @@ public:
       (*os) << common << ": ModelNameCore     : " << ModelNameCore     << endl;
       (*os) << common << ": ModelNameRelax    : " << ModelNameRelax    << endl;
       (*os) << common << ": ModelNameRelaxNest: " << ModelNameRelaxNest<< endl;
+      (*os) << common << ": ESPPRCNgSize      : " << ESPPRCNgSize      << endl;
+      (*os) << common << ": ESPPRCMaxRoutes   : " << ESPPRCMaxRoutes   << endl;
+      (*os) << common << ": ESPPRCMaxLabels   : " << ESPPRCMaxLabels   << endl;
+      (*os) << common << ": ESPPRCNumThreads  : " << ESPPRCNumThreads  << endl;
+      (*os) << common << ": CutCapacity       : " << CutCapacity       << endl;
       (*os) <<   "=====================================================\n";
    }
 
@@ -73,7 +93,12 @@ public:
       NumRoutes         (0 ),
       ModelNameCore     (""),
       ModelNameRelax    (""),
-      ModelNameRelaxNest("")      
+      ModelNameRelaxNest(""),
+      ESPPRCNgSize      (8 ),
+      ESPPRCMaxRoutes   (10),
+      ESPPRCMaxLabels   (1000000),
+      ESPPRCNumThreads  (1 ),
+      CutCapacity       (1 )
    {}
    ~VRP_Param() {};
 };
@@ -20,6 +20,18 @@
 
 using namespace std;
 
+//===========================================================================//
+/**
+ * Heap order of the node pool of the parallel search: the node with the
+ *   smallest bound on top.
+ */
+struct AlpsDecompNodeWorse {
+   bool operator()(const AlpsTreeNode* a,
+                   const AlpsTreeNode* b) const {
+      return a->getQuality() > b->getQuality();
+   }
+};
+
 //===========================================================================//
 void AlpsDecompModel::setAlpsSettings()
 {
@@ -43,7 +55,8 @@ void AlpsDecompModel::setAlpsSettings()
 AlpsTreeNode* AlpsDecompModel::createRoot()
 {
    //---
-   //--- Create the root node description and set explicit (no diff'ing)
+   //--- Create the root node description. The root bounds are kept here;
+   //---    every node description stores its changes relative to them.
    //---    NOTE: Alps will delete this memory;
    //---
    UtilPrintFuncBegin(&cout, m_classTag,
@@ -54,10 +67,9 @@ AlpsTreeNode* AlpsDecompModel::createRoot()
    const DecompSubModel& modelCore = m_decompAlgo->getModelCore();
    CoinAssert(modelCore.getModel()->getColLB());
    CoinAssert(modelCore.getModel()->getColUB());
-   AlpsDecompNodeDesc* desc
-   = new AlpsDecompNodeDesc(this,
-                            modelCore.getModel()->getColLB(),
-                            modelCore.getModel()->getColUB());
+   m_rootLB = modelCore.getModel()->colLB;
+   m_rootUB = modelCore.getModel()->colUB;
+   AlpsDecompNodeDesc* desc = new AlpsDecompNodeDesc(this);
    assert(desc);
    root->setDesc(desc);
    //root->setExplicit(1);
@@ -70,9 +82,6 @@ AlpsTreeNode* AlpsDecompModel::createRoot()
 bool AlpsDecompModel::fathomAllNodes()
 {
    double relBound    = ALPS_OBJ_MAX;
-   double gapVal      = ALPS_OBJ_MAX;
-   double currAbsGap_ = ALPS_OBJ_MAX;
-   double currRelGap_ = ALPS_OBJ_MAX;
    // Compute gap
    double feasBound = broker_->getIncumbentValue();
    AlpsTreeNode* bestNode  = broker_->getBestNode();
@@ -87,6 +96,22 @@ bool AlpsDecompModel::fathomAllNodes()
       //printf("no bestNode m_bestLB= %12.10f\n", m_bestLB);
    }
 
+   if (isGapClosed(relBound, feasBound)) {
+      m_bestLB = feasBound;
+      return true;
+   } else {
+      return false;
+   }
+}
+
+//===========================================================================//
+bool AlpsDecompModel::isGapClosed(const double relBound,
+                                  const double feasBound) const
+{
+   double gapVal      = ALPS_OBJ_MAX;
+   double currAbsGap_ = ALPS_OBJ_MAX;
+   double currRelGap_ = ALPS_OBJ_MAX;
+
    if (relBound > ALPS_OBJ_MAX_LESS) {
       currAbsGap_ = currRelGap_ = 0.0;
    } else if (feasBound < ALPS_OBJ_MAX_LESS) {
@@ -102,13 +127,92 @@ bool AlpsDecompModel::fathomAllNodes()
    double optimalAbsGap_ = 1.0e-6;
    double optimalRelGap_ = 0.01;//0.01%
    //TODO: cutoffIncrement (currentUB-cutoffIncrement)
-   if ( (currAbsGap_ <= optimalAbsGap_ + ALPS_ZERO) ||
-         (currRelGap_ <= optimalRelGap_ + ALPS_ZERO) ) {
-      m_bestLB = feasBound;
-      return true;
-   } else {
+   return (currAbsGap_ <= optimalAbsGap_ + ALPS_ZERO) ||
+          (currRelGap_ <= optimalRelGap_ + ALPS_ZERO);
+}
+
+//===========================================================================//
+void AlpsDecompModel::addDecompAlgo(DecompAlgo* decompAlgo)
+{
+   if (decompAlgo == NULL)
+      throw UtilException("No DecompAlgo algorithm has been set.",
+                          "addDecompAlgo", "AlpsDecompModel");
+
+   if (m_workers.empty()) {
+      m_workers.push_back(m_decompAlgo);
+   }
+
+   decompAlgo->shareColArchive(m_decompAlgo);
+   decompAlgo->sharePseudoCost(m_decompAlgo);
+   m_workers.push_back(decompAlgo);
+}
+
+//===========================================================================//
+double AlpsDecompModel::getIncumbentValue()
+{
+   if (!m_parSearch) {
+      return getKnowledgeBroker()->getIncumbentValue();
+   }
+
+   double incumbent;
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+   incumbent = m_parIncumbent;
+   return incumbent;
+}
+
+//===========================================================================//
+bool AlpsDecompModel::getBestNodeQuality(double& quality)
+{
+#ifdef _OPENMP
+   if (m_parSearch) {
+#pragma omp critical (AlpsDecompPool)
+      quality = getBestNodeQualityParallel();
+      return quality < ALPS_OBJ_MAX;
+   }
+#endif
+   AlpsTreeNode* bestNode = getKnowledgeBroker()->getBestNode();
+
+   if (!bestNode) {
       return false;
    }
+
+   quality = bestNode->getQuality();
+   return true;
+}
+
+//===========================================================================//
+bool AlpsDecompModel::addSolution(AlpsSolution* sol,
+                                  const double  quality)
+{
+   if (!m_parSearch) {
+      getKnowledgeBroker()->addKnowledge(AlpsKnowledgeTypeSolution,
+                                         sol, quality);
+      return true;
+   }
+
+   bool improved = false;
+#ifdef _OPENMP
+#pragma omp critical (AlpsDecompIncumbent)
+#endif
+   {
+      if (quality < m_parIncumbent) {
+         getKnowledgeBroker()->addKnowledge(AlpsKnowledgeTypeSolution,
+                                            sol, quality);
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+         m_parIncumbent = quality;
+         improved       = true;
+      }
+   }
+
+   if (!improved) {
+      delete sol;
+   }
+
+   return improved;
 }
 
 
@@ -117,7 +221,6 @@ bool AlpsDecompModel::fathomAllNodes()
 //===========================================================================//
 AlpsExitStatus AlpsDecompModel::solve()
 {
-   /** \todo Parallel version. */
 #ifdef UTIL_USE_TIMERS
    globalTimer.reset();
 #endif
@@ -143,6 +246,26 @@ AlpsExitStatus AlpsDecompModel::solve()
    //--- declare an AlpsKnowledgeBroker for serial application
    //---
    AlpsKnowledgeBrokerSerial alpsBroker(0, NULL, *this);
+#ifdef _OPENMP
+
+   //---
+   //--- parallel search: the broker only keeps the solutions
+   //---
+   if (m_workers.size() > 1 && m_param.nodeLimit > 0) {
+      AlpsExitStatus status = solveParallel(alpsBroker, timeLeft);
+
+      if (m_param.msgLevel > 0) {
+         for (size_t w = 0; w < m_workers.size(); w++) {
+            m_workers[w]->getDecompStats().printOverallStats();
+         }
+      }
+
+      UtilPrintFuncEnd(&cout, m_classTag,
+                       "solve()", m_param.msgLevel, 3);
+      return status;
+   }
+
+#endif
    //---
    //--- search for the best solution
    //---
@@ -170,8 +293,309 @@ AlpsExitStatus AlpsDecompModel::solve()
    }
 
    m_alpsStatus = alpsBroker.getSolStatus();
+
+   //---
+   //--- if another racer closed the gap first, the tree was drained
+   //---   without being solved - report the bound we had at that time
+   //---
+   if (m_concurrentStopped) {
+      m_bestLB     = m_concurrentLB;
+      m_alpsStatus = m_bestUB < ALPS_OBJ_MAX_LESS ?
+                     AlpsExitStatusFeasible : AlpsExitStatusUnknown;
+   }
+
    UtilPrintFuncEnd(&cout, m_classTag,
                     "solve()", m_param.msgLevel, 3);
    return alpsBroker.getSolStatus();
 }
 
+
+#ifdef _OPENMP
+//===========================================================================//
+AlpsExitStatus AlpsDecompModel::solveParallel(AlpsKnowledgeBroker& broker,
+                                              const double         timeLimit)
+{
+   const int      nThreads = static_cast<int>(m_workers.size());
+   AlpsTreeNode*  diveNode = NULL;
+   double         bestLB   = ALPS_OBJ_MAX;
+   int            nTasks, i;
+   vector<AlpsTreeNode*>::iterator it;
+   UTIL_MSG(m_param.msgLevel, 1,
+            cout << "Parallel tree search with " << nThreads
+            << " threads" << endl;
+           );
+   m_parSearch         = true;
+   m_parIncumbent      = ALPS_OBJ_MAX;
+   m_parNextIndex      = 1;
+   m_parNodesProcessed = 0;
+   m_parStop           = 0;
+   m_parTimeLimit      = timeLimit;
+   m_parActiveLB.clear();
+   m_parPool.clear();
+   m_parLeft.clear();
+   m_alpsStatus        = AlpsExitStatusUnknown;
+   m_parTimer.start();
+   //---
+   //--- the root is processed by the first thread (the others would
+   //---   have nothing to do), its children start the pool
+   //---
+   AlpsTreeNode* root = createRoot();
+   root->setKnowledgeBroker(&broker);
+   root->setIndex(0);
+   root->setDepth(0);
+   double rootLB = -ALPS_OBJ_MAX;
+   m_parActiveLB.insert(rootLB);
+   nTasks = processNodeParallel(root, rootLB, false, diveNode);
+   //---
+   //--- one task per node put in the pool; a task takes whichever node
+   //---   is best when it starts, so there is always one for it
+   //---
+#pragma omp parallel num_threads(nThreads)
+   {
+#pragma omp single
+      {
+         for (i = 0; i < nTasks; i++) {
+#pragma omp task
+            searchParallel();
+         }
+      }
+   }
+
+   //---
+   //--- the nodes still open bound the optimum
+   //---
+   for (it = m_parPool.begin(); it != m_parPool.end(); ++it) {
+      bestLB = std::min(bestLB, (*it)->getQuality());
+      delete *it;
+   }
+
+   for (it = m_parLeft.begin(); it != m_parLeft.end(); ++it) {
+      bestLB = std::min(bestLB, (*it)->getQuality());
+      delete *it;
+   }
+
+   m_parPool.clear();
+   m_parLeft.clear();
+   m_parSearch      = false;
+   m_bestUB         = m_parIncumbent;
+   m_nodesProcessed = m_parNodesProcessed;
+
+   if (m_alpsStatus == AlpsExitStatusNodeLimit ||
+         m_alpsStatus == AlpsExitStatusTimeLimit) {
+      m_bestLB = std::min(bestLB, m_bestUB);
+   } else if (bestLB >= ALPS_OBJ_MAX_LESS || isGapClosed(bestLB, m_bestUB)) {
+      m_bestLB     = m_bestUB;
+      m_alpsStatus = m_bestUB < ALPS_OBJ_MAX_LESS ?
+                     AlpsExitStatusOptimal : AlpsExitStatusInfeasible;
+   } else {
+      m_bestLB     = bestLB;
+      m_alpsStatus = m_bestUB < ALPS_OBJ_MAX_LESS ?
+                     AlpsExitStatusFeasible : AlpsExitStatusUnknown;
+   }
+
+   UTIL_MSG(m_param.msgLevel, 1,
+            cout << "Parallel tree search: nodes " << m_nodesProcessed
+            << " LB " << UtilDblToStr(m_bestLB)
+            << " UB " << UtilDblToStr(m_bestUB)
+            << " time " << UtilDblToStr(m_parTimer.getRealTime(), 2) << endl;
+           );
+   return static_cast<AlpsExitStatus>(m_alpsStatus);
+}
+
+//===========================================================================//
+void AlpsDecompModel::searchParallel()
+{
+   AlpsTreeNode* node     = NULL;
+   AlpsTreeNode* diveNode = NULL;
+   double        activeLB = ALPS_OBJ_MAX;
+   int           nTasks, i;
+#pragma omp critical (AlpsDecompPool)
+   {
+      if (!m_parPool.empty()) {
+         std::pop_heap(m_parPool.begin(), m_parPool.end(),
+                       AlpsDecompNodeWorse());
+         node = m_parPool.back();
+         m_parPool.pop_back();
+
+         if (m_parStop) {
+            //---
+            //--- stopped by a limit, keep it for the bound
+            //---
+            m_parLeft.push_back(node);
+            node = NULL;
+         } else {
+            activeLB = node->getQuality();
+            m_parActiveLB.insert(activeLB);
+         }
+      }
+   }
+
+   while (node) {
+      nTasks = processNodeParallel(node, activeLB, m_param.nodeDive > 0.0,
+                                   diveNode);
+
+      for (i = 0; i < nTasks; i++) {
+#pragma omp task
+         searchParallel();
+      }
+
+      node = diveNode;
+   }
+}
+
+//===========================================================================//
+int AlpsDecompModel::processNodeParallel(AlpsTreeNode*  node,
+                                         double&        activeLB,
+                                         const bool     allowDive,
+                                         AlpsTreeNode*& diveNode)
+{
+   int       nPushed = 0;
+   bool      isLeft  = false;
+   size_t    k;
+   vector<AlpsTreeNode*> children;
+   vector< CoinTriple<AlpsNodeDesc*, AlpsNodeStatus, double> > descs;
+   diveNode = NULL;
+   node->process(node->getIndex() == 0, false);
+
+   if (node->getStatus() == AlpsNodeStatusPregnant) {
+      descs = node->branch();
+   } else if (node->getStatus() == AlpsNodeStatusEvaluated) {
+      //---
+      //--- no branching candidate, but not fathomed either
+      //---
+      isLeft = true;
+   }
+
+   for (k = 0; k < descs.size(); k++) {
+      AlpsNodeDesc* desc  = descs[k].first;
+      AlpsTreeNode* child = node->createNewTreeNode(desc);
+      child->setKnowledgeBroker(node->getKnowledgeBroker());
+      child->setParentIndex(node->getIndex());
+      child->setDepth(node->getDepth() + 1);
+      child->setQuality(descs[k].third);
+      child->setStatus(descs[k].second);
+      children.push_back(child);
+   }
+
+#pragma omp critical (AlpsDecompPool)
+   {
+      m_parNodesProcessed++;
+      //---
+      //--- the node is done, its children (in the pool or the dive node)
+      //---   bound the tree from here on
+      //---
+      m_parActiveLB.erase(m_parActiveLB.find(activeLB));
+
+      for (k = 0; k < children.size(); k++) {
+         children[k]->setIndex(m_parNextIndex++);
+      }
+
+      //---
+      //--- dive into the last child (up branch) if it is close enough
+      //---   to the best bound in the tree
+      //---
+      if (allowDive && !children.empty() && !m_parStop) {
+         const double quality   = children.back()->getQuality();
+         const double incumbent = getIncumbentValue();
+         const double best      = std::min(getBestNodeQualityParallel(),
+                                           quality);
+
+         if (m_param.nodeDive >= 1.0                ||
+               incumbent >= ALPS_OBJ_MAX_LESS         ||
+               quality <= best + m_param.nodeDive * (incumbent - best)) {
+            diveNode = children.back();
+            children.pop_back();
+         }
+      }
+
+      for (k = 0; k < children.size(); k++) {
+         m_parPool.push_back(children[k]);
+         std::push_heap(m_parPool.begin(), m_parPool.end(),
+                        AlpsDecompNodeWorse());
+         nPushed++;
+      }
+
+      if (isLeft) {
+         m_parLeft.push_back(node);
+      }
+
+      if (diveNode) {
+         activeLB = diveNode->getQuality();
+         m_parActiveLB.insert(activeLB);
+      }
+
+      checkStopParallel();
+
+      //---
+      //--- once stopped, the child is left open as well
+      //---
+      if (m_parStop && diveNode) {
+         m_parActiveLB.erase(m_parActiveLB.find(activeLB));
+         m_parLeft.push_back(diveNode);
+         diveNode = NULL;
+      }
+
+      if (m_param.nodeLogInterval > 0 &&
+            m_parNodesProcessed % m_param.nodeLogInterval == 0) {
+         UTIL_MSG(m_param.msgLevel, 1,
+                  const double lb = getBestNodeQualityParallel();
+                  const double ub = getIncumbentValue();
+                  cout << "Node " << std::setw(8) << m_parNodesProcessed
+                  << " open " << std::setw(8) << m_parPool.size()
+                  << " LB " << std::setw(12)
+                  << UtilDblToStr(lb < ALPS_OBJ_MAX ? lb : ub)
+                  << " UB " << std::setw(12) << UtilDblToStr(ub)
+                  << " time " << UtilDblToStr(m_parTimer.getRealTime(), 2)
+                  << endl;
+                 );
+      }
+   }
+
+   if (!isLeft) {
+      delete node;
+   }
+
+   return nPushed;
+}
+
+//===========================================================================//
+double AlpsDecompModel::getBestNodeQualityParallel() const
+{
+   double best = m_parPool.empty() ?
+                 ALPS_OBJ_MAX : m_parPool.front()->getQuality();
+   if (!m_parActiveLB.empty()) {
+      best = std::min(best, *m_parActiveLB.begin());
+   }
+
+   return best;
+}
+
+//===========================================================================//
+void AlpsDecompModel::checkStopParallel()
+{
+   if (m_parStop) {
+      return;
+   }
+
+   if (m_parNodesProcessed >= m_param.nodeLimit) {
+      m_alpsStatus = AlpsExitStatusNodeLimit;
+      m_parStop    = 1;
+   } else if (m_parTimer.getRealTime() >= m_parTimeLimit) {
+      m_alpsStatus = AlpsExitStatusTimeLimit;
+      m_parStop    = 1;
+   } else {
+      //---
+      //--- once the gap is closed, the open nodes can all be fathomed
+      //---   (the incumbent is written under another critical section,
+      //---   so it is read atomically)
+      //---
+      const double best      = getBestNodeQualityParallel();
+      const double incumbent = getIncumbentValue();
+
+      if (best < ALPS_OBJ_MAX && incumbent < ALPS_OBJ_MAX_LESS &&
+            isGapClosed(best, incumbent)) {
+         m_parStop = 1;
+      }
+   }
+}
+#endif
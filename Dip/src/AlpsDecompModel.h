@@ -27,10 +27,16 @@
 #include "DecompConstraintSet.h"
 
 //===========================================================================//
+#include <set>
 #include <string>
+#ifdef _OPENMP
+#include "omp.h"
+#endif
 
 //===========================================================================//
 class AlpsTreeNode;
+class AlpsSolution;
+class AlpsKnowledgeBroker;
 
 //===========================================================================//
 /**
@@ -56,7 +62,15 @@ class AlpsTreeNode;
  * \todo Allow use of Alps writeParameters.
  * \todo Use message handler.
  * \todo Use differencing scheme.
- * \todo Setup for parallel.
+ * \todo Setup for distributed memory parallel.
+ *
+ * Shared memory parallel search (nodeThreads > 1): every thread works
+ * with its own DecompAlgo (its own copy of the application, master and
+ * subproblem solvers), see addDecompAlgo. The threads share the pool of
+ * open nodes, the incumbent, the column archive and the pseudo-costs
+ * of the first DecompAlgo. Nodes are handed out best-first; after
+ * branching, a thread may dive into one of the children (see
+ * AlpsDecompParam::nodeDive).
  */
 //===========================================================================//
 
@@ -95,6 +109,58 @@ private:
    int    m_nodesProcessed;
    int    m_alpsStatus;
 
+   /**
+    * Concurrent mode: set when another racer closed the gap first;
+    *   the tree is then drained and the bound is the one held when
+    *   the stop was first noticed.
+    */
+   bool   m_concurrentStopped;
+   double m_concurrentLB;
+
+   /**
+    * Column bounds (original space) at the root. Node descriptions
+    *   only store their bound changes relative to these.
+    */
+   std::vector<double> m_rootLB;
+   std::vector<double> m_rootUB;
+
+   /**
+    * Parallel search: the DecompAlgo of each thread (m_workers[0] is
+    *   m_decompAlgo). Empty for the serial search.
+    */
+   std::vector<DecompAlgo*> m_workers;
+
+   /**
+    * Parallel search: true while it runs (the incumbent and the node
+    *   pool are then the ones below, not the broker's).
+    */
+   bool   m_parSearch;
+
+   /** Parallel search: the incumbent value. */
+   double m_parIncumbent;
+
+   /** Parallel search: the open nodes, a heap on quality (best first). */
+   std::vector<AlpsTreeNode*> m_parPool;
+
+   /**
+    * Parallel search: nodes which are left open but will not be
+    *   processed (stopped by a limit, or no branching candidate).
+    */
+   std::vector<AlpsTreeNode*> m_parLeft;
+
+   /**
+    * Parallel search: qualities of the nodes being processed, one entry
+    *   per node (a thread can start another task at a task scheduling
+    *   point while its dive node is still pending).
+    */
+   std::multiset<double> m_parActiveLB;
+
+   int    m_parNextIndex;
+   int    m_parNodesProcessed;
+   int    m_parStop;
+   double m_parTimeLimit;
+   UtilTimer m_parTimer;
+
    /**
     * @}
     */
@@ -113,7 +179,15 @@ public:
       AlpsModel    (),
       m_classTag   ("ALPSM"),
       m_param      (),
-      m_decompAlgo (NULL) {
+      m_decompAlgo (NULL),
+      m_concurrentStopped(false),
+      m_concurrentLB     (-ALPS_OBJ_MAX),
+      m_parSearch        (false),
+      m_parIncumbent     (ALPS_OBJ_MAX),
+      m_parNextIndex     (0),
+      m_parNodesProcessed(0),
+      m_parStop          (0),
+      m_parTimeLimit     (0.0) {
    }
 
    AlpsDecompModel(UtilParameters& utilParam,
@@ -121,7 +195,15 @@ public:
       AlpsModel   (),
       m_classTag  ("ALPSM"),
       m_param     (utilParam),
-      m_decompAlgo(decompAlgo) {
+      m_decompAlgo(decompAlgo),
+      m_concurrentStopped(false),
+      m_concurrentLB     (-ALPS_OBJ_MAX),
+      m_parSearch        (false),
+      m_parIncumbent     (ALPS_OBJ_MAX),
+      m_parNextIndex     (0),
+      m_parNodesProcessed(0),
+      m_parStop          (0),
+      m_parTimeLimit     (0.0) {
       if (decompAlgo == NULL)
          throw UtilException("No DecompAlgo algorithm has been set.",
                              "AlpsDecompModel", "AlpsDecompModel");
@@ -171,6 +253,80 @@ public:
     */
    void setAlpsSettings();
 
+   /**
+    * Parallel search: add the DecompAlgo of one more thread. It must be
+    *   built on its own copy of the application (copied before
+    *   initializeApp, as in Concurrent mode). It shares the column
+    *   archive and the pseudo-costs of the first DecompAlgo. The caller
+    *   owns it.
+    */
+   void addDecompAlgo(DecompAlgo* decompAlgo);
+
+   /**
+    * Value of the incumbent (the broker's, or the one shared by the
+    *   threads of the parallel search).
+    */
+   double getIncumbentValue();
+
+   /**
+    * Bound of the best open node (in the parallel search, also over
+    *   the nodes being processed). Returns false if there is none.
+    */
+   bool getBestNodeQuality(double& quality);
+
+   /**
+    * Offer a new solution (takes ownership). Returns true if it
+    *   improved the incumbent.
+    */
+   bool addSolution(AlpsSolution* sol,
+                    const double  quality);
+
+   /**
+    * True if the gap between relBound and feasBound is closed.
+    */
+   bool isGapClosed(const double relBound,
+                    const double feasBound) const;
+
+private:
+#ifdef _OPENMP
+   /**
+    * Parallel search (see nodeThreads).
+    */
+   AlpsExitStatus solveParallel(AlpsKnowledgeBroker& broker,
+                                const double         timeLimit);
+
+   /**
+    * Parallel search, one task: take the best open node and process it,
+    *   and its children as long as the thread dives.
+    */
+   void searchParallel();
+
+   /**
+    * Parallel search: process node, put its children in the pool but the
+    *   one to dive into (diveNode, if allowDive). activeLB is the entry of
+    *   node in m_parActiveLB, it is replaced by the one of diveNode.
+    *   Returns the number of nodes put in the pool.
+    */
+   int processNodeParallel(AlpsTreeNode*  node,
+                           double&        activeLB,
+                           const bool     allowDive,
+                           AlpsTreeNode*& diveNode);
+
+   /**
+    * Parallel search: bound of the best open node, including the nodes
+    *   being processed (call in critical section AlpsDecompPool).
+    */
+   double getBestNodeQualityParallel() const;
+
+   /**
+    * Parallel search: raise m_parStop on a limit or a closed gap (call
+    *   in critical section AlpsDecompPool).
+    */
+   void checkStopParallel();
+#endif
+
+public:
+
    /**
     * Solve with ALPS and DECOMP.
     */
@@ -192,6 +348,14 @@ public:
     */
    //THINK: return ref?
    inline DecompAlgo* getDecompAlgo() {
+#ifdef _OPENMP
+      //---
+      //--- in the parallel search, the DecompAlgo of this thread
+      //---
+      if (m_parSearch) {
+         return m_workers[omp_get_thread_num()];
+      }
+#endif
       return m_decompAlgo;
    }
 
@@ -199,6 +363,30 @@ public:
       return m_param;
    }
 
+   /**
+    * Concurrent mode: record that the search was stopped by another
+    *   racer (only the first call records the bound).
+    */
+   inline void setConcurrentStopped(const double thisLB) {
+      if (!m_concurrentStopped) {
+         m_concurrentStopped = true;
+         m_concurrentLB      = thisLB;
+      }
+   }
+   inline bool isConcurrentStopped() const {
+      return m_concurrentStopped;
+   }
+
+   /**
+    * Column bounds at the root (set by createRoot).
+    */
+   inline const std::vector<double>& getRootLB() const {
+      return m_rootLB;
+   }
+   inline const std::vector<double>& getRootUB() const {
+      return m_rootUB;
+   }
+
 
    /**
     * Get number of rows in core decomp model.
@@ -229,10 +417,21 @@ public:
    }
 
    /**
-    * Get the best solution found.
+    * Get the best solution found (by any thread).
     */
    inline const DecompSolution* getBestSolution() const {
-      return m_decompAlgo->getXhatIPBest();
+      const DecompSolution* best = m_decompAlgo->getXhatIPBest();
+      std::vector<DecompAlgo*>::const_iterator it;
+
+      for (it = m_workers.begin(); it != m_workers.end(); ++it) {
+         const DecompSolution* sol = (*it)->getXhatIPBest();
+
+         if (sol && (!best || sol->getQuality() < best->getQuality())) {
+            best = sol;
+         }
+      }
+
+      return best;
    }
 
    const double getGlobalLB() const {
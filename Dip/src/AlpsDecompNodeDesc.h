@@ -20,11 +20,10 @@
 #include "AlpsEncoded.h"
 #include "AlpsNodeDesc.h"
 #include "AlpsDecompModel.h"
+#include "DecompMasterWarmStart.h"
+#include "DecompBranchRow.h"
 #include "UtilMacrosAlps.h"
 
-//===========================================================================//
-class CoinWarmStartBasis;
-
 //===========================================================================//
 /**
  * \class AlpsDecompNodeDesc
@@ -32,8 +31,21 @@ class CoinWarmStartBasis;
  * Derivation of AlpsNodeDesc for DECOMP.
  *
  * An object derived from AlpsNodeDesc. This stores the description
- * of a search tree node. For DECOMP, we are not using differencing,
- * so, we only need to store the bounds set during branching.
+ * of a search tree node. For DECOMP, the description is the set of
+ * column bounds in original space. Only the bounds that differ from the
+ * root (AlpsDecompModel::getRootLB/UB) are stored: a child merges its
+ * parent's changes with the branching bounds, so a node costs
+ * O(depth * branch size) memory instead of two dense arrays, and the
+ * dense bounds are rebuilt (getBounds) only when the node is processed.
+ *
+ * A node branched on rows of x (DecompBranchRow, e.g., Ryan-Foster) also
+ * stores the branching rows of all its ancestors: a child copies its
+ * parent's rows and adds the new ones.
+ *
+ * A child also carries its parent's master basis and basic columns
+ * (DecompMasterWarmStart), so that its first master solve starts from
+ * where the parent stopped instead of from whatever node was processed
+ * last.
  *
  * AlpsDecompNodeDesc is derived from AlpsNodeDesc
  *    AlpsModel has no pure virtual functions
@@ -47,7 +59,6 @@ class CoinWarmStartBasis;
  *
  * \todo
  * Invent a way to lose weight on a donut diet.
- * Use differencing scheme.
  */
 //===========================================================================//
 
@@ -69,10 +80,10 @@ private:
    std::string m_classTag;
 
 public:
-   /** lower bounds in original space */
-   double* lowerBounds_;
-   /** upper bounds in original space */
-   double* upperBounds_;
+   /** lower bounds changed w.r.t. the root, (index, value) sorted by index */
+   std::vector< std::pair<int, double> > lbChanges_;
+   /** upper bounds changed w.r.t. the root, (index, value) sorted by index */
+   std::vector< std::pair<int, double> > ubChanges_;
    /** number of columns in original space */
    int numberCols_;
    /** Branched direction to create it. */
@@ -80,70 +91,154 @@ public:
    /** Branched set of indices/values to create it. */
    std::vector< std::pair<int, double> > branched_;
 
-   //THINK: different derivations for different algos? need?
-   /** Warm start. */
-   CoinWarmStartBasis* basis_;
+   /** Bound of the parent when it branched to create it. */
+   double branchedQuality_;
+
+   /** Branching rows of this node and its ancestors (original space). */
+   std::vector<DecompBranchRow> branchRows_;
+
+   /** Master warm start from the parent (owned, NULL if none). */
+   DecompMasterWarmStart* masterWarmStart_;
 
 public:
 
    /** Default constructor. */
    AlpsDecompNodeDesc() :
       AlpsNodeDesc(),
+      numberCols_(0),
       branchedDir_(0),
-      basis_(NULL) {
+      branchedQuality_(-ALPS_OBJ_MAX),
+      masterWarmStart_(NULL) {
    }
 
    /** Useful constructor. */
    AlpsDecompNodeDesc(AlpsModel* m)
       :
       AlpsNodeDesc(m),
+      numberCols_(0),
       branchedDir_(0),
-      basis_(NULL) {
+      branchedQuality_(-ALPS_OBJ_MAX),
+      masterWarmStart_(NULL) {
    }
 
-   AlpsDecompNodeDesc(AlpsDecompModel* m,
-                      const double*     lb,
-                      const double*     ub)
+   /** Root node: no bound changes. */
+   AlpsDecompNodeDesc(AlpsDecompModel* m)
       :
       AlpsNodeDesc(m),
       branchedDir_(0),
-      basis_(NULL) {
+      branchedQuality_(-ALPS_OBJ_MAX),
+      masterWarmStart_(NULL) {
       numberCols_ = m->getNumCoreCols();
       assert(numberCols_);
-      lowerBounds_ = new double [numberCols_];
-      upperBounds_ = new double [numberCols_];
-      memcpy(lowerBounds_, lb, sizeof(double)*numberCols_);
-      memcpy(upperBounds_, ub, sizeof(double)*numberCols_);
+   }
+
+   /**
+    * Child node: the parent's bound changes, overridden by the
+    *   branching bounds branchLB/branchUB (original space), the
+    *   parent's branching rows and branchRows, and a copy of the
+    *   parent's master warm start.
+    */
+   AlpsDecompNodeDesc(AlpsDecompModel*                             m,
+                      const AlpsDecompNodeDesc*                    parent,
+                      const std::vector< std::pair<int, double> >& branchLB,
+                      const std::vector< std::pair<int, double> >& branchUB,
+                      const std::vector<DecompBranchRow>&          branchRows
+                      = std::vector<DecompBranchRow>())
+      :
+      AlpsNodeDesc(m),
+      numberCols_(parent->numberCols_),
+      branchedDir_(0),
+      branchedQuality_(-ALPS_OBJ_MAX),
+      branchRows_(parent->branchRows_),
+      masterWarmStart_(NULL) {
+      mergeChanges(parent->lbChanges_, branchLB, lbChanges_);
+      mergeChanges(parent->ubChanges_, branchUB, ubChanges_);
+      branchRows_.insert(branchRows_.end(),
+                         branchRows.begin(), branchRows.end());
+
+      if (parent->masterWarmStart_) {
+         masterWarmStart_ = parent->masterWarmStart_->clone();
+      }
    }
 
    /** Destructor. */
    virtual ~AlpsDecompNodeDesc() {
-      if (lowerBounds_ != 0) {
-         delete [] lowerBounds_;
-         lowerBounds_ = 0;
+      delete masterWarmStart_;
+   }
+
+   /**
+    * Rebuild the dense column bounds of this node (original space):
+    *   the root bounds with this node's changes applied.
+    */
+   void getBounds(double* lbs,
+                  double* ubs) const {
+      const AlpsDecompModel* m = dynamic_cast<const AlpsDecompModel*>(model_);
+      const std::vector<double>& rootLB = m->getRootLB();
+      const std::vector<double>& rootUB = m->getRootUB();
+      assert(static_cast<int>(rootLB.size()) == numberCols_);
+      std::copy(rootLB.begin(), rootLB.end(), lbs);
+      std::copy(rootUB.begin(), rootUB.end(), ubs);
+      std::vector< std::pair<int, double> >::const_iterator it;
+
+      for (it = lbChanges_.begin(); it != lbChanges_.end(); ++it) {
+         lbs[it->first] = it->second;
+      }
+
+      for (it = ubChanges_.begin(); it != ubChanges_.end(); ++it) {
+         ubs[it->first] = it->second;
       }
+   }
 
-      if (upperBounds_ != 0) {
-         delete [] upperBounds_;
-         upperBounds_ = 0;
+   /**
+    * Tighten this node's bounds (original space) with lbFix/ubFix, e.g.,
+    *   from reduced cost fixing. Entries which are not tighter than the
+    *   current bounds are ignored. The children built afterwards
+    *   inherit the new bounds.
+    */
+   void tightenBounds(const std::vector< std::pair<int, double> >& lbFix,
+                      const std::vector< std::pair<int, double> >& ubFix) {
+      std::vector<double> lbs(numberCols_);
+      std::vector<double> ubs(numberCols_);
+      std::vector< std::pair<int, double> > lbNew, ubNew, merged;
+      std::vector< std::pair<int, double> >::const_iterator it;
+      getBounds(&lbs[0], &ubs[0]);
+
+      for (it = lbFix.begin(); it != lbFix.end(); ++it) {
+         if (it->second > lbs[it->first] && it->second <= ubs[it->first]) {
+            lbNew.push_back(*it);
+         }
       }
 
-      delete basis_;
+      for (it = ubFix.begin(); it != ubFix.end(); ++it) {
+         if (it->second < ubs[it->first] && it->second >= lbs[it->first]) {
+            ubNew.push_back(*it);
+         }
+      }
+
+      if (!lbNew.empty()) {
+         mergeChanges(lbChanges_, lbNew, merged);
+         lbChanges_.swap(merged);
+      }
+
+      if (!ubNew.empty()) {
+         mergeChanges(ubChanges_, ubNew, merged);
+         ubChanges_.swap(merged);
+      }
    }
 
-   /** Set basis. */
-   void setBasis(CoinWarmStartBasis*& ws) {
-      if (basis_) {
-         delete basis_;
+   /** Set master warm start (takes ownership, NULL frees it). */
+   void setMasterWarmStart(DecompMasterWarmStart*& ws) {
+      if (masterWarmStart_) {
+         delete masterWarmStart_;
       }
 
-      basis_ = ws;
+      masterWarmStart_ = ws;
       ws = NULL;
    }
 
-   /** Get warm start basis. */
-   CoinWarmStartBasis* getBasis() const {
-      return basis_;
+   /** Get master warm start. */
+   const DecompMasterWarmStart* getMasterWarmStart() const {
+      return masterWarmStart_;
    }
 
    /** Set branching direction. */
@@ -166,8 +261,161 @@ public:
       return branched_;
    }
 
+   /** Set the bound of the parent when it branched. */
+   void setBranchedQuality(double q) {
+      branchedQuality_ = q;
+   }
+
+   /** Get the bound of the parent when it branched. */
+   double getBranchedQuality() const {
+      return branchedQuality_;
+   }
+
+   /** Get the branching rows of this node and its ancestors. */
+   const std::vector<DecompBranchRow>& getBranchRows() const {
+      return branchRows_;
+   }
+
 protected:
 
+   /**
+    * out = base (sorted by index) with the entries of changes applied
+    *   on top; if changes repeats an index, the last entry wins.
+    */
+   static void mergeChanges(const std::vector< std::pair<int, double> >& base,
+                            const std::vector< std::pair<int, double> >& changes,
+                            std::vector< std::pair<int, double> >& out) {
+      std::vector< std::pair<int, double> > sorted;
+      std::vector< std::pair<int, double> >::const_iterator bit, cit;
+      sorted.reserve(changes.size());
+
+      for (cit = changes.begin(); cit != changes.end(); ++cit) {
+         std::vector< std::pair<int, double> >::iterator sit = sorted.begin();
+
+         while (sit != sorted.end() && sit->first < cit->first) {
+            ++sit;
+         }
+
+         if (sit != sorted.end() && sit->first == cit->first) {
+            sit->second = cit->second;
+         } else {
+            sorted.insert(sit, *cit);
+         }
+      }
+
+      out.clear();
+      out.reserve(base.size() + sorted.size());
+      bit = base.begin();
+      cit = sorted.begin();
+
+      while (bit != base.end() || cit != sorted.end()) {
+         if (cit == sorted.end() ||
+               (bit != base.end() && bit->first < cit->first)) {
+            out.push_back(*bit++);
+         } else {
+            if (bit != base.end() && bit->first == cit->first) {
+               ++bit;
+            }
+
+            out.push_back(*cit++);
+         }
+      }
+   }
+
+   /** Pack a list of bound changes into an encoded. */
+   static void encodeChanges(AlpsEncoded*                                 encoded,
+                             const std::vector< std::pair<int, double> >& changes) {
+      int                 size = static_cast<int>(changes.size());
+      std::vector<int>    ind(size);
+      std::vector<double> val(size);
+
+      for (int i = 0; i < size; i++) {
+         ind[i] = changes[i].first;
+         val[i] = changes[i].second;
+      }
+
+      encoded->writeRep(size);
+
+      if (size > 0) {
+         encoded->writeRep(&ind[0], size);
+         encoded->writeRep(&val[0], size);
+      }
+   }
+
+   /** Unpack a list of bound changes from an encoded. */
+   static void decodeChanges(AlpsEncoded&                           encoded,
+                             std::vector< std::pair<int, double> >& changes) {
+      int size = 0;
+      encoded.readRep(size);
+      changes.clear();
+
+      if (size > 0) {
+         int*    ind = NULL;
+         double* val = NULL;
+         int     len = 0;
+         encoded.readRep(ind, len);
+         encoded.readRep(val, len);
+         changes.reserve(size);
+
+         for (int i = 0; i < size; i++) {
+            changes.push_back(std::make_pair(ind[i], val[i]));
+         }
+
+         UTIL_DELARR(ind);
+         UTIL_DELARR(val);
+      }
+   }
+
+   /** Pack a list of branching rows into an encoded. */
+   static void encodeRows(AlpsEncoded*                        encoded,
+                          const std::vector<DecompBranchRow>& rows) {
+      int size = static_cast<int>(rows.size());
+      encoded->writeRep(size);
+
+      for (int i = 0; i < size; i++) {
+         const DecompBranchRow& row = rows[i];
+         encoded->writeRep(row.m_blockId);
+         encoded->writeRep(row.m_lb);
+         encoded->writeRep(row.m_ub);
+         encoded->writeRep(row.getNumElements());
+
+         if (row.getNumElements() > 0) {
+            encoded->writeRep(&row.m_ind[0], row.getNumElements());
+            encoded->writeRep(&row.m_els[0], row.getNumElements());
+         }
+      }
+   }
+
+   /** Unpack a list of branching rows from an encoded. */
+   static void decodeRows(AlpsEncoded&                  encoded,
+                          std::vector<DecompBranchRow>& rows) {
+      int size = 0;
+      encoded.readRep(size);
+      rows.clear();
+      rows.resize(size);
+
+      for (int i = 0; i < size; i++) {
+         DecompBranchRow& row = rows[i];
+         int nEls = 0;
+         encoded.readRep(row.m_blockId);
+         encoded.readRep(row.m_lb);
+         encoded.readRep(row.m_ub);
+         encoded.readRep(nEls);
+
+         if (nEls > 0) {
+            int*    ind = NULL;
+            double* els = NULL;
+            int     len = 0;
+            encoded.readRep(ind, len);
+            encoded.readRep(els, len);
+            row.m_ind.assign(ind, ind + nEls);
+            row.m_els.assign(els, els + nEls);
+            UTIL_DELARR(ind);
+            UTIL_DELARR(els);
+         }
+      }
+   }
+
    //---
    //--- helper functions for encode/decode
    //---
@@ -176,19 +424,14 @@ protected:
    AlpsReturnStatus encodeAlpsDecomp(AlpsEncoded* encoded) const {
       AlpsReturnStatus status = AlpsReturnStatusOk;
       encoded->writeRep(branchedDir_);
-      // Basis
-      int ava = 0;
-
-      if (basis_) {
-         ava = 1;
-         encoded->writeRep(ava);
-         //should this be a util func or blis func?
-         //seems pretty standard, alps/coin util type stuff
-         UtilAlpsEncodeWarmStart(encoded, basis_);
-      } else {
-         encoded->writeRep(ava);
-      }
-
+      encoded->writeRep(numberCols_);
+      encodeChanges(encoded, lbChanges_);
+      encodeChanges(encoded, ubChanges_);
+      encodeRows(encoded, branchRows_);
+      //---
+      //--- the master warm start is not encoded, it only has meaning
+      //---   for the DecompAlgo which recorded it
+      //---
       return status;
    }
 
@@ -196,16 +439,10 @@ protected:
    AlpsReturnStatus decodeAlpsDecomp(AlpsEncoded& encoded) {
       AlpsReturnStatus status = AlpsReturnStatusOk;
       encoded.readRep(branchedDir_);
-      // Basis
-      int ava;
-      encoded.readRep(ava);
-
-      if (ava == 1) {
-         basis_ = UtilAlpsDecodeWarmStart(encoded, &status);
-      } else {
-         basis_ = NULL;
-      }
-
+      encoded.readRep(numberCols_);
+      decodeChanges(encoded, lbChanges_);
+      decodeChanges(encoded, ubChanges_);
+      decodeRows(encoded, branchRows_);
       return status;
    }
 
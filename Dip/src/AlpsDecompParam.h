@@ -77,6 +77,23 @@ public:
     */
    int nodeLogInterval;
 
+   /**
+    * Number of threads for the tree search. Each thread processes nodes
+    * with its own DecompAlgo (see AlpsDecompModel::addDecompAlgo).
+    * Default: 1 (serial search).
+    */
+   int nodeThreads;
+
+   /**
+    * Parallel tree search: after branching, a thread keeps one child
+    * (depth-first) if its bound is within nodeDive * (UB - LB) of the
+    * best bound in the tree. Otherwise it takes the best node from the
+    * shared pool (best-first).
+    *  - 0: best-first
+    *  - 1: depth-first (Default: 0.5)
+    */
+   double nodeDive;
+
 
    //-----------------------------------------------------------------------//
    /**
@@ -93,6 +110,8 @@ public:
       msgLevel        = param.GetSetting("msgLevel",        2,            sec);
       nodeLimit       = param.GetSetting("nodeLimit",       ALPS_INT_MAX, sec);
       nodeLogInterval = param.GetSetting("nodeLogInterval", 10,           sec);
+      nodeThreads     = param.GetSetting("nodeThreads",     1,            sec);
+      nodeDive        = param.GetSetting("nodeDive",        0.5,          sec);
 
       if (msgLevel > 2) {
          dumpSettings();
@@ -109,6 +128,8 @@ public:
       (*os) << sec << ": msgLevel        = " << msgLevel        << std::endl;
       (*os) << sec << ": nodeLimit       = " << nodeLimit       << std::endl;
       (*os) << sec << ": nodeLogInterval = " << nodeLogInterval << std::endl;
+      (*os) << sec << ": nodeThreads     = " << nodeThreads     << std::endl;
+      (*os) << sec << ": nodeDive        = " << nodeDive        << std::endl;
    }
    /**
     * @}
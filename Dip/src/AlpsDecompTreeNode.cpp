@@ -38,7 +38,7 @@ AlpsDecompTreeNode::createNewTreeNode(AlpsNodeDesc*& desc) const
 {
    //---
    //--- Create a new tree node, set node description.
-   //---    NOTE: we are not using differencing, constructs node from scratch
+   //---    NOTE: the description holds bound changes w.r.t. the root
    //---
    AlpsDecompModel*     model
    = dynamic_cast<AlpsDecompModel*>(desc->getModel());
@@ -60,7 +60,7 @@ bool AlpsDecompTreeNode::checkIncumbent(AlpsDecompModel*       model,
    //---
    //--- decompAlgo found an IP (and user) feasible point
    //---
-   double currentUB   = getKnowledgeBroker()->getIncumbentValue();
+   double currentUB   = model->getIncumbentValue();
    double candidateUB = decompSol->getQuality();
    UTIL_DEBUG(model->getParam().msgLevel, 3,
               cout
@@ -71,7 +71,8 @@ bool AlpsDecompTreeNode::checkIncumbent(AlpsDecompModel*       model,
 
    if (candidateUB < currentUB) {
       //---
-      //--- create a new solution and add to alps knowledge
+      //--- create a new solution and add to alps knowledge (a parallel
+      //---   search may have found a better one in the meantime)
       //---
       AlpsDecompSolution* alpsDecompSol =
          new AlpsDecompSolution(decompSol->getSize(),
@@ -80,9 +81,10 @@ bool AlpsDecompTreeNode::checkIncumbent(AlpsDecompModel*       model,
                                 decompAlgo->getDecompApp(),
                                 getIndex(),
                                 getDepth());
-      getKnowledgeBroker()->addKnowledge(AlpsKnowledgeTypeSolution,
-                                         alpsDecompSol,
-                                         candidateUB);
+      if (!model->addSolution(alpsDecompSol, candidateUB)) {
+         return false;
+      }
+
       //---
       //--- print the new solution (if debugging)
       //---
@@ -100,6 +102,82 @@ bool AlpsDecompTreeNode::checkIncumbent(AlpsDecompModel*       model,
    return false;
 }
 
+//===========================================================================//
+bool AlpsDecompTreeNode::checkConcurrentStop(AlpsDecompModel* model)
+{
+   const DecompApp* app = model->getDecompAlgo()->getDecompApp();
+
+   if (!app->m_concurrent || !app->m_concurrent->isStopped()) {
+      return false;
+   }
+
+   //---
+   //--- the bound at the time of the stop is the smallest over this
+   //---   node and the nodes still waiting in the tree
+   //---
+   double thisLB = quality_;
+   double bestLB;
+
+   if (model->getBestNodeQuality(bestLB) && bestLB < thisLB) {
+      thisLB = bestLB;
+   }
+
+   model->setConcurrentStopped(thisLB);
+   UTIL_MSG(model->getParam().msgLevel, 3,
+            cout << "Fathom Node " << getIndex()
+            << " since another racer closed the gap" << endl;
+           );
+   return true;
+}
+
+//===========================================================================//
+bool AlpsDecompTreeNode::strongBranchChild(AlpsDecompModel*    model,
+                                           AlpsDecompNodeDesc* child,
+                                           double&             quality)
+{
+   AlpsDecompNodeDesc* desc       = dynamic_cast<AlpsDecompNodeDesc*>(desc_);
+   DecompAlgo*          decompAlgo = model->getDecompAlgo();
+   const int            maxIters   = decompAlgo->getParam().BranchStrongIter;
+   const int            numCols    = desc->numberCols_;
+   const double         parentLB   = quality;
+   vector<double>       lbs(numCols);
+   vector<double>       ubs(numCols);
+   double               childLB;
+   //---
+   //--- evaluate the child from this node's master basis, the columns
+   //---   generated stay in the master for when the child is processed
+   //---
+   child->getBounds(&lbs[0], &ubs[0]);
+   childLB = decompAlgo->evalStrongBranch(this, &lbs[0], &ubs[0],
+                                          desc->getMasterWarmStart(),
+                                          parentLB,
+                                          model->getIncumbentValue(),
+                                          maxIters);
+
+   if (decompAlgo->getXhatIPBest()) {
+      checkIncumbent(model, decompAlgo->getXhatIPBest());
+   }
+
+   if (branchedOn_.size() == 1) {
+      decompAlgo->updatePseudoCost(branchedOn_[0].first,
+                                   child->getBranchedDir(),
+                                   branchedOn_[0].second, parentLB, childLB);
+   }
+
+   if (childLB >= decompAlgo->getInfinity() ||
+         childLB >= model->getIncumbentValue()) {
+      UTIL_MSG(model->getParam().msgLevel, 3,
+               cout << "Node " << getIndex() << " drop child (dir = "
+               << child->getBranchedDir() << ") with bound "
+               << UtilDblToStr(childLB) << endl;
+              );
+      return false;
+   }
+
+   quality = std::max(parentLB, childLB);
+   return true;
+}
+
 //===========================================================================//
 int AlpsDecompTreeNode::process(bool isRoot,
                                 bool rampUp)
@@ -129,20 +207,28 @@ int AlpsDecompTreeNode::process(bool isRoot,
    //---
    //--- check if this can be fathomed based on parent by objective cutoff
    //---
-   double currentUB       = getKnowledgeBroker()->getIncumbentValue();
+   double currentUB       = model->getIncumbentValue();
    double parentObjValue  = getQuality();
    double primalTolerance = 1.0e-6;
    double globalLB        = -decompAlgo->getInfinity();
    double globalUB        =  decompAlgo->getInfinity();
    double thisQuality;
-   AlpsTreeNode*         bestNode  = NULL;
-   const double*         lbs       = desc->lowerBounds_;
-   const double*         ubs       = desc->upperBounds_;
+   const double*         lbs       = NULL;
+   const double*         ubs       = NULL;
+   vector<double>        nodeLB;
+   vector<double>        nodeUB;
    const DecompApp*      app       = decompAlgo->getDecompApp();
    DecompConstraintSet* modelCore = decompAlgo->getModelCore().getModel();
    const int             n_cols    = modelCore->getNumCols();
    //TODO: cutoffIncrement (currentUB-cutoffIncrement)
 
+   //---
+   //--- in Concurrent mode, another racer may hold a better incumbent
+   //---
+   if (app->m_concurrent) {
+      currentUB = std::min(currentUB, app->m_concurrent->getBestUB());
+   }
+
    /** \todo get primalTolerance from parameter */
    if ((parentObjValue - primalTolerance) > currentUB) {
       doFathom = true;
@@ -162,10 +248,27 @@ int AlpsDecompTreeNode::process(bool isRoot,
       quality_ = -ALPS_OBJ_MAX;
    }
 
+   //---
+   //--- in Concurrent mode, once another racer has closed the gap
+   //---   there is nothing left to do here
+   //---
+   if (checkConcurrentStop(model)) {
+      doFathom = true;
+      goto TERM_PROCESS;
+   }
+
    //---
    //--- reset user-currentUB (if none given, this will have no effect)
    //---
    decompAlgo->setObjBoundIP(decompAlgo->getCutoffUB());
+   //---
+   //--- rebuild this node's column bounds from its description
+   //---
+   nodeLB.resize(n_cols);
+   nodeUB.resize(n_cols);
+   desc->getBounds(&nodeLB[0], &nodeUB[0]);
+   lbs = &nodeLB[0];
+   ubs = &nodeUB[0];
 
    if (!isRoot) {
       //---
@@ -194,6 +297,12 @@ int AlpsDecompTreeNode::process(bool isRoot,
          }
       }
               );
+      //---
+      //--- bring back the parent's basic master columns before the
+      //---   bounds are set, the basis is set in processNode
+      //---
+      decompAlgo->setMasterWarmStart(desc->getMasterWarmStart());
+      decompAlgo->setBranchRows(desc->getBranchRows());
       decompAlgo->setMasterBounds(lbs, ubs);
       decompAlgo->setSubProbBounds(lbs, ubs);
    } else {
@@ -204,6 +313,12 @@ int AlpsDecompTreeNode::process(bool isRoot,
          checkIncumbent(model, decompAlgo->getXhatIPBest());
       }
 
+      //---
+      //--- no branching rows at the root (the rows of the last node
+      //---   processed, if any, are relaxed)
+      //---
+      decompAlgo->setBranchRows(desc->getBranchRows());
+
       //---
       //--- This is a first attempt at a redesign of branching rows.
       //---  We still have all of them explicitly defined, but we
@@ -241,14 +356,12 @@ int AlpsDecompTreeNode::process(bool isRoot,
    //---
    //--- update the currentUB value for decomp algo
    //---
-   currentUB = getKnowledgeBroker()->getIncumbentValue();
+   currentUB = model->getIncumbentValue();
    decompAlgo->setObjBoundIP(currentUB);//??
    gap      = decompAlgo->getInfinity();
-   globalUB = getKnowledgeBroker()->getIncumbentValue();
+   globalUB = currentUB;
 
-   if (!isRoot) {
-      bestNode = getKnowledgeBroker()->getBestNode();
-      globalLB = bestNode->getQuality();
+   if (!isRoot && model->getBestNodeQuality(globalLB)) {
       //---
       //--- if the overall gap is tight enough, fathom whatever is left
       //---
@@ -283,10 +396,18 @@ int AlpsDecompTreeNode::process(bool isRoot,
       //---
       //--- update the local currentUB value and the decomp global UB
       //---
-      currentUB = getKnowledgeBroker()->getIncumbentValue();
+      currentUB = model->getIncumbentValue();
       decompAlgo->setObjBoundIP(currentUB);
    }
 
+   //---
+   //--- the bounding may have been cut short by another racer
+   //---
+   if (checkConcurrentStop(model)) {
+      doFathom = true;
+      goto TERM_PROCESS;
+   }
+
    switch (decompStatus) {
    case STAT_FEASIBLE:
    case STAT_IP_FEASIBLE:
@@ -296,7 +417,11 @@ int AlpsDecompTreeNode::process(bool isRoot,
       //---   else                                , branch
       //---
       thisQuality = decompAlgo->getObjBestBoundLB();           //LB (min)
-      currentUB      = getKnowledgeBroker()->getIncumbentValue(); //UB (min)
+      currentUB      = model->getIncumbentValue(); //UB (min)
+
+      if (app->m_concurrent) {
+         currentUB = std::min(currentUB, app->m_concurrent->getBestUB());
+      }
 
       if (thisQuality > quality_) {
          quality_ = thisQuality;
@@ -338,6 +463,38 @@ int AlpsDecompTreeNode::process(bool isRoot,
       assert(0);
    }
 
+   //---
+   //--- the bound change from the parent, per unit of change of the
+   //---   variable it branched on, updates its pseudo-cost
+   //---
+   if (decompStatus != STAT_INFEASIBLE &&
+         desc->getBranchedDir() && desc->getBranched().size() == 1) {
+      const pair<int, double> branched = desc->getBranched()[0];
+      decompAlgo->updatePseudoCost(branched.first, desc->getBranchedDir(),
+                                   branched.second,
+                                   desc->getBranchedQuality(), thisQuality);
+   }
+
+   //---
+   //--- reduced cost fixing: the bounds this node proves (by the gap
+   //---   between its bound and the incumbent) go to its description,
+   //---   so every descendant starts from them (setMasterBounds and
+   //---   setSubProbBounds)
+   //---
+   if (!doFathom) {
+      vector< pair<int, double> > lbFix;
+      vector< pair<int, double> > ubFix;
+
+      if (decompAlgo->fixVarsByRedCost(currentUB, lbFix, ubFix)) {
+         desc->tightenBounds(lbFix, ubFix);
+         UTIL_MSG(param.msgLevel, 3,
+                  cout << "Node " << getIndex()
+                  << " reduced cost fixing LBs " << lbFix.size()
+                  << " UBs " << ubFix.size() << endl;
+                 );
+      }
+   }
+
    //TODO: control by decomp log level?
    UTIL_MSG(param.msgLevel, 3,
             cout << "Node " << getIndex()
@@ -358,15 +515,27 @@ TERM_PROCESS:
    //--- so, we fake it by acting like a branching candidate was found
    //---
    decompAlgo->postProcessNode(decompStatus);
+   //---
+   //--- the warm start (if not used) does not outlive this node
+   //---
+   decompAlgo->setMasterWarmStart(NULL);
 
    if (param.nodeLimit == 0) {
       setStatus(AlpsNodeStatusPregnant);
    } else if (doFathom) { // || param.nodeLimit == 0){
       setStatus(AlpsNodeStatusFathomed);
    } else {
+      //---
+      //--- record the master basis for the children (see branch) before
+      //---   strong branching (if any) changes the master
+      //---
+      DecompMasterWarmStart* ws = decompAlgo->getMasterWarmStart();
       status = chooseBranchingObject(model);
       if (getStatus() == AlpsNodeStatusPregnant){
+         desc->setMasterWarmStart(ws);
 	 decompAlgo->postProcessBranch(decompStatus);
+      } else {
+         UTIL_DELPTR(ws);
       }
    }
 
@@ -384,10 +553,28 @@ int AlpsDecompTreeNode::chooseBranchingObject(AlpsModel* model)
    AlpsDecompParam& param = m->getParam();
    UtilPrintFuncBegin(&cout, m_classTag, "chooseBranchingObject()",
                       param.msgLevel, 3);
-   bool gotBranch = m->getDecompAlgo()->chooseBranchSet(downBranchLB_,
-                    downBranchUB_,
-                    upBranchLB_,
-                    upBranchUB_);
+   //---
+   //--- a branching object given as rows of x (e.g., Ryan-Foster) first,
+   //---   else the variables
+   //---
+   bool gotBranch = m->getDecompAlgo()->chooseBranchRows(downBranchRows_,
+                    upBranchRows_);
+
+   if (!gotBranch) {
+      gotBranch = m->getDecompAlgo()->chooseBranchSet(downBranchLB_,
+                  downBranchUB_,
+                  upBranchLB_,
+                  upBranchUB_);
+   }
+
+   branchedOn_.clear();
+
+   if (gotBranch && downBranchLB_.empty() && upBranchUB_.empty() &&
+         downBranchUB_.size() == 1 && upBranchLB_.size() == 1 &&
+         downBranchUB_[0].first == upBranchLB_[0].first) {
+      const int j = downBranchUB_[0].first;
+      branchedOn_.push_back(make_pair(j, m->getDecompAlgo()->getXhat()[j]));
+   }
 
    if (!gotBranch) {
       setStatus(AlpsNodeStatusEvaluated);
@@ -436,40 +623,38 @@ AlpsDecompTreeNode::branch()
    //---
    std::vector< CoinTriple<AlpsNodeDesc*, AlpsNodeStatus, double> > newNodes;
    //---
-   //--- get the current node's lb/ub in original space
+   //--- children only store their bound changes w.r.t. the root
    //---
-   double*   oldLbs  = desc->lowerBounds_;
-   double*   oldUbs  = desc->upperBounds_;
    const int numCols = desc->numberCols_;
-   CoinAssert(oldLbs && oldUbs && numCols);
+   CoinAssert(numCols);
 
    //---
    //--- check to make sure the branching variables have been determined
    //---
-   if ((downBranchLB_.size() + downBranchUB_.size() == 0) ||
-         (upBranchLB_.size()   + upBranchUB_.size()   == 0)) {
+   if ((downBranchLB_.size() + downBranchUB_.size()
+         + downBranchRows_.size() == 0) ||
+         (upBranchLB_.size()   + upBranchUB_.size()
+          + upBranchRows_.size()   == 0)) {
       std::cout << "AlpsDecompError: "
                 << "downBranch_.size() = "
                 << downBranchLB_.size() + downBranchUB_.size()
                 << "; upBranch_.size() = "
                 << upBranchLB_.size() + upBranchUB_.size()
+                << "; downBranchRows_.size() = " << downBranchRows_.size()
+                << "; upBranchRows_.size() = " << upBranchRows_.size()
                 << "; index_ = " << index_ << std::endl;
       throw CoinError("empty branch variable set(s)",
                       "branch", "AlpsDecompTreeNode");
    }
 
-   //---
-   //--- create space for the new bounds for the children
-   //---
-   double* newLbs = new double[numCols];
-   double* newUbs = new double[numCols];
-   std::copy(oldLbs, oldLbs + numCols, newLbs);
-   std::copy(oldUbs, oldUbs + numCols, newUbs);
    //---
    //--- the objective estimate of the new nodes are init'd to the
-   //---  current node's objective (the new node's parent's objective)
+   //---  current node's objective (the new node's parent's objective),
+   //---  or to their strong branching bound (BranchStrongIter)
    //---
    double objVal(getQuality());
+   double objDown(objVal);
+   double objUp(objVal);
 
    //---
    //--- Branch down
@@ -483,8 +668,6 @@ AlpsDecompTreeNode::branch()
          throw CoinError("branch index is out of range",
                          "branch", "AlpsDecompTreeNode");
       }
-
-      newLbs[downBranchLB_[i].first] = downBranchLB_[i].second;
    }
 
    for (unsigned i = 0; i < downBranchUB_.size(); i++) {
@@ -496,48 +679,33 @@ AlpsDecompTreeNode::branch()
          throw CoinError("branch index is out of range",
                          "branch", "AlpsDecompTreeNode");
       }
-
-      newUbs[downBranchUB_[i].first] = downBranchUB_[i].second;
    }
 
-   assert(downBranchLB_.size() + downBranchUB_.size() > 0);
-   child = new AlpsDecompNodeDesc(m, newLbs, newUbs);
+   assert(downBranchLB_.size() + downBranchUB_.size()
+          + downBranchRows_.size() > 0);
+   child = new AlpsDecompNodeDesc(m, desc, downBranchLB_, downBranchUB_,
+                                  downBranchRows_);
    child->setBranchedDir(-1);//enum?
+   child->setBranched(branchedOn_);
+   child->setBranchedQuality(objVal);
 
-   if (decompParam.BranchStrongIter) {
-      double globalUB             = getKnowledgeBroker()->getIncumbentValue();
-      int    solveMasterAsMip      = decompParam.SolveMasterAsMip;
-      int    limitTotalCutIters   = decompParam.TotalCutItersLimit;
-      int    limitTotalPriceIters = decompParam.TotalPriceItersLimit;
-      //---
-      //--- calculate an estimate on the lower bound after branching
-      //---
-      //decompParam.TotalCutItersLimit   = decompParam.BranchStrongIter;
-      decompParam.TotalCutItersLimit   = 0;
-      decompParam.TotalPriceItersLimit = decompParam.BranchStrongIter;
-      decompParam.SolveMasterAsMip      = 0;
-      decompAlgo->setStrongBranchIter(true);
-      decompAlgo->setMasterBounds(newLbs, newUbs);
-      decompAlgo->setSubProbBounds(newLbs, newUbs);
-      decompAlgo->processNode(this, objVal, globalUB);
-      decompAlgo->setStrongBranchIter(false);
-      decompParam.TotalCutItersLimit   = limitTotalCutIters;
-      decompParam.TotalPriceItersLimit = limitTotalPriceIters;
-      decompParam.SolveMasterAsMip      = solveMasterAsMip;
-      //TOOD: what if it stops in Phase1
-      //how will this work in CPM?
+   //---
+   //--- strong branching only evaluates bound changes
+   //---
+   if (decompParam.BranchStrongIter && downBranchRows_.empty() &&
+         !strongBranchChild(m, child, objDown)) {
+      //---
+      //--- infeasible, or cannot improve on the incumbent
+      //---
+      delete child;
+   } else {
+      newNodes.push_back(CoinMakeTriple(static_cast<AlpsNodeDesc*>(child),
+                                        AlpsNodeStatusCandidate,
+                                        objDown));
    }
-
-   newNodes.push_back(CoinMakeTriple(static_cast<AlpsNodeDesc*>(child),
-                                     AlpsNodeStatusCandidate,
-                                     objVal));
    //---
    //--- Branch up
    //---
-   //TODO: this can be done more cheaply than a full copy
-   std::copy(oldLbs, oldLbs + numCols, newLbs);
-   std::copy(oldUbs, oldUbs + numCols, newUbs);
-
    for (unsigned i = 0; i < upBranchLB_.size(); i++) {
       if ((upBranchLB_[i].first < 0) ||
             (upBranchLB_[i].first >= numCols)) {
@@ -547,8 +715,6 @@ AlpsDecompTreeNode::branch()
          throw CoinError("branch index is out of range",
                          "branch", "AlpsDecompTreeNode");
       }
-
-      newLbs[upBranchLB_[i].first] = upBranchLB_[i].second;
    }
 
    for (unsigned i = 0; i < upBranchUB_.size(); i++) {
@@ -560,57 +726,40 @@ AlpsDecompTreeNode::branch()
          throw CoinError("branch index is out of range",
                          "branch", "AlpsDecompTreeNode");
       }
-
-      newUbs[upBranchUB_[i].first] = upBranchUB_[i].second;
    }
 
-   assert(upBranchLB_.size() + upBranchUB_.size() > 0);
-   child = new AlpsDecompNodeDesc(m, newLbs, newUbs);
+   assert(upBranchLB_.size() + upBranchUB_.size()
+          + upBranchRows_.size() > 0);
+   child = new AlpsDecompNodeDesc(m, desc, upBranchLB_, upBranchUB_,
+                                  upBranchRows_);
    child->setBranchedDir(1);//enum?
+   child->setBranched(branchedOn_);
+   child->setBranchedQuality(objVal);
 
-   if (decompParam.BranchStrongIter) {
-      double globalUB             = getKnowledgeBroker()->getIncumbentValue();
-      int    solveMasterAsMip      = decompParam.SolveMasterAsMip;
-      int    limitTotalCutIters   = decompParam.TotalCutItersLimit;
-      int    limitTotalPriceIters = decompParam.TotalPriceItersLimit;
-      //---
-      //--- calculate an estimate on the lower bound after branching
-      //---
-      //decompParam.TotalCutItersLimit   = decompParam.BranchStrongIter;
-      decompParam.TotalCutItersLimit   = 0;
-      decompParam.TotalPriceItersLimit = decompParam.BranchStrongIter;
-      decompParam.SolveMasterAsMip      = 0;
-      decompAlgo->setStrongBranchIter(true);
-      decompAlgo->setMasterBounds(newLbs, newUbs);
-      decompAlgo->setSubProbBounds(newLbs, newUbs);
-      decompAlgo->processNode(this, objVal, globalUB);
-      decompAlgo->setStrongBranchIter(false);
-      decompParam.TotalCutItersLimit   = limitTotalCutIters;
-      decompParam.TotalPriceItersLimit = limitTotalPriceIters;
-      decompParam.SolveMasterAsMip      = solveMasterAsMip;
+   if (decompParam.BranchStrongIter && upBranchRows_.empty() &&
+         !strongBranchChild(m, child, objUp)) {
+      delete child;
+   } else {
+      newNodes.push_back(CoinMakeTriple(static_cast<AlpsNodeDesc*>(child),
+                                        AlpsNodeStatusCandidate,
+                                        objUp));
    }
 
-   newNodes.push_back(CoinMakeTriple(static_cast<AlpsNodeDesc*>(child),
-                                     AlpsNodeStatusCandidate,
-                                     objVal));
-
    //---
-   //--- clean-up
+   //--- the children have their own copy of the master warm start
    //---
-   if (newLbs != 0) {
-      delete [] newLbs;
-      newLbs = 0;
-   }
-
-   if (newUbs != 0) {
-      delete [] newUbs;
-      newUbs = 0;
-   }
-
+   DecompMasterWarmStart* ws = NULL;
+   desc->setMasterWarmStart(ws);
    //---
-   //--- change this node's status to branched
+   //--- change this node's status to branched (fathomed, if strong
+   //---   branching dropped both children)
    //---
-   setStatus(AlpsNodeStatusBranched);
+   if (newNodes.empty()) {
+      setStatus(AlpsNodeStatusFathomed);
+   } else {
+      setStatus(AlpsNodeStatusBranched);
+   }
+
    UtilPrintFuncEnd(&cout, m_classTag, "branch()", param.msgLevel, 3);
    return newNodes;
 }
@@ -18,10 +18,12 @@
 //===========================================================================//
 #include "Alps.h"
 #include "AlpsTreeNode.h"
+#include "DecompBranchRow.h"
 
 //===========================================================================//
 class AlpsNodeDesc;
 class AlpsDecompModel;
+class AlpsDecompNodeDesc;
 
 //===========================================================================//
 class AlpsDecompTreeNode : public AlpsTreeNode {
@@ -34,6 +36,20 @@ private:
    std::vector< std::pair<int, double> > upBranchLB_;
    std::vector< std::pair<int, double> > upBranchUB_;
 
+   /**
+    * The branching rows of the children, if this node branches on rows
+    *   of x (see DecompAlgo::chooseBranchRows) instead of on bounds.
+    */
+   std::vector<DecompBranchRow> downBranchRows_;
+   std::vector<DecompBranchRow> upBranchRows_;
+
+   /**
+    * The variable branched on and its value in this node's solution
+    *   (single variable branching only), passed on to the children to
+    *   update the pseudo-costs once they are processed.
+    */
+   std::vector< std::pair<int, double> > branchedOn_;
+
 public:
    /** Default constructor. */
    AlpsDecompTreeNode() :
@@ -51,6 +67,22 @@ public:
    bool checkIncumbent(AlpsDecompModel*       model,
                        const DecompSolution* decompSol);
 
+   /**
+    * Concurrent mode: return true if another racer has closed the gap,
+    * in which case this node should be fathomed without further work.
+    */
+   bool checkConcurrentStop(AlpsDecompModel* model);
+
+   /**
+    * Strong branching (BranchStrongIter): evaluate child, a child of this
+    * node whose parent bound is quality, with DecompAlgo::evalStrongBranch.
+    * Returns false if the child can be dropped (infeasible, or its bound
+    * reaches the incumbent), else its bound in quality.
+    */
+   bool strongBranchChild(AlpsDecompModel*    model,
+                          AlpsDecompNodeDesc* child,
+                          double&             quality);
+
    //---
    //--- pure virtual functions from AlpsTreeNode or AlpsTreeNode
    //---
@@ -116,6 +116,8 @@ struct DecompMainParam {
    double timeSolveReal ;
    double bestLB;
    double bestUB;
+   //racer was stopped early because another racer closed the gap
+   bool   stopped;
 };
 
 
@@ -145,16 +147,18 @@ enum DecompAlgoStop {
    DecompStopInfeasible,
    DecompStopBound,
    DecompStopTime,
-   DecompStopIterLimit
+   DecompStopIterLimit,
+   DecompStopConcurrent
 };
-const std::string DecompAlgoStopStr[7] = {
+const std::string DecompAlgoStopStr[8] = {
    "DecompStopNo",
    "DecompStopGap",
    "DecompStopTailOff",
    "DecompStopInfeasible",
    "DecompStopBound",
    "DecompStopTime",
-   "DecompStopIterLimit"
+   "DecompStopIterLimit",
+   "DecompStopConcurrent"
 };
 
 
@@ -237,7 +241,17 @@ enum DecompSolverType {
 
 enum DecompRoundRobin {
    RoundRobinRotate    = 0,
-   RoundRobinMostNegRC = 1
+   RoundRobinMostNegRC = 1,
+   RoundRobinAdaptive  = 2
+};
+
+//===========================================================================//
+enum DecompDualStab {
+   DualStabNone    = 0,
+   DualStabWentges = 1,
+   DualStabInOut   = 2,
+   DualStabBoxStep = 3,
+   DualStabPenalty = 4
 };
 
 //===========================================================================//
@@ -53,10 +53,21 @@ void DecompAlgo::checkBlocksColumns()
    }
 
    //---
-   //--- sanity check that the blocks are column disjoint
-   //---
+   //--- sanity check that the blocks are column disjoint and that,
+   //---   together with the master-only columns, they cover all columns
+   //---   in core - if not, these are 'master-only' columns which can be
+   //---   dealt with using either LD or the using the ideas of Rob Pratt
+   //---   discussion (9/27/09), or defined explicitly by user
+   //---
+   //--- one owner marker per column (-1 = not yet covered), so this is
+   //---   linear in the total number of active columns
+   //---
+   const DecompSubModel& modelCore = getModelCore();
+   const int             nCols     = modelCore.getModel()->getNumCols();
+   const vector<string>& colNames  = modelCore.getModel()->getColNames();
+   vector<int>           colOwner(nCols, -1);
    map<int, DecompSubModel>::iterator mid1;
-   map<int, DecompSubModel>::iterator mid2;
+   vector<int>::const_iterator        vit;
 
    for (mid1 = m_modelRelax.begin(); mid1 != m_modelRelax.end(); ++mid1) {
       DecompSubModel&      modelRelax1 = (*mid1).second;
@@ -68,88 +79,55 @@ void DecompAlgo::checkBlocksColumns()
          return;
       }
 
-      set<int>&             activeCols1
-      = modelRelax1.getModel()->activeColumnsS;
+      const vector<int>& activeCols1 = model->getActiveColumns();
+      bool               overlap     = false;
+
+      for (vit = activeCols1.begin(); vit != activeCols1.end(); ++vit) {
+         int& owner = colOwner[*vit];
 
-      for (mid2 = m_modelRelax.begin(); mid2 != m_modelRelax.end(); ++mid2) {
-         if (mid1 == mid2) {
+         if (owner == -1) {
+            owner = modelRelax1.getBlockId();
             continue;
          }
 
-         DecompSubModel& modelRelax2 = (*mid2).second;
-         set<int>&         activeCols2
-         = modelRelax2.getModel()->activeColumnsS;
-         set<int>          activeCols1inter2;
-         //this is very expensive - can we improve?
-         set_intersection(activeCols1.begin(), activeCols1.end(),
-                          activeCols2.begin(), activeCols2.end(),
-                          inserter(activeCols1inter2,
-                                   activeCols1inter2.begin()));
-
-         if (activeCols1inter2.size() > 0) {
+         if (!overlap) {
+            const DecompSubModel& modelRelax2
+            = m_modelRelax.find(owner)->second;
             cerr << "NOTE: the columns in block " << modelRelax1.getBlockId()
                  << " -> " << modelRelax1.getModelName() << " and block "
                  << modelRelax2.getBlockId()
                  << " -> " << modelRelax2.getModelName() << " overlap."
                  << endl;
-            set<int>::iterator it;
-
-            for (it  = activeCols1inter2.begin();
-                  it != activeCols1inter2.end(); ++it) {
-               (*m_osLog) << "Column " << setw(5) << *it << " -> ";
-
-               if (modelRelax2.getModel()->colNames.size() > 0)
-                  (*m_osLog)
-                        << setw(25) << modelRelax2.getModel()->colNames[*it];
+            overlap = true;
+         }
 
-               (*m_osLog) << " is found in both blocks." << endl;
-            }
+         (*m_osLog) << "Column " << setw(5) << *vit << " -> ";
 
-            throw UtilException("Columns in some blocks overlap.",
-                                "checkBlocksColumns", "DecompAlgo");
+         if (colNames.size() > 0) {
+            (*m_osLog) << setw(25) << colNames[*vit];
          }
-      }
-   }
 
-   //---
-   //--- sanity check that the union of active columns in blocks
-   //---   should cover all columns in core - if not, these are 'master-only'
-   //---   columns which can be dealt with using either LD or the using the
-   //---   ideas of Rob Pratt discussion (9/27/09), or defined explicitly
-   //---   by user
-   //---
-   set<int> activeColsUnion;
-   set<int>::iterator sit;
+         (*m_osLog) << " is found in both blocks." << endl;
+      }
 
-   for (mid1 = m_modelRelax.begin(); mid1 != m_modelRelax.end(); ++mid1) {
-      DecompSubModel&      modelRelax = (*mid1).second;
-      DecompConstraintSet* model      = modelRelax.getModel();
-      assert(model);
-      set<int>&             activeCols = model->activeColumnsS;
-      set_union(activeCols.begin(),       activeCols.end(),
-                activeColsUnion.begin(),  activeColsUnion.end(),
-                inserter(activeColsUnion, activeColsUnion.begin()));
+      if (overlap)
+         throw UtilException("Columns in some blocks overlap.",
+                             "checkBlocksColumns", "DecompAlgo");
    }
 
-   const DecompSubModel& modelCore      = getModelCore();
-
-   // add the master-only variables ot the set union
+   // add the master-only variables ot the union
    const vector<int>& masterOnlyCols = modelCore.getModel()->getMasterOnlyCols();
 
-   set<int> masterOnlyColsSet(masterOnlyCols.begin(), masterOnlyCols.end());
-
-   set_union(masterOnlyColsSet.begin(), masterOnlyColsSet.end(),
-             activeColsUnion.begin(), activeColsUnion.end(),
-             inserter(activeColsUnion, activeColsUnion.begin()));
+   for (vit = masterOnlyCols.begin(); vit != masterOnlyCols.end(); ++vit) {
+      colOwner[*vit] = -2;
+   }
 
    bool                    allColsCovered = true;
 
-   for (int i = 0; i < modelCore.getModel()->getNumCols(); i++) {
-      sit = activeColsUnion.find(i);
-
-      if (sit == activeColsUnion.end()) {
+   for (int i = 0; i < nCols; i++) {
+      if (colOwner[i] == -1) {
          (*m_osLog) << "Column " << setw(5) << i << " -> "
-                    << setw(25) << modelCore.getModel()->colNames[i]
+                    << setw(25) << colNames[i]
                     << " is missing from union of blocks." << endl;
          allColsCovered = false;
       }
@@ -209,6 +187,15 @@ void DecompAlgo::initSetup()
       checkBlocksColumns();
    }
 
+   //---
+   //--- the Ryan-Foster rows only hold column by column, so they can not
+   //---   be enforced as master rows (see chooseBranchRows)
+   //---
+   if (m_param.BranchRowRule == 1 && !m_param.BranchEnforceInSubProb) {
+      throw UtilException("BranchRowRule=1 requires BranchEnforceInSubProb",
+                          "initSetup", "DecompAlgo");
+   }
+
    //---
    //--- if we have a core, allocate a pool of memory for re-use
    //---
@@ -217,6 +204,12 @@ void DecompAlgo::initSetup()
                                modelCore->getNumRows());
    }
 
+   //---
+   //--- memory budget for the archive of compressed columns
+   //---
+   m_colArchive->setMaxBytes(static_cast<size_t>(m_param.ColArchiveMaxMB
+                                                * 1024.0 * 1024.0));
+
    //---
    //--- By default the relaxation can be solved using a generic IP solver.
    //---
@@ -269,6 +262,7 @@ void DecompAlgo::initSetup()
    assert(m_xhat && m_colLBNode && m_colUBNode);
    memcpy(m_colLBNode, colLB, nCols * sizeof(double));
    memcpy(m_colUBNode, colUB, nCols * sizeof(double));
+   m_pseudoCostOwn.resize(nCols);
    //---
    //--- PC: create an initial set of points F'[0] subseteq F' (c    + eps)
    //--- DC: create an initial set of points F'[0] subseteq F' (xhat + eps)
@@ -1622,6 +1616,7 @@ DecompStatus DecompAlgo::processNode(const AlpsDecompTreeNode* node,
    //---
    m_stats.timerDecomp.reset();
    m_nodeStats.init();
+   clearPricingCache();
    m_nodeStats.nodeIndex      = nodeIndex;
    //NOTE: changed on 5/25/2010
    //  if we use the parent LB, then stabilized won't
@@ -1651,6 +1646,10 @@ DecompStatus DecompAlgo::processNode(const AlpsDecompTreeNode* node,
    m_firstPhase2Call = false;
    phaseInit(m_phaseLast);
    m_phase           = m_phaseLast;
+   //---
+   //--- start from the parent's basis (see setMasterWarmStart)
+   //---
+   applyMasterWarmStart();
 
    //---
    //--- it is possible that phaseInit can find
@@ -1823,6 +1822,25 @@ DecompStatus DecompAlgo::processNode(const AlpsDecompTreeNode* node,
          m_phase        = PHASE_DONE;
       }
 
+      //---
+      //--- in Concurrent mode, pick up incumbents found by the other
+      //---   racers, and give up if one of them has closed the gap
+      //---
+      if (m_app->m_concurrent) {
+         if (m_app->m_concurrent->getBestUB() < m_nodeStats.objBest.second) {
+            setObjBoundIP(m_app->m_concurrent->getBestUB());
+         }
+
+         if (m_app->m_concurrent->isStopped()) {
+            UTIL_MSG(m_param.LogLevel, 2,
+                     (*m_osLog)
+                     << "Node " << nodeIndex << " process stopping since "
+                     << "another racer closed the gap." << endl;);
+            m_stopCriteria = DecompStopConcurrent;
+            m_phase        = PHASE_DONE;
+         }
+      }
+
       //---
       //--- if the lower bound meets the global ub, we are done
       //---    careful here - do NOT do this check in phase1 since
@@ -1868,6 +1886,14 @@ DecompStatus DecompAlgo::processNode(const AlpsDecompTreeNode* node,
                                     double subProbDynamicGap = std::max((m_param.InitialOptimalityGapInexactSubSolving - (m_nodeStats.priceCallsRound - 1) *
         	                                 m_param.OptimalGapStepSizeInexactSubSolving), 0.0);
                                     m_param.SubProbGapLimitInexact = std::min(subProbDynamicGap, m_param.SubProbGapLimitInexact); 
+
+            //---
+            //--- heuristic pricing: the subproblem MIPs stop early, on
+            //---   the first SubProbInexactSolLimit columns with rc < 0
+            //---
+            if (m_param.SubProbInexactSolLimit > 0) {
+               subProbSolvePhase = SUBSOLVE_PHASE_INEXACT;
+            }
          }
          //---
          //--- after adding some rows, the columns in the var pool
@@ -1894,25 +1920,66 @@ DecompStatus DecompAlgo::processNode(const AlpsDecompTreeNode* node,
          }
 
          //---
-         //--- attempt to generate some new variables with rc < 0
+         //--- try the archived columns first, solve the subproblems
+         //---   only if none of them has rc < 0
          //---
          mostNegRC                  = 0.0;
-         m_nodeStats.varsThisCall   = generateVars(newVars, mostNegRC);
-         m_nodeStats.varsThisRound += m_nodeStats.varsThisCall;
-         m_nodeStats.cutsThisCall   = 0;
-         map<int, DecompSubModel>::iterator mit;
+         m_nodeStats.varsThisCall   = generateVarsFromArchive(newVars);
+         bool solvedSubProbs        = m_nodeStats.varsThisCall == 0;
+
+         //---
+         //--- attempt to generate some new variables with rc < 0
+         //---
+         if (solvedSubProbs) {
+            m_nodeStats.varsThisCall = generateVars(newVars, mostNegRC);
+
+            //---
+            //--- the heuristic round found nothing, it proves nothing
+            //---   either - repeat the round with exact pricing
+            //---
+            if (m_nodeStats.varsThisCall == 0 &&
+                  subProbSolvePhase == SUBSOLVE_PHASE_INEXACT) {
+               UTIL_MSG(m_param.LogDebugLevel, 3,
+                        (*m_osLog) << "Inexact pricing found no columns, "
+                        << "switching to exact pricing.\n";);
+               subProbSolvePhase = SUBSOLVE_PHASE_EXACT;
+               mostNegRC         = 0.0;
+               m_nodeStats.varsThisCall = generateVars(newVars, mostNegRC);
+            }
+
+            map<int, DecompSubModel>::iterator mit;
 
-         for (mit = m_modelRelax.begin(); mit != m_modelRelax.end();++mit) {
-            (*mit).second.setCounter((*mit).second.getCounter() + 1);
+            for (mit = m_modelRelax.begin(); mit != m_modelRelax.end();++mit) {
+               (*mit).second.setCounter((*mit).second.getCounter() + 1);
+            }
          }
 
+         m_nodeStats.varsThisRound += m_nodeStats.varsThisCall;
+         m_nodeStats.cutsThisCall   = 0;
+
          // Store the m_numCols and use it in updateObjBound function
          m_numCols = m_masterSI->getNumCols();
 
-         if (m_isColGenExact           &&
+         if (solvedSubProbs            &&
+               m_isColGenExact           &&
                m_rrIterSinceAll == 0     &&
                m_status == STAT_FEASIBLE) {
             bool isGapTight = updateObjBound(mostNegRC);
+         } else if (solvedSubProbs            &&
+                    m_status == STAT_FEASIBLE &&
+                    m_pricingBoundValid) {
+            //---
+            //--- partial or inexact round, bound from the cached
+            //---   block values (see calcPricingCacheBound)
+            //---
+            updateObjBound(m_pricingBoundRC);
+         }
+
+         //---
+         //--- let the dual stabilization see the new columns
+         //---
+         if (solvedSubProbs) {
+            updateDualStab(newVars);
          }
 
          if (m_nodeStats.varsThisCall > 0) {
@@ -1926,6 +1993,14 @@ DecompStatus DecompAlgo::processNode(const AlpsDecompTreeNode* node,
             addVarsFromPool();
          }
 
+         //---
+         //--- nothing new (or only duplicates) at stabilized duals,
+         //---   repeat the pricing call with a weaker stabilization
+         //---
+         if (m_nodeStats.varsThisCall == 0 && isDualStabMisprice()) {
+            m_phaseForce = m_phase;
+         }
+
          //printf("m_isColGenExact  = %d\n", m_isColGenExact);
          //printf("m_rrIterSinceAll = %d\n", m_rrIterSinceAll);
          //printf("m_status         = %d\n", m_status);
@@ -2369,7 +2444,8 @@ void DecompAlgo::setMasterBounds(const double* lbs,
    if (m_branchingImplementation == DecompBranchInSubproblem  ) {
       //---
       //--- Must remove (or fix to 0) any column in master that
-      //---    does not satisfy the branching bounds.
+      //---    does not satisfy the branching bounds (or the branching
+      //---    rows of its block, see setBranchRows).
       //--- However -- be careful that these bounds should
       //---    only be applied to their relevant blocks.
       //---
@@ -2388,6 +2464,7 @@ void DecompAlgo::setMasterBounds(const double* lbs,
       const double*         colUB     = m_masterSI->getColUpper();
       double*               denseS    = new double[nCols];
       map<int, DecompSubModel>::iterator mit;
+      UtilFillN(denseS, nCols, 0.0);//doesSatisfyBounds keeps it zero
 
       for (li = m_vars.begin(); li != m_vars.end(); ++li) {
          masterColIndex = (*li)->getColMasterIndex();
@@ -2397,7 +2474,8 @@ void DecompAlgo::setMasterBounds(const double* lbs,
 
          if (!(*li)->doesSatisfyBounds(nCols, denseS,
                                        mit->second,
-                                       lbs, ubs)) {
+                                       lbs, ubs) ||
+               !doesSatisfyBranchRows(*li, denseS)) {
             //---
             //--- if needs to be fixed
             //---
@@ -2512,6 +2590,365 @@ void DecompAlgo::setMasterBounds(const double* lbs,
                     "setMasterBounds()", m_param.LogDebugLevel, 2);
 }
 
+//--------------------------------------------------------------------- //
+int DecompAlgo::fixVarsByRedCost(const double             globalUB,
+                                 vector< pair<int, double> >& lbFix,
+                                 vector< pair<int, double> >& ubFix)
+{
+   lbFix.clear();
+   ubFix.clear();
+
+   //---
+   //--- the master must hold the Phase II objective, solved to optimality
+   //---
+   if (!m_param.RedCostFixing         ||
+         m_algo != PRICE_AND_CUT       ||
+         m_masterOnlyCols.empty()      ||
+         m_phaseLast != PHASE_PRICE2   ||
+         globalUB >= m_infinity        ||
+         !m_masterSI->isProvenOptimal()) {
+      return 0;
+   }
+
+   UtilPrintFuncBegin(m_osLog, m_classTag,
+                      "fixVarsByRedCost()", m_param.LogDebugLevel, 2);
+   //---
+   //--- any u gives a valid Lagrangian bound L(u), the master duals
+   //---   are the natural choice; the block terms come from the cache
+   //---
+   DecompConstraintSet* modelCore   = m_modelCore.getModel();
+   const int             nCoreCols   = modelCore->getNumCols();
+   const int             nMasterRows = m_masterSI->getNumRows();
+   const char*           integerMark = modelCore->getIntegerMark();
+   const double*         u           = m_masterSI->getRowPrice();
+   const double*         x           = m_masterSI->getColSolution();
+   const double*         colLB       = m_masterSI->getColLower();
+   const double*         colUB       = m_masterSI->getColUpper();
+   double                mostNegRC   = 0.0;
+   vector<int>::const_iterator it;
+
+   if (calcPricingCacheBound(u, mostNegRC)) {
+      const double lagBound = calcLagrangianBound(u, mostNegRC);
+      const double gap      = globalUB - lagBound;
+
+      if (lagBound > -m_infinity && gap >= 0.0) {
+         //---
+         //--- (c - uA'')_j in x-space, for a master-only column it is the
+         //---   reduced cost of its master column
+         //---
+         vector<double> uAdj(nMasterRows - m_numConvexCon);
+         vector<double> redCostX(nCoreCols);
+         generateVarsAdjustDuals(u, &uAdj[0]);
+         generateVarsCalcRedCost(&uAdj[0], &redCostX[0]);
+
+         for (it = m_masterOnlyCols.begin();
+               it != m_masterOnlyCols.end(); ++it) {
+            const int j = *it;
+            const int c = m_masterOnlyColsMap[j];
+
+            if (integerMark[j] != 'I') {
+               continue;
+            }
+
+            fixVarByRedCost(j, redCostX[j], x[c], colLB[c], colUB[c], gap,
+                            lbFix, ubFix);
+         }
+      }
+   }
+
+   UTIL_MSG(m_param.LogDebugLevel, 3,
+            (*m_osLog) << "Reduced cost fixing: tightened "
+            << lbFix.size() << " LBs and " << ubFix.size() << " UBs"
+            << endl;
+           );
+   UtilPrintFuncEnd(m_osLog, m_classTag,
+                    "fixVarsByRedCost()", m_param.LogDebugLevel, 2);
+   return static_cast<int>(lbFix.size() + ubFix.size());
+}
+
+//--------------------------------------------------------------------- //
+DecompMasterWarmStart* DecompAlgo::getMasterWarmStart() const
+{
+   if (!m_param.NodeWarmStart || m_algo != PRICE_AND_CUT || !m_masterSI) {
+      return NULL;
+   }
+
+   CoinWarmStartBasis* basis
+   = dynamic_cast<CoinWarmStartBasis*>(m_masterSI->getWarmStart());
+   const int nCols = m_masterSI->getNumCols();
+   const int nRows = m_masterSI->getNumRows();
+
+   if (!basis                              ||
+         basis->getNumStructural() != nCols ||
+         basis->getNumArtificial() != nRows) {
+      UTIL_DELPTR(basis);
+      return NULL;
+   }
+
+   int c, r;
+   DecompVarList::const_iterator li;
+   DecompMasterWarmStart* ws = new DecompMasterWarmStart();
+   ws->m_producer = this;
+   ws->m_rowStatus.resize(nRows);
+
+   for (r = 0; r < nRows; r++) {
+      ws->m_rowStatus[r] = static_cast<char>(basis->getArtifStatus(r));
+   }
+
+   for (c = 0; c < nCols; c++) {
+      if (!isMasterColStructural(c)) {
+         ws->m_nonStructStatus.push_back(
+            static_cast<char>(basis->getStructStatus(c)));
+      }
+   }
+
+   //---
+   //--- the basic structural columns, by identity (if they are compressed
+   //---   out before the children are processed, they go to the archive)
+   //---
+   for (li = m_vars.begin(); li != m_vars.end(); ++li) {
+      c = (*li)->getColMasterIndex();
+
+      if (basis->getStructStatus(c) == CoinWarmStartBasis::basic) {
+         ws->m_basicCols.push_back(std::make_pair((*li)->getBlockId(),
+                                                  (*li)->getHash()));
+      }
+   }
+
+   UTIL_DELPTR(basis);
+   return ws;
+}
+
+//--------------------------------------------------------------------- //
+void DecompAlgo::setMasterWarmStart(const DecompMasterWarmStart* ws)
+{
+   m_masterWarmStart = NULL;
+
+   if (!ws || !m_param.NodeWarmStart || m_algo != PRICE_AND_CUT) {
+      return;
+   }
+
+   UtilPrintFuncBegin(m_osLog, m_classTag,
+                      "setMasterWarmStart()", m_param.LogDebugLevel, 2);
+   //---
+   //--- take back from the column archive the parent's basic columns
+   //---   which have been deleted (compression) since the parent was
+   //---   processed; those evicted from the archive since are lost
+   //---
+   DecompVarList missingVars;
+   std::set< std::pair<int, UtilHashKey> > missing;
+   std::vector< std::pair<int, UtilHashKey> >::const_iterator ci;
+   int k;
+
+   for (ci = ws->m_basicCols.begin(); ci != ws->m_basicCols.end(); ++ci) {
+      if (!m_varsIndex.contains(ci->first, ci->second)) {
+         missing.insert(*ci);
+      }
+   }
+
+   if (!missing.empty()) {
+#ifdef _OPENMP
+#pragma omp critical (DecompColArchive)
+#endif
+      {
+         for (k = 0; k < m_colArchive->getNumSlots() && !missing.empty();
+               k++) {
+            if (m_colArchive->isLive(k) &&
+                  missing.erase(std::make_pair(m_colArchive->getBlockId(k),
+                                               m_colArchive->getHash(k)))) {
+               missingVars.push_back(m_colArchive->restore(k, 0.0));
+            }
+         }
+      }
+   }
+
+   UTIL_MSG(m_param.LogLevel, 3,
+            (*m_osLog) << "Warm start from parent: basic cols = "
+            << ws->m_basicCols.size() << " re-added = "
+            << missingVars.size() << " lost = " << missing.size() << endl;
+           );
+   addVarsToMaster(missingVars);
+   m_masterWarmStart = ws;
+   UtilPrintFuncEnd(m_osLog, m_classTag,
+                    "setMasterWarmStart()", m_param.LogDebugLevel, 2);
+}
+
+//--------------------------------------------------------------------- //
+void DecompAlgo::applyMasterWarmStart()
+{
+   const DecompMasterWarmStart* ws = m_masterWarmStart;
+   m_masterWarmStart = NULL;
+
+   if (!ws) {
+      return;
+   }
+
+   UtilPrintFuncBegin(m_osLog, m_classTag,
+                      "applyMasterWarmStart()", m_param.LogDebugLevel, 2);
+   int c, r, i;
+   int nBasic = 0;
+   const int     nCols  = m_masterSI->getNumCols();
+   const int     nRows  = m_masterSI->getNumRows();
+   const double* colUB  = m_masterSI->getColUpper();
+   //---
+   //--- the row and non-structural status only fit the master they were
+   //---   recorded from (another worker has its own cuts and order)
+   //---
+   const bool    ownWS  = (ws->m_producer == this);
+   const int     nRowWS = ownWS ? static_cast<int>(ws->m_rowStatus.size()) : 0;
+   const int     nNonWS = ownWS ?
+                          static_cast<int>(ws->m_nonStructStatus.size()) : 0;
+   CoinWarmStartBasis basis;
+   basis.setSize(nCols, nRows);
+
+   //---
+   //--- rows added since the parent was processed start with a basic slack
+   //---
+   for (r = 0; r < nRows; r++) {
+      CoinWarmStartBasis::Status status = CoinWarmStartBasis::basic;
+
+      if (r < nRowWS) {
+         status = static_cast<CoinWarmStartBasis::Status>(ws->m_rowStatus[r]);
+      }
+
+      basis.setArtifStatus(r, status);
+      nBasic += (status == CoinWarmStartBasis::basic);
+   }
+
+   //---
+   //--- non-structural columns by ordinal, structurals at lower bound
+   //---
+   int k = 0;
+
+   for (c = 0; c < nCols; c++) {
+      CoinWarmStartBasis::Status status = CoinWarmStartBasis::atLowerBound;
+
+      if (!isMasterColStructural(c)) {
+         if (k < nNonWS) {
+            status = static_cast<CoinWarmStartBasis::Status>
+                     (ws->m_nonStructStatus[k]);
+         }
+
+         k++;
+      }
+
+      basis.setStructStatus(c, status);
+      nBasic += (status == CoinWarmStartBasis::basic);
+   }
+
+   //---
+   //--- the parent's basic structural columns, matched by fingerprint
+   //---
+   std::map<std::pair<int, UtilHashKey>, int> varToCol;
+   std::map<std::pair<int, UtilHashKey>, int>::const_iterator mi;
+   std::vector< std::pair<int, UtilHashKey> >::const_iterator ci;
+   DecompVarList::const_iterator li;
+   std::vector<int> lostCols;
+   std::vector<int> basicCols;
+
+   for (li = m_vars.begin(); li != m_vars.end(); ++li) {
+      varToCol[std::make_pair((*li)->getBlockId(), (*li)->getHash())]
+         = (*li)->getColMasterIndex();
+   }
+
+   for (ci = ws->m_basicCols.begin(); ci != ws->m_basicCols.end(); ++ci) {
+      mi = varToCol.find(*ci);
+
+      if (mi == varToCol.end()) {
+         continue;
+      }
+
+      c = mi->second;
+
+      if (colUB[c] > DecompEpsilon) {
+         basis.setStructStatus(c, CoinWarmStartBasis::basic);
+         basicCols.push_back(c);
+         nBasic++;
+      } else {
+         //fixed to 0 by the branching decision
+         lostCols.push_back(c);
+      }
+   }
+
+   //---
+   //--- replace each basic column which got fixed by a slack of one of
+   //---   its rows, so the basis keeps the right size
+   //---
+   if (lostCols.size() && nBasic < nRows) {
+      const CoinPackedMatrix* matrix = m_masterSI->getMatrixByCol();
+      std::vector<int>::const_iterator vi;
+
+      for (vi = lostCols.begin(); vi != lostCols.end(); ++vi) {
+         if (nBasic >= nRows) {
+            break;
+         }
+
+         const CoinShallowPackedVector col = matrix->getVector(*vi);
+         const int*                    ind = col.getIndices();
+
+         for (i = 0; i < col.getNumElements(); i++) {
+            if (basis.getArtifStatus(ind[i]) != CoinWarmStartBasis::basic) {
+               basis.setArtifStatus(ind[i], CoinWarmStartBasis::basic);
+               nBasic++;
+               break;
+            }
+         }
+      }
+   }
+
+   //---
+   //--- from another worker's warm start all slacks start basic, so each
+   //---   basic column takes the place of the slack of one of its rows
+   //---   (or is left out if all of them are taken already)
+   //---
+   if (nBasic > nRows) {
+      const CoinPackedMatrix* matrix = m_masterSI->getMatrixByCol();
+      std::vector<int>::const_iterator vi;
+
+      for (vi = basicCols.begin(); vi != basicCols.end(); ++vi) {
+         if (nBasic <= nRows) {
+            break;
+         }
+
+         const CoinShallowPackedVector col = matrix->getVector(*vi);
+         const int*                    ind = col.getIndices();
+
+         for (i = 0; i < col.getNumElements(); i++) {
+            if (basis.getArtifStatus(ind[i]) == CoinWarmStartBasis::basic) {
+               basis.setArtifStatus(ind[i], CoinWarmStartBasis::atLowerBound);
+               break;
+            }
+         }
+
+         if (i == col.getNumElements()) {
+            basis.setStructStatus(*vi, CoinWarmStartBasis::atLowerBound);
+         }
+
+         nBasic--;
+      }
+   }
+
+   //---
+   //--- the parent's basic columns which could not be found again (evicted
+   //---   from the archive) leave the basis short, fill it with slacks
+   //---
+   for (r = 0; r < nRows && nBasic < nRows; r++) {
+      if (basis.getArtifStatus(r) != CoinWarmStartBasis::basic) {
+         basis.setArtifStatus(r, CoinWarmStartBasis::basic);
+         nBasic++;
+      }
+   }
+
+   UTIL_MSG(m_param.LogLevel, 4,
+            (*m_osLog) << "Warm start master basis: basic = " << nBasic
+            << " rows = " << nRows << " fixed = " << lostCols.size()
+            << endl;
+           );
+   m_masterSI->setWarmStart(&basis);
+   UtilPrintFuncEnd(m_osLog, m_classTag,
+                    "applyMasterWarmStart()", m_param.LogDebugLevel, 2);
+}
+
 //===========================================================================//
 DecompStatus DecompAlgo::solutionUpdate(const DecompPhase phase,
                                         bool              resolve,
@@ -3782,7 +4219,21 @@ bool DecompAlgo::updateObjBound(const double mostNegRC)
    //zDW_LB = zDW_UBDual + mostNegRC + masterOnlyContri;
 
    //zDW_LB = zDW_UBDual + mostNegRC;
-   zDW_LB = zDW_UBPrimal + mostNegRC;
+   if (m_param.DualStab && m_phase == PHASE_PRICE2) {
+      //---
+      //--- the pricing duals are stabilized, zDW_RMP + RC* is a bound
+      //---   only at the master duals - evaluate the Lagrangian instead;
+      //---   with a box, the master value is not a valid UB unless the
+      //---   artificials are all zero
+      //---
+      zDW_LB = calcLagrangianBound(dualSol, mostNegRC);
+
+      if (isMasterArtPositive()) {
+         zDW_UBPrimal = m_infinity;
+      }
+   } else {
+      zDW_LB = zDW_UBPrimal + mostNegRC;
+   }
 
    setObjBound(zDW_LB, zDW_UBPrimal);
    /*
@@ -3851,34 +4302,140 @@ bool DecompAlgo::updateObjBound(const double mostNegRC)
 }
 
 //===========================================================================//
-void DecompAlgo::masterPhaseItoII()
+double DecompAlgo::calcLagrangianBound(const double* u,
+                                       const double  mostNegRC)
 {
    //---
-   //--- switch from Phase I to Phase II
-   //---
-   UTIL_MSG(m_app->m_param.LogDebugLevel, 4,
-            (*m_osLog) << "Switching from PhaseI to PhaseII\n";
-           );
-   int i;
-   int nMasterCols = m_masterSI->getNumCols();
-   //---
-   //--- set obj for all columns to original cost
-   //--- set obj for artificial columns to 0
-   //--- fix column bounds for artificial columns to 0
-   //---
-#ifdef STAB_DUMERLE
-   //---
-   //--- set cost on slacks to delta, where delta is init'd to
-   //---  initial duals (this is to be done in Phase 2 only)
-   //---
-   //--- min deltap sp - deltam sm
-   //---
-   //--- ax  = b --> ax + sp - sm  = b, sp >= 0 <= epsp, sm >= 0 <= epsm
-   //--- ax <= b --> ax      - sm <= b,                  sm >= 0 <= epsm
-   //--- ax >= b --> ax + sp      >= b, sp >= 0 <= epsp
-   //---
-   int            r;
-   const double* dualSol = NULL;
+   //--- L(u) = sum_r u_r * (u_r > 0 ? rowLB_r : rowUB_r)
+   //---      + sum_k min_s {(c - uA'')s - alpha_k}       (= mostNegRC)
+   //---      + sum_j min{rc_j * lb_j, rc_j * ub_j}, over the other cols
+   //---
+   //--- the structural columns are covered by the pricing; in Phase II,
+   //---   the artificial columns are not part of the problem
+   //---
+   const int               nRows = m_masterSI->getNumRows();
+   const int               nCols = m_masterSI->getNumCols();
+   const double*           rowLB = m_masterSI->getRowLower();
+   const double*           rowUB = m_masterSI->getRowUpper();
+   const double*           colLB = m_masterSI->getColLower();
+   const double*           colUB = m_masterSI->getColUpper();
+   const double*           obj   = m_masterSI->getObjCoefficients();
+   const CoinPackedMatrix* M     = m_masterSI->getMatrixByCol();
+   double                  bound = mostNegRC;
+   double                  bd, rc;
+   int                     r, c, i;
+
+   for (r = 0; r < nRows; r++) {
+      bd = u[r] > 0.0 ? rowLB[r] : rowUB[r];
+
+      if (bd > -m_infinity && bd < m_infinity) {
+         bound += u[r] * bd;
+      } else if (fabs(u[r]) > DecompEpsilon) {
+         return -m_infinity;
+      }
+   }
+
+   for (c = 0; c < nCols; c++) {
+      if (!(isMasterColMasterOnly(c) ||
+            (m_phase != PHASE_PRICE2 && isMasterColArtificial(c)))) {
+         continue;
+      }
+
+      const CoinShallowPackedVector col = M->getVector(c);
+      const int*    ind = col.getIndices();
+      const double* els = col.getElements();
+      rc = obj[c];
+
+      for (i = 0; i < col.getNumElements(); i++) {
+         rc -= u[ind[i]] * els[i];
+      }
+
+      bd = rc > 0.0 ? colLB[c] : colUB[c];
+
+      if (bd > -m_infinity && bd < m_infinity) {
+         bound += rc * bd;
+      } else if (fabs(rc) > DecompEpsilon) {
+         return -m_infinity;
+      }
+   }
+
+   return bound;
+}
+
+//===========================================================================//
+bool DecompAlgo::isMasterArtPositive() const
+{
+   const int     nCols = m_masterSI->getNumCols();
+   const double* x     = m_masterSI->getColSolution();
+
+   for (int c = 0; c < nCols; c++) {
+      if (isMasterColArtificial(c) && x[c] > DecompEpsilon) {
+         return true;
+      }
+   }
+
+   return false;
+}
+
+//===========================================================================//
+void DecompAlgo::fixVarByRedCost(const int                    j,
+                                 const double                 rc,
+                                 const double                 x,
+                                 const double                 lb,
+                                 const double                 ub,
+                                 const double                 gap,
+                                 vector< pair<int, double> >& lbFix,
+                                 vector< pair<int, double> >& ubFix)
+{
+   //---
+   //--- rc > 0: the term is rc * lb, any x_j >= lb + d with
+   //---   rc * d > gap cannot beat the incumbent, so x_j <= lb + gap/rc
+   //---   (rounded down, j is integer), and symmetrically for rc < 0
+   //---
+   if (rc > DecompEpsilon && lb > -m_infinity) {
+      const double newUB = lb + floor(gap / rc + DecompEpsilon);
+
+      if (newUB < ub - 0.5 && x <= newUB + DecompEpsilon) {
+         ubFix.push_back(make_pair(j, newUB));
+      }
+   } else if (rc < -DecompEpsilon && ub < m_infinity) {
+      const double newLB = ub - floor(gap / -rc + DecompEpsilon);
+
+      if (newLB > lb + 0.5 && x >= newLB - DecompEpsilon) {
+         lbFix.push_back(make_pair(j, newLB));
+      }
+   }
+}
+
+//===========================================================================//
+void DecompAlgo::masterPhaseItoII()
+{
+   //---
+   //--- switch from Phase I to Phase II
+   //---
+   UTIL_MSG(m_app->m_param.LogDebugLevel, 4,
+            (*m_osLog) << "Switching from PhaseI to PhaseII\n";
+           );
+   int i;
+   int nMasterCols = m_masterSI->getNumCols();
+   //---
+   //--- set obj for all columns to original cost
+   //--- set obj for artificial columns to 0
+   //--- fix column bounds for artificial columns to 0
+   //---
+#ifdef STAB_DUMERLE
+   //---
+   //--- set cost on slacks to delta, where delta is init'd to
+   //---  initial duals (this is to be done in Phase 2 only)
+   //---
+   //--- min deltap sp - deltam sm
+   //---
+   //--- ax  = b --> ax + sp - sm  = b, sp >= 0 <= epsp, sm >= 0 <= epsm
+   //--- ax <= b --> ax      - sm <= b,                  sm >= 0 <= epsm
+   //--- ax >= b --> ax + sp      >= b, sp >= 0 <= epsp
+   //---
+   int            r;
+   const double* dualSol = NULL;
 
    if (m_useInitLpDuals) {
       dualSol = m_cutgenSI->getRowPrice();
@@ -4331,7 +4888,9 @@ void DecompAlgo::phaseUpdate(DecompPhase&   phase,
       //chooseBranchVar(branchedOnIndex, branchedOnValue);
       std::vector< std::pair<int, double> > downBranchLB,
           downBranchUB, upBranchLB, upBranchUB;
-      bool gotBranch = chooseBranchSet(downBranchLB,
+      std::vector<DecompBranchRow> downBranchRows, upBranchRows;
+      bool gotBranch = chooseBranchRows(downBranchRows, upBranchRows) ||
+                       chooseBranchSet(downBranchLB,
                                        downBranchUB,
                                        upBranchLB,
                                        upBranchUB);
@@ -4399,7 +4958,9 @@ void DecompAlgo::phaseUpdate(DecompPhase&   phase,
          //chooseBranchVar(branchedOnIndex, branchedOnValue);
          std::vector< std::pair<int, double> > downBranchLB,
              downBranchUB, upBranchLB, upBranchUB;
-         bool gotBranch = chooseBranchSet(downBranchLB,
+         std::vector<DecompBranchRow> downBranchRows, upBranchRows;
+         bool gotBranch = chooseBranchRows(downBranchRows, upBranchRows) ||
+                          chooseBranchSet(downBranchLB,
                                           downBranchUB,
                                           upBranchLB,
                                           upBranchUB);
@@ -4697,6 +5258,7 @@ int DecompAlgo::generateVars(DecompVarList&     newVars,
    int           whichBlock;
    double        varRedCost;
    double        timeLimit;
+   DecompVarList candVars;
    DecompVarList::iterator it;
    //  assert(!m_masterSI->isProvenPrimalInfeasible());
 
@@ -4788,12 +5350,33 @@ int DecompAlgo::generateVars(DecompVarList&     newVars,
 
    //vector<double>       mostNegRCvec(m_numConvexCon, m_infinity);
    vector<double>       mostNegRCvec(m_numConvexCon, 0);
+   vector<double>       blockTime(m_numConvexCon, -1.0);//< 0: not solved
    DecompSolverResult   solveResult(m_infinity);
 
+   if (static_cast<int>(m_subProbSolveTime.size()) != m_numConvexCon) {
+      m_subProbSolveTime.assign(m_numConvexCon, 0.0);
+   }
+
+   m_subProbIsExact.assign(m_numConvexCon, 0);
+
    //---
    //--- solve min{ (c - u.A'')x - alpha |  x in F'}
    //---
-   if (doAllBlocks) {
+   if (doAllBlocks                         &&
+         m_param.SubProbAsyncBlockLimit > 0  &&
+         m_phase == PHASE_PRICE2             &&
+         m_numConvexCon > 1                  &&
+         m_modelRelaxNest.empty()) {
+      //---
+      //--- if the async round stopped before pricing every block,
+      //---   this was a partial round (no valid update to the LB)
+      //---
+      if (!generateVarsAsync(u, redCostX, origObjective,
+                             nBaseCoreRows, nCoreCols,
+                             potentialVars, mostNegRCvec, blockTime)) {
+         m_rrIterSinceAll = 1;
+      }
+   } else if (doAllBlocks) {
 #ifdef _OPENMP
       UTIL_DEBUG(m_app->m_param.LogDebugLevel, 3,
 		 (*m_osLog)
@@ -4860,8 +5443,8 @@ int DecompAlgo::generateVars(DecompVarList&     newVars,
 		    << subModel.getModelName() << endl;);
 #endif
 	 
-	 timeLimit = max(m_param.SubProbTimeLimitExact - 
-			 m_stats.timerOverall.getRealTime(), 0.0);
+	 double timeStart = m_stats.timerOverall.getRealTime();
+	 timeLimit = max(m_param.SubProbTimeLimitExact - timeStart, 0.0);
 	 solveRelaxed(redCostX,
 		      origObjective,
 		      alpha,
@@ -4871,6 +5454,9 @@ int DecompAlgo::generateVars(DecompVarList&     newVars,
 		      &solveResult,
 		      potentialVarsT[subprobIndex],
 		      timeLimit);
+	 blockTime[subprobIndex] = m_stats.timerOverall.getRealTime()
+	                           - timeStart;
+	 m_subProbSolveTime[subprobIndex] = blockTime[subprobIndex];
 	 if (solveResult.m_isCutoff) {
 	    mostNegRCvec[subprobIndex] = min(mostNegRCvec[subprobIndex], 0.0);
 	 }
@@ -4966,6 +5552,12 @@ int DecompAlgo::generateVars(DecompVarList&     newVars,
       map<int, vector<double> > userDualsByBlock;
       m_app->solveRelaxedWhich(blocksToSolve,
                                userDualsByBlock);
+
+      if (blocksToSolve.empty() &&
+            m_param.RoundRobinStrategy == RoundRobinAdaptive) {
+         selectPricingBlocks(blocksToSolve);
+      }
+
       UTIL_MSG(m_app->m_param.LogDebugLevel, 3,
                (*m_osLog) << "Blocks to solve: ";
                UtilPrintVector(blocksToSolve, m_osLog);
@@ -4987,7 +5579,8 @@ int DecompAlgo::generateVars(DecompVarList&     newVars,
          //---
          //--- get the OSI objet
          //---
-         DecompSubModel& subModel = (*mit).second;
+         DecompSubModel& subModel  = (*mit).second;
+         double           timeStart = m_stats.timerOverall.getRealTime();
          //---
          //--- did the user provide a specific dual for this block
          //---
@@ -5072,8 +5665,15 @@ int DecompAlgo::generateVars(DecompVarList&     newVars,
 			 timeLimit);
             UTIL_DELARR(redCostXb);
             UTIL_DELARR(uBlockAdj);
+            //---
+            //--- priced at the user's duals, not u (no cached value)
+            //---
+            m_subProbIsExact[b] = 0;
          }
 
+         blockTime[b] = m_stats.timerOverall.getRealTime() - timeStart;
+         m_subProbSolveTime[b] = blockTime[b];
+
          if (solveResult.m_isCutoff) {
             mostNegRCvec[b] = min(mostNegRCvec[b], 0.0);
          }
@@ -5103,7 +5703,9 @@ int DecompAlgo::generateVars(DecompVarList&     newVars,
       //--- if user provided blocks found no negRC, solve all blocks
       //---
       if (!foundNegRC) {
-         printf("no neg rc from user blocks, solve all blocks\n");
+         UTIL_MSG(m_param.LogLevel, 3,
+                  (*m_osLog)
+                  << "No neg rc from user blocks, solve all blocks.\n";);
 
          //TODO: make this a function (to solve all blocks)
          map<int, DecompSubModel>::iterator mit;
@@ -5124,8 +5726,8 @@ int DecompAlgo::generateVars(DecompVarList&     newVars,
             //--- NOTE: the variables coming back include alpha in
             //---       calculation of reduced cost
             //---
-	    timeLimit = max(m_param.SubProbTimeLimitExact - 
-			    m_stats.timerOverall.getRealTime(), 0.0);
+            double timeStart = m_stats.timerOverall.getRealTime();
+	    timeLimit = max(m_param.SubProbTimeLimitExact - timeStart, 0.0);
             solveRelaxed(redCostX,
                          origObjective,
                          alpha,
@@ -5135,6 +5737,8 @@ int DecompAlgo::generateVars(DecompVarList&     newVars,
                          &solveResult,
                          potentialVars,
 			 timeLimit);
+            blockTime[b] = m_stats.timerOverall.getRealTime() - timeStart;
+            m_subProbSolveTime[b] = blockTime[b];
 
             //if cutoff delcares infeasible, we know subprob >= 0
             //  we can use 0 as valid (but possibly weaker bound)
@@ -5249,12 +5853,25 @@ int DecompAlgo::generateVars(DecompVarList&     newVars,
          //---
          //--- the variable has neg reduced cost, push onto list
          //---
-         newVars.push_back(*it);
+         candVars.push_back(*it);
       } else {
          UTIL_DELPTR(*it);
       }
    }
 
+   updatePricingStats(blockTime, mostNegRCvec);
+   //---
+   //--- cache the exact block values, they give a valid bound even
+   //---   when only some of the blocks were priced in this round
+   //---
+   updatePricingCache(u, blockTime, mostNegRCvec);
+   m_pricingBoundValid = calcPricingCacheBound(u, m_pricingBoundRC);
+   //---
+   //--- the subproblems may return many columns per block (solution
+   //---   pools, near-optimal alternatives), keep a diverse few of them
+   //---
+   selectVarsPerBlock(candVars);
+   newVars.splice(newVars.end(), candVars);
    mostNegReducedCost = 0.0;
 
    for (b = 0; b < m_numConvexCon; b++) {
@@ -5288,156 +5905,1033 @@ int DecompAlgo::generateVars(DecompVarList&     newVars,
    return static_cast<int>(newVars.size());
 }
 
-//TODO - ugh! only PC again?
 //------------------------------------------------------------------------ //
-//this seems ok for C and PC... but what when we want to do DC within C THINK
-int DecompAlgo::generateCuts(double*         xhat,
-                             DecompCutList& newCuts)
+void DecompAlgo::selectVarsPerBlock(DecompVarList& vars)
 {
-   UtilPrintFuncBegin(m_osLog, m_classTag,
-                      "generateCuts()", m_param.LogDebugLevel, 2);
-   m_stats.timerOther1.reset();
-   DecompConstraintSet*           modelCore   = m_modelCore.getModel();
-   m_app->generateCuts(xhat,
-                       newCuts);
+   const int    maxPerBlock = m_param.SubProbNumColsPerBlock;
+   const double maxCosine   = m_param.SubProbColsParallelLimit;
+
+   if (vars.size() <= 1) {
+      return;
+   }
 
    //---
-   //--- attempt to generate CGL cuts on x??
-   //--- the only way this is going to work, is if you carry
-   //--- around another OSI problem instance completely in terms of x
-   //--- only allow CGL to generate cuts on the original full formulation??
-   //--- otherwise, we'd be allowing cuts on cuts - would have to add cuts
-   //--- to master and to this version... hmmm... ughh
-   //--- for some problems, you can't have the full original formulation
-   //--- for PC you probably don't want it anyway... P' comes in from ep's
-   //--- you can just generate cuts on Q"? that cut off xhat
-   //--- but for C, you need Q' and Q"
-   //--- m_masterSI holds the problem in terms of lambda (over Q")
-   //--- m_subprobSI holds the problem in terms of x (over P')
+   //--- most negative reduced cost first (stable, so ties keep the
+   //---   order in which the solvers returned them)
    //---
-   if (m_param.CutCGL) {
-      assert(m_cutgenSI);
+   vector< pair<DecompVar*, double> > byRedCost;
+   DecompVarList::iterator it;
 
-      if (m_algo == PRICE_AND_CUT) {
-         //TODO: this could be tighter in the tree
-         double gLB = getNodeIndex() ? m_globalLB :
-                      m_nodeStats.objBest.first;
-         m_cutgenSI->setRowLower(m_cutgenObjCutInd, gLB);
-      }
+   for (it = vars.begin(); it != vars.end(); ++it) {
+      byRedCost.push_back(make_pair(*it, (*it)->getReducedCost()));
+   }
 
-      if (m_param.LogDumpModel > 1) {
-         string baseName = "cutgenProb";
+   stable_sort(byRedCost.begin(), byRedCost.end(),
+               UtilIsLessThan<DecompVar*, double>());
+   vars.clear();
+   //---
+   //--- the kept columns are indexed to check the new ones against
+   //---
+   DecompVarHashIndex keptIndex;
+   DecompVarColIndex  keptColIndex;
+   map<int, int>      nKept;
+   int                nDropped = 0;
+   vector< pair<DecompVar*, double> >::iterator vi;
 
-         if (m_isStrongBranch) {
-            baseName += "_SB";
-         }
+   for (vi = byRedCost.begin(); vi != byRedCost.end(); ++vi) {
+      DecompVar* var = vi->first;
+      int&       nB  = nKept[var->getBlockId()];
 
-         printCurrentProblem(m_cutgenSI,
-                             baseName,
-                             m_nodeStats.nodeIndex,
-                             m_nodeStats.cutCallsTotal,
-                             m_nodeStats.priceCallsTotal);
+      if ((maxPerBlock > 0 && nB >= maxPerBlock) ||
+            keptIndex.contains(var) ||
+            (maxCosine < 1.0 && keptColIndex.isParallel(var, maxCosine))) {
+         UTIL_DELPTR(var);
+         nDropped++;
+         continue;
       }
 
-      m_cgl->generateCuts(m_cutgenSI,
-                          m_masterSI,
-                          xhat,
-                          modelCore->integerVars,
-                          newCuts);
+      keptIndex.insert(var);
+      keptColIndex.insert(var);
+      vars.push_back(var);
+      nB++;
    }
 
-#if 1
+   UTIL_MSG(m_param.LogDebugLevel, 3,
+            (*m_osLog) << "selectVarsPerBlock kept= " << vars.size()
+            << " dropped= " << nDropped << endl;
+           );
+}
 
-   //do DC only if no other cuts were found or if CutDC=2
-   //  this is the case of doing for init vars
-   if ((m_param.CutDC == 1 && newCuts.size() == 0) ||
-         (m_param.CutDC == 2)) {
-      //printf("\n\n==================================== IN DECOMP\n\n");
-      DecompAlgoD D(m_app, *m_utilParam,
-                    xhat, modelCore->getNumCols());
-      //also might want to use the columns you get here for something...
-      //heur for ubs, etc..
-      //either returns a set of cuts or a decomposition, have
-      //that wrap solve()?
-      D.solveD(&newCuts);
-      //---
-      //--- copy the vars generated in passes of DC into initVars
-      //---   to warm-start DW master formulation
-      //---
-      //--- NO: this won't work because it just copies the pointers
-      //---  and these will be deleted when D scopes out - see DecompAlgo
-      //---  destructor...
-      //m_vars.insert(m_vars.begin(), D.m_vars.begin(), D.m_vars.end());
-      //---
-      //--- this moves the elements of D.m_vars to m_vars
-      //---   this is what we want since D will be deleted after this
-      //---
-      m_vars.splice(m_vars.end(), D.m_vars);
-      //printf("VARS moved into CPM object\n");
-      //printVars(m_osLog);//use this to warm start DW
-      //a hidden advantage of decomp in BC?
-      DecompSolution* bestSol = NULL;
-      vector<DecompSolution*>::iterator it;
-      double thisBound;
-      double bestBoundUB = m_nodeStats.objBest.second;
+//------------------------------------------------------------------------ //
+void DecompAlgo::updatePricingStats(const vector<double>& blockTime,
+                                    const vector<double>& mostNegRCvec)
+{
+   //---
+   //--- running averages, the recent rounds count the most
+   //---
+   const double weight = 0.5;
+   int          b;
 
-      for (it  = D.m_xhatIPFeas.begin();
-            it != D.m_xhatIPFeas.end(); ++it) {
-         thisBound = (*it)->getQuality();
-         UTIL_DEBUG(m_param.LogDebugLevel, 3,
-                    (*m_osLog) << "From DECOMP, IP Feasible with Quality =";
-                    (*m_osLog) << thisBound << endl;
-                   );
+   if (static_cast<int>(m_pricingImprove.size()) != m_numConvexCon) {
+      m_pricingImprove.assign(m_numConvexCon, 0.0);
+      m_pricingSuccess.assign(m_numConvexCon, 0.0);
+      m_pricingLastRound.assign(m_numConvexCon, -1);
+   }
 
-         if ((*it)->getQuality() <= bestBoundUB) {
-            bestBoundUB = (*it)->getQuality();
-            bestSol     = (*it);
-         }
+   for (b = 0; b < m_numConvexCon; b++) {
+      if (blockTime[b] < 0.0) {
+         continue;
       }
 
-      //need to make copy of solution, since D.m_xhatIpFeas goes out of scope
-      if (bestSol) {
-         DecompSolution* bestSolCp = new DecompSolution(*bestSol);
-         m_xhatIPFeas.push_back(bestSolCp);
-         setObjBoundIP(bestSolCp->getQuality());
-         m_xhatIPBest = bestSolCp;
-         //m_xhatIPBest->print();
+      const double improve = -min(mostNegRCvec[b], 0.0);
+      const double success =
+         mostNegRCvec[b] < -m_param.RedCostEpsilon ? 1.0 : 0.0;
+
+      if (m_pricingLastRound[b] < 0) {
+         m_pricingImprove[b] = improve;
+         m_pricingSuccess[b] = success;
+      } else {
+         m_pricingImprove[b] = weight * improve +
+                               (1.0 - weight) * m_pricingImprove[b];
+         m_pricingSuccess[b] = weight * success +
+                               (1.0 - weight) * m_pricingSuccess[b];
       }
 
-      //this could also very likely return a new gUB -
-      //  for the case when it does find a decomposition
-      //  and luckily it is feasible to original?
-      //STOP -- 6/6/08
-      //if decomp is found, then can't use currently - just looking for
-      //farkas -- if decomp is found this means that z_LP = z_DW for that
-      //relaxation??
-      // printf("D.m_stopCriteria = %s\n",
-      //     DecompAlgoStopStr[D.m_stopCriteria].c_str());
-      //who deletes this memory? better to pass in newCuts..
-      //printf("\n\n====================================OUT DECOMP\n\n");
-      //exit(1);
+      m_pricingLastRound[b] = m_pricingRound;
    }
 
-#endif
-   m_stats.thisGenCuts.push_back(m_stats.timerOther1.getRealTime());
-   UtilPrintFuncEnd(m_osLog, m_classTag,
-                    "generateCuts()", m_param.LogDebugLevel, 2);
-   return static_cast<int>(newCuts.size());
+   m_pricingRound++;
+}
+
+//------------------------------------------------------------------------ //
+void DecompAlgo::clearPricingCache()
+{
+   m_blockZ.clear();
+   m_blockZDualsId.clear();
+   m_blockZDuals.clear();
+   m_blockRangeNumRows = -1;
+   m_pricingBoundValid = false;
 }
 
+//------------------------------------------------------------------------ //
+void DecompAlgo::updateBlockRowRange()
+{
+   //---
+   //--- lo[r] <= (A''s)_r <= hi[r] over lb <= s <= ub (the column bounds
+   //---   of the block model, which are valid for the whole node),
+   //---   infinite bounds are kept as -/+m_infinity
+   //---
+   DecompConstraintSet*         modelCore = m_modelCore.getModel();
+   const int                    nBaseRows = modelCore->nBaseRows;
+   updateCoreByCol();
+   const int                    nRows     = m_coreByCol.getNumRows();
+   const CoinBigIndex*          colBeg    = m_coreByCol.getVectorStarts();
+   const int*                   colLen    = m_coreByCol.getVectorLengths();
+   const int*                   colInd    = m_coreByCol.getIndices();
+   const double*                colEls    = m_coreByCol.getElements();
+   vector<double>               lo(nRows, 0.0);
+   vector<double>               hi(nRows, 0.0);
+   vector<char>                 mark(nRows, 0);
+   vector<int>                  touched;
+   map<int, DecompSubModel>::iterator mit;
+   int                          b, i, j, k, r;
+   m_blockRangeRows.assign(m_numConvexCon, vector<int>());
+   m_blockRangeLo.assign(m_numConvexCon, vector<double>());
+   m_blockRangeHi.assign(m_numConvexCon, vector<double>());
+   m_blockRangeOk.assign(m_numConvexCon, 0);
+
+   for (mit = m_modelRelax.begin(); mit != m_modelRelax.end(); ++mit) {
+      DecompConstraintSet* model = mit->second.getModel();
+      b = mit->second.getBlockId();
 
+      //---
+      //--- a block with no model (or no columns) has no valid range,
+      //---   its cached bound can not be reused
+      //---
+      if (!model || !model->M || b < 0 || b >= m_numConvexCon) {
+         continue;
+      }
 
+      const bool         isSparse = model->isSparse();
+      const vector<int>& cols     = isSparse ? model->m_sparseToOrig :
+                                    model->getActiveColumns();
+      const int          nCols    = cols.empty() ? model->getNumCols() :
+                                    static_cast<int>(cols.size());
 
+      if (nCols <= 0) {
+         continue;
+      }
 
+      touched.clear();
 
+      for (i = 0; i < nCols; i++) {
+         //---
+         //--- i is the index in the block model, j in the core
+         //---
+         j = cols.empty() ? i : cols[i];
+         const int    ib   = isSparse ? i : j;
+         const double lb   = model->colLB[ib];
+         const double ub   = model->colUB[ib];
+         const bool   lbInf = lb <= -m_infinity;
+         const bool   ubInf = ub >=  m_infinity;
+
+         for (k = colBeg[j]; k < colBeg[j] + colLen[j]; k++) {
+            r = colInd[k];
+            const double a = colEls[k];
+
+            if (!mark[r]) {
+               mark[r] = 1;
+               lo[r]   = 0.0;
+               hi[r]   = 0.0;
+               touched.push_back(r);
+            }
 
+            if (lo[r] > -m_infinity) {
+               lo[r] = (a > 0.0 ? lbInf : ubInf) ? -m_infinity :
+                       lo[r] + a * (a > 0.0 ? lb : ub);
+            }
 
-//------------------------------------------------------------------------- //
-//member of varpool versus algo class? different for DC??
-void DecompAlgo::addVarsToPool(DecompVarList& newVars)
+            if (hi[r] < m_infinity) {
+               hi[r] = (a > 0.0 ? ubInf : lbInf) ? m_infinity :
+                       hi[r] + a * (a > 0.0 ? ub : lb);
+            }
+         }
+      }
+
+      vector<int>&    rows  = m_blockRangeRows[b];
+      vector<double>& rowLo = m_blockRangeLo[b];
+      vector<double>& rowHi = m_blockRangeHi[b];
+      rows.reserve(touched.size());
+      rowLo.reserve(touched.size());
+      rowHi.reserve(touched.size());
+
+      for (i = 0; i < static_cast<int>(touched.size()); i++) {
+         r       = touched[i];
+         mark[r] = 0;
+         //---
+         //--- store the master row index (skip the convexity rows)
+         //---
+         rows.push_back(r < nBaseRows ? r : r + m_numConvexCon);
+         rowLo.push_back(lo[r]);
+         rowHi.push_back(hi[r]);
+      }
+
+      m_blockRangeOk[b] = 1;
+   }
+
+   m_blockRangeNumRows = nRows;
+}
+
+//------------------------------------------------------------------------ //
+void DecompAlgo::updatePricingCache(const double*         u,
+                                    const vector<double>& blockTime,
+                                    const vector<double>& mostNegRCvec)
+{
+   //---
+   //--- the subproblem objective is c - uA'' in Phase II only
+   //---
+   if (m_phase != PHASE_PRICE2) {
+      clearPricingCache();
+      return;
+   }
+
+   DecompConstraintSet* modelCore = m_modelCore.getModel();
+   const int            nBaseRows = modelCore->nBaseRows;
+   const int            nRows     = m_masterSI->getNumRows();
+   int                  b, id     = -1;
+
+   if (static_cast<int>(m_blockZ.size()) != m_numConvexCon) {
+      m_blockZ.assign(m_numConvexCon, -m_infinity);
+      m_blockZDualsId.assign(m_numConvexCon, -1);
+      m_blockZDuals.clear();
+   }
+
+   for (b = 0; b < m_numConvexCon; b++) {
+      if (blockTime[b] < 0.0 || !m_subProbIsExact[b]) {
+         continue;
+      }
+
+      if (id < 0) {
+         id = static_cast<int>(m_blockZDuals.size());
+         m_blockZDuals.push_back(vector<double>(u, u + nRows));
+      }
+
+      //---
+      //--- mostNegRCvec[b] = min(0, min rc) <= min{(c - uA'')s} - alpha
+      //---
+      m_blockZ[b]        = mostNegRCvec[b] + u[nBaseRows + b];
+      m_blockZDualsId[b] = id;
+   }
+
+   if (id < 0) {
+      return;
+   }
+
+   //---
+   //--- drop the dual vectors no block refers to anymore
+   //---
+   const int   nDuals = static_cast<int>(m_blockZDuals.size());
+   vector<int> newId(nDuals, -1);
+   int         nKeep  = 0;
+
+   for (b = 0; b < m_numConvexCon; b++) {
+      if (m_blockZDualsId[b] >= 0) {
+         newId[m_blockZDualsId[b]] = 0;
+      }
+   }
+
+   for (int k = 0; k < nDuals; k++) {
+      if (newId[k] < 0) {
+         continue;
+      }
+
+      if (nKeep != k) {
+         m_blockZDuals[nKeep].swap(m_blockZDuals[k]);
+      }
+
+      newId[k] = nKeep++;
+   }
+
+   m_blockZDuals.resize(nKeep);
+
+   for (b = 0; b < m_numConvexCon; b++) {
+      if (m_blockZDualsId[b] >= 0) {
+         m_blockZDualsId[b] = newId[m_blockZDualsId[b]];
+      }
+   }
+}
+
+//------------------------------------------------------------------------ //
+bool DecompAlgo::calcPricingCacheBound(const double* u,
+                                       double&       mostNegRC)
+{
+   //---
+   //--- also valid once the node is done, if it ended in Phase II
+   //---
+   const DecompPhase phase = m_phase == PHASE_DONE ? m_phaseLast : m_phase;
+
+   if (phase != PHASE_PRICE2 ||
+         static_cast<int>(m_blockZ.size()) != m_numConvexCon) {
+      return false;
+   }
+
+   DecompConstraintSet* modelCore = m_modelCore.getModel();
+   const int            nBaseRows = modelCore->nBaseRows;
+   const int            nRows     = m_masterSI->getNumRows();
+   int                  b, k, r;
+
+   if (m_blockRangeNumRows != modelCore->getNumRows()) {
+      updateBlockRowRange();
+   }
+
+   mostNegRC = 0.0;
+
+   for (b = 0; b < m_numConvexCon; b++) {
+      if (m_blockZDualsId[b] < 0 || !m_blockRangeOk[b]) {
+         return false;
+      }
+
+      //---
+      //--- rows added since (cuts) had dual 0 in v
+      //---
+      const vector<double>& v     = m_blockZDuals[m_blockZDualsId[b]];
+      const vector<int>&    rows  = m_blockRangeRows[b];
+      const vector<double>& rowLo = m_blockRangeLo[b];
+      const vector<double>& rowHi = m_blockRangeHi[b];
+      const int             nV    = static_cast<int>(v.size());
+      double                z     = m_blockZ[b];
+
+      if (nV > nRows) {
+         return false;
+      }
+
+      for (k = 0; k < static_cast<int>(rows.size()); k++) {
+         r = rows[k];
+         const double d  = u[r] - (r < nV ? v[r] : 0.0);
+
+         if (d == 0.0) {
+            continue;
+         }
+
+         //---
+         //--- max{d * (A''s)_r} over lo <= (A''s)_r <= hi
+         //---
+         const double bd = d > 0.0 ? rowHi[k] : rowLo[k];
+
+         if (bd <= -m_infinity || bd >= m_infinity) {
+            return false;
+         }
+
+         z -= d * bd;
+      }
+
+      mostNegRC += min(z - u[nBaseRows + b], 0.0);
+   }
+
+   return true;
+}
+
+//------------------------------------------------------------------------ //
+void DecompAlgo::selectPricingBlocks(vector<int>& blocksToSolve)
+{
+   //---
+   //--- score = expected improvement per second of a block,
+   //---   success * improvement / time, raised by the number of rounds
+   //---   since it was last priced (its history gets stale and the duals
+   //---   have moved), blocks never priced first
+   //---
+   const double minTime = 1.0e-4;
+   const int    nPick   = max(1, static_cast<int>(
+                                 ceil(m_param.RoundRobinBlockFrac *
+                                      m_numConvexCon)));
+   vector< pair<int, double> > score;
+   int b;
+
+   if (static_cast<int>(m_pricingImprove.size()) != m_numConvexCon) {
+      m_pricingImprove.assign(m_numConvexCon, 0.0);
+      m_pricingSuccess.assign(m_numConvexCon, 0.0);
+      m_pricingLastRound.assign(m_numConvexCon, -1);
+   }
+
+   for (b = 0; b < m_numConvexCon; b++) {
+      double s;
+
+      if (m_pricingLastRound[b] < 0) {
+         s = m_infinity;
+      } else {
+         const int age = m_pricingRound - m_pricingLastRound[b];
+         s = (m_pricingSuccess[b] * m_pricingImprove[b] + DecompEpsilon)
+             / max(m_subProbSolveTime[b], minTime)
+             * (1.0 + static_cast<double>(age) / nPick);
+      }
+
+      score.push_back(make_pair(b, s));
+   }
+
+   stable_sort(score.begin(), score.end(), UtilIsGreaterThan<int, double>());
+   blocksToSolve.clear();
+
+   for (b = 0; b < nPick && b < m_numConvexCon; b++) {
+      blocksToSolve.push_back(score[b].first);
+   }
+}
+
+//------------------------------------------------------------------------ //
+int DecompAlgo::generateVarsFromArchive(DecompVarList& newVars)
+{
+   //---
+   //--- the archived columns are in x-space, so their reduced cost is
+   //---   RC[s] = (c - u.A'')s - alpha, as for the subproblem columns
+   //---
+   if (m_colArchive->getNumCols() == 0 || m_status != STAT_FEASIBLE) {
+      return 0;
+   }
+
+   UtilPrintFuncBegin(m_osLog, m_classTag,
+                      "generateVarsFromArchive()", m_param.LogDebugLevel, 2);
+   int                   k;
+   DecompConstraintSet* modelCore     = m_modelCore.getModel();
+   const int             m             = m_masterSI->getNumRows();
+   const int             nCoreCols     = modelCore->getNumCols();
+   int                   nBaseCoreRows = modelCore->nBaseRows;
+   const double*         u             = getMasterDualSolution();
+   const double*         userU         = m_app->getDualForGenerateVars(u);
+   int                   nFound        = 0;
+
+   if (m_algo == DECOMP) {
+      nBaseCoreRows = nCoreCols;
+   }
+
+   if (userU) {
+      u = userU;
+   }
+
+   double* redCostX   = new double[nCoreCols];
+   double* u_adjusted = new double[m - m_numConvexCon];
+   CoinAssertHint(redCostX && u_adjusted, "Error: Out of Memory");
+   generateVarsAdjustDuals(u, u_adjusted);
+   generateVarsCalcRedCost(u_adjusted, redCostX);
+   //---
+   //--- alpha for block b is u[nBaseCoreRows + b]
+   //---
+   //--- price the whole archive in one pass, keep the (at most)
+   //---   ColArchiveMaxPerBlock best columns of each block
+   //---
+   vector<double> redCost;
+   vector<int>    slots;
+   vector<int>::const_iterator it;
+   //---
+   //--- the archive may be shared by the workers of a parallel tree search
+   //---
+#ifdef _OPENMP
+#pragma omp critical (DecompColArchive)
+#endif
+   {
+      m_colArchive->price(redCostX, u + nBaseCoreRows, redCost);
+      m_colArchive->selectBest(redCost, -m_param.RedCostEpsilon,
+                              m_param.ColArchiveMaxPerBlock, slots);
+      //---
+      //--- if branching is enforced in the subproblems, the columns must
+      //---   also satisfy the node bounds and branching rows
+      //---
+      const bool     checkBounds
+         = m_branchingImplementation == DecompBranchInSubproblem;
+      vector<double> denseS(nCoreCols, 0.0);//doesSatisfyBounds keeps it zero
+
+      for (it = slots.begin(); it != slots.end(); ++it) {
+         k = *it;
+         //---
+         //--- the same column may have been generated again since
+         //---
+         if (m_varsIndex.contains(m_colArchive->getBlockId(k),
+                                  m_colArchive->getHash(k))) {
+            m_colArchive->drop(k);
+            continue;
+         }
+
+         if (checkBounds) {
+            DecompVar* var = m_colArchive->createVar(k, redCost[k]);
+            map<int, DecompSubModel>::iterator mit
+               = m_modelRelax.find(var->getBlockId());
+            assert(mit != m_modelRelax.end());
+            const bool isFeas = var->doesSatisfyBounds(nCoreCols, &denseS[0],
+                                                       mit->second,
+                                                       m_colLBNode,
+                                                       m_colUBNode) &&
+                                doesSatisfyBranchRows(var, &denseS[0]);
+            UTIL_DELPTR(var);
+
+            if (!isFeas) {
+               continue;
+            }
+         }
+
+         newVars.push_back(m_colArchive->restore(k, redCost[k]));
+         nFound++;
+      }
+
+      UTIL_MSG(m_param.LogLevel, 3,
+               (*m_osLog) << "Column archive: cols= " << m_colArchive->getNumCols()
+               << " bytes= " << m_colArchive->getNumBytes()
+               << " restored= " << nFound
+               << " (total added= " << m_colArchive->getNumAdded()
+               << " restored= " << m_colArchive->getNumRestored()
+               << " evicted= " << m_colArchive->getNumEvicted() << ")" << endl;
+              );
+   }
+   UTIL_DELARR(redCostX);
+   UTIL_DELARR(u_adjusted);
+   UtilPrintFuncEnd(m_osLog, m_classTag,
+                    "generateVarsFromArchive()", m_param.LogDebugLevel, 2);
+   return nFound;
+}
+
+//------------------------------------------------------------------------ //
+bool DecompAlgo::generateVarsAsync(const double*   u,
+                                   const double*   redCostX,
+                                   const double*   origObjective,
+                                   const int       nBaseCoreRows,
+                                   const int       nCoreCols,
+                                   DecompVarList&  potentialVars,
+                                   vector<double>& mostNegRCvec,
+                                   vector<double>& blockTime)
+{
+   const int nBlocks    = m_numConvexCon;
+   const int blockLimit = m_param.SubProbAsyncBlockLimit;
+   int       nextPos    = 0; //next position in claim order
+   int       nSolved    = 0; //blocks finished
+   int       nNegRC     = 0; //blocks finished with a negative rc column
+   //---
+   //--- start with the first block that was not priced last time, so
+   //---   every block is priced within a few rounds
+   //---
+   vector<int>    order(nBlocks);
+   vector<double> startTime(nBlocks, -1.0); //>= 0 if in flight
+   vector<bool>   isSolved(nBlocks, false);
+
+   for (int k = 0; k < nBlocks; k++) {
+      order[k] = (m_asyncNextBlock + k) % nBlocks;
+   }
+
+   if (static_cast<int>(m_subProbSolveTime.size()) != nBlocks) {
+      m_subProbSolveTime.assign(nBlocks, 0.0);
+   }
+
+#ifdef _OPENMP
+   UTIL_DEBUG(m_app->m_param.LogDebugLevel, 3,
+              (*m_osLog)
+              << "===== START Async solve of subproblems. =====\n";);
+
+   if (m_param.SubProbParallel) {
+      omp_set_num_threads(min(m_param.NumConcurrentThreadsSubProb,
+                              m_numConvexCon));
+   } else {
+      omp_set_num_threads(1);
+   }
+
+#endif
+#pragma omp parallel
+   {
+      while (true) {
+         int b = -1;
+#pragma omp critical (DecompAsyncPricing)
+         {
+            if (nextPos < nBlocks) {
+               const int cand = order[nextPos];
+
+               if (nNegRC < blockLimit) {
+                  b = cand;
+               } else {
+                  //---
+                  //--- enough blocks have columns, but the master has to
+                  //---   wait for the blocks in flight anyway - steal the
+                  //---   next block if it is expected to finish before them
+                  //---
+                  const double now    = m_stats.timerOverall.getRealTime();
+                  double       remain = 0.0;
+
+                  for (int j = 0; j < nBlocks; j++) {
+                     if (startTime[j] >= 0.0) {
+                        remain = max(remain, m_subProbSolveTime[j] -
+                                     (now - startTime[j]));
+                     }
+                  }
+
+                  if (m_subProbSolveTime[cand] > 0.0 &&
+                        m_subProbSolveTime[cand] <= remain) {
+                     b = cand;
+                  }
+               }
+
+               if (b >= 0) {
+                  nextPos++;
+                  startTime[b] = m_stats.timerOverall.getRealTime();
+               }
+            }
+         }
+
+         if (b < 0) {
+            break;
+         }
+
+         DecompSubModel&    subModel  = getModelRelax(b);
+         double             alpha     = u[nBaseCoreRows + b];
+         DecompSolverResult solveResult(m_infinity);
+         DecompVarList      blockVars;
+         double             timeStart = m_stats.timerOverall.getRealTime();
+         double             timeLimit = max(m_param.SubProbTimeLimitExact -
+                                            timeStart, 0.0);
+#ifdef _OPENMP
+         UTIL_DEBUG(m_app->m_param.LogDebugLevel, 4,
+                    (*m_osLog)
+                    << "THREAD " <<  omp_get_thread_num() <<
+                    " solving subproblem " <<  b << "\n";);
+#endif
+         solveRelaxed(redCostX,
+                      origObjective,
+                      alpha,
+                      nCoreCols,
+                      false,//isNested
+                      subModel,
+                      &solveResult,
+                      blockVars,
+                      timeLimit);
+         bool foundNegRC = false;
+         DecompVarList::iterator it;
+
+         for (it = blockVars.begin(); it != blockVars.end(); ++it) {
+            if ((*it)->getReducedCost() < - m_param.RedCostEpsilon) {
+               foundNegRC = true;
+               break;
+            }
+         }
+
+#pragma omp critical (DecompAsyncPricing)
+         {
+            blockTime[b]          = m_stats.timerOverall.getRealTime()
+                                    - timeStart;
+            m_subProbSolveTime[b] = blockTime[b];
+            startTime[b]          = -1.0;
+            isSolved[b]           = true;
+            nSolved++;
+
+            if (foundNegRC) {
+               nNegRC++;
+            }
+
+            if (solveResult.m_isCutoff) {
+               mostNegRCvec[b] = min(mostNegRCvec[b], 0.0);
+            }
+
+            //---
+            //--- stream the columns of this block into the candidate list
+            //---
+            potentialVars.splice(potentialVars.end(), blockVars);
+         }
+      }
+   }
+
+#ifdef _OPENMP
+   UTIL_DEBUG(m_app->m_param.LogDebugLevel, 3,
+              (*m_osLog)
+              << "===== END   Async solve of subproblems. =====\n";);
+#endif
+   UTIL_MSG(m_app->m_param.LogDebugLevel, 3,
+            (*m_osLog) << "Async pricing solved " << nSolved
+            << " of " << nBlocks << " blocks, "
+            << nNegRC << " with negative rc columns.\n";);
+
+   for (int k = 0; k < nBlocks; k++) {
+      if (!isSolved[order[k]]) {
+         m_asyncNextBlock = order[k];
+         break;
+      }
+   }
+
+   return nSolved == nBlocks;
+}
+
+//TODO - ugh! only PC again?
+//------------------------------------------------------------------------ //
+//this seems ok for C and PC... but what when we want to do DC within C THINK
+int DecompAlgo::generateCuts(double*         xhat,
+                             DecompCutList& newCuts)
+{
+   UtilPrintFuncBegin(m_osLog, m_classTag,
+                      "generateCuts()", m_param.LogDebugLevel, 2);
+   m_stats.timerOther1.reset();
+   DecompConstraintSet*           modelCore   = m_modelCore.getModel();
+   m_app->generateCuts(xhat,
+                       newCuts);
+
+   //---
+   //--- attempt to generate CGL cuts on x??
+   //--- the only way this is going to work, is if you carry
+   //--- around another OSI problem instance completely in terms of x
+   //--- only allow CGL to generate cuts on the original full formulation??
+   //--- otherwise, we'd be allowing cuts on cuts - would have to add cuts
+   //--- to master and to this version... hmmm... ughh
+   //--- for some problems, you can't have the full original formulation
+   //--- for PC you probably don't want it anyway... P' comes in from ep's
+   //--- you can just generate cuts on Q"? that cut off xhat
+   //--- but for C, you need Q' and Q"
+   //--- m_masterSI holds the problem in terms of lambda (over Q")
+   //--- m_subprobSI holds the problem in terms of x (over P')
+   //---
+   if (m_param.CutCGL) {
+      assert(m_cutgenSI);
+
+      if (m_algo == PRICE_AND_CUT) {
+         //TODO: this could be tighter in the tree
+         double gLB = getNodeIndex() ? m_globalLB :
+                      m_nodeStats.objBest.first;
+         m_cutgenSI->setRowLower(m_cutgenObjCutInd, gLB);
+      }
+
+      if (m_param.LogDumpModel > 1) {
+         string baseName = "cutgenProb";
+
+         if (m_isStrongBranch) {
+            baseName += "_SB";
+         }
+
+         printCurrentProblem(m_cutgenSI,
+                             baseName,
+                             m_nodeStats.nodeIndex,
+                             m_nodeStats.cutCallsTotal,
+                             m_nodeStats.priceCallsTotal);
+      }
+
+      m_cgl->generateCuts(m_cutgenSI,
+                          m_masterSI,
+                          xhat,
+                          modelCore->integerVars,
+                          newCuts);
+   }
+
+#if 1
+
+   //do DC only if no other cuts were found or if CutDC=2
+   //  this is the case of doing for init vars
+   if ((m_param.CutDC == 1 && newCuts.size() == 0) ||
+         (m_param.CutDC == 2)) {
+      //printf("\n\n==================================== IN DECOMP\n\n");
+      DecompAlgoD D(m_app, *m_utilParam,
+                    xhat, modelCore->getNumCols());
+      //also might want to use the columns you get here for something...
+      //heur for ubs, etc..
+      //either returns a set of cuts or a decomposition, have
+      //that wrap solve()?
+      D.solveD(&newCuts);
+      //---
+      //--- copy the vars generated in passes of DC into initVars
+      //---   to warm-start DW master formulation
+      //---
+      //--- NO: this won't work because it just copies the pointers
+      //---  and these will be deleted when D scopes out - see DecompAlgo
+      //---  destructor...
+      //m_vars.insert(m_vars.begin(), D.m_vars.begin(), D.m_vars.end());
+      //---
+      //--- this moves the elements of D.m_vars to m_vars
+      //---   this is what we want since D will be deleted after this
+      //---
+      m_varsIndex.insert(D.m_vars);
+      m_varsColIndex.insert(D.m_vars);
+      m_vars.splice(m_vars.end(), D.m_vars);
+      //printf("VARS moved into CPM object\n");
+      //printVars(m_osLog);//use this to warm start DW
+      //a hidden advantage of decomp in BC?
+      DecompSolution* bestSol = NULL;
+      vector<DecompSolution*>::iterator it;
+      double thisBound;
+      double bestBoundUB = m_nodeStats.objBest.second;
+
+      for (it  = D.m_xhatIPFeas.begin();
+            it != D.m_xhatIPFeas.end(); ++it) {
+         thisBound = (*it)->getQuality();
+         UTIL_DEBUG(m_param.LogDebugLevel, 3,
+                    (*m_osLog) << "From DECOMP, IP Feasible with Quality =";
+                    (*m_osLog) << thisBound << endl;
+                   );
+
+         if ((*it)->getQuality() <= bestBoundUB) {
+            bestBoundUB = (*it)->getQuality();
+            bestSol     = (*it);
+         }
+      }
+
+      //need to make copy of solution, since D.m_xhatIpFeas goes out of scope
+      if (bestSol) {
+         DecompSolution* bestSolCp = new DecompSolution(*bestSol);
+         m_xhatIPFeas.push_back(bestSolCp);
+         setObjBoundIP(bestSolCp->getQuality());
+         m_xhatIPBest = bestSolCp;
+         //m_xhatIPBest->print();
+      }
+
+      //this could also very likely return a new gUB -
+      //  for the case when it does find a decomposition
+      //  and luckily it is feasible to original?
+      //STOP -- 6/6/08
+      //if decomp is found, then can't use currently - just looking for
+      //farkas -- if decomp is found this means that z_LP = z_DW for that
+      //relaxation??
+      // printf("D.m_stopCriteria = %s\n",
+      //     DecompAlgoStopStr[D.m_stopCriteria].c_str());
+      //who deletes this memory? better to pass in newCuts..
+      //printf("\n\n====================================OUT DECOMP\n\n");
+      //exit(1);
+   }
+
+#endif
+   m_stats.thisGenCuts.push_back(m_stats.timerOther1.getRealTime());
+   UtilPrintFuncEnd(m_osLog, m_classTag,
+                    "generateCuts()", m_param.LogDebugLevel, 2);
+   return static_cast<int>(newCuts.size());
+}
+
+
+
+
+
+
+
+
+//------------------------------------------------------------------------- //
+void DecompAlgo::updateCoreByCol()
+{
+   DecompConstraintSet* modelCore = m_modelCore.getModel();
+   const CoinPackedMatrix* M       = modelCore->M;
+   const int               nRows   = M->getNumRows();
+   const int               nRowsBy = m_coreByCol.getNumRows();
+
+   if (nRowsBy == nRows && m_coreByCol.getNumCols() == M->getNumCols()) {
+      return;
+   }
+
+   if (nRowsBy == 0 || nRowsBy > nRows ||
+         m_coreByCol.getNumCols() != M->getNumCols()) {
+      //---
+      //--- first call (or the core has been reset), copy it all
+      //---
+      if (M->isColOrdered()) {
+         m_coreByCol = *M;
+      } else {
+         m_coreByCol.reverseOrderedCopyOf(*M);
+      }
+   } else {
+      //---
+      //--- append the rows added (branching rows, cuts) since last call
+      //---
+      assert(!M->isColOrdered());
+      vector<CoinShallowPackedVector>    rows;
+      vector<const CoinPackedVectorBase*> rowPtrs;
+      int r;
+
+      for (r = nRowsBy; r < nRows; r++) {
+         rows.push_back(M->getVector(r));
+      }
+
+      for (r = 0; r < nRows - nRowsBy; r++) {
+         rowPtrs.push_back(&rows[r]);
+      }
+
+      m_coreByCol.appendRows(nRows - nRowsBy, &rowPtrs[0]);
+   }
+
+   m_masterColWork.assign(nRows, 0.0);
+   m_masterColMark.assign(nRows, 0);
+   m_masterColRows.clear();
+   m_masterColRows.reserve(nRows);
+}
+
+//------------------------------------------------------------------------- //
+CoinPackedVector* DecompAlgo::createMasterCol(DecompVar* var)
+{
+   int                   blockIndex = var->getBlockId();
+   CoinPackedVector*     sparseCol  = NULL;
+   DecompConstraintSet* modelCore  = m_modelCore.getModel();
+
+   if (m_algo == DECOMP) {
+      sparseCol  = new CoinPackedVector(var->m_s);
+      UTIL_DEBUG(m_app->m_param.LogDebugLevel, 5,
+                 (*m_osLog) << "\nPRINT m_s\n";
+                 UtilPrintPackedVector(var->m_s);
+                );
+      //add in convexity constraint
+      sparseCol->insert(modelCore->getNumCols() + blockIndex, 1.0);
+      UTIL_DEBUG(m_app->m_param.LogDebugLevel, 5,
+                 (*m_osLog) << "\nPRINT sparseCol\n";
+                 UtilPrintPackedVector(*sparseCol);
+                );
+      return sparseCol;
+   }
+
+   //---
+   //--- modelCore->M = A'' + branch-rows + new cuts
+   //---    here, we calculate M.s (where s is a var in x-space) as
+   //---    sum{j in support(s)} s[j] M[.,j], using the column-ordered
+   //---    copy of M and a sparse accumulator, so the work is the number
+   //---    of nonzeros in those columns (not the dimension of the master)
+   //---
+   assert(m_coreByCol.getNumRows() == modelCore->getNumRows());
+   const int           sLen    = var->m_s.getNumElements();
+   const int*          sInd    = var->m_s.getIndices();
+   const double*       sEls    = var->m_s.getElements();
+   const CoinBigIndex* colBeg  = m_coreByCol.getVectorStarts();
+   const int*          colLen  = m_coreByCol.getVectorLengths();
+   const int*          rowInd  = m_coreByCol.getIndices();
+   const double*       rowEls  = m_coreByCol.getElements();
+   double*             work    = &m_masterColWork[0];
+   char*               mark    = &m_masterColMark[0];
+   int                 i, r;
+   CoinBigIndex        k;
+   m_masterColRows.clear();
+
+   for (i = 0; i < sLen; i++) {
+      const int          j    = sInd[i];
+      const double       sj   = sEls[i];
+      const CoinBigIndex kEnd = colBeg[j] + colLen[j];
+
+      for (k = colBeg[j]; k < kEnd; k++) {
+         r = rowInd[k];
+
+         if (!mark[r]) {
+            mark[r] = 1;
+            m_masterColRows.push_back(r);
+         }
+
+         work[r] += rowEls[k] * sj;
+      }
+   }
+
+   sort(m_masterColRows.begin(), m_masterColRows.end());
+   //---
+   //--- the master column is missing the convexity constraints, which
+   //---   are in the master just after A'' (before any cuts were added)
+   //---
+   //---   r[0],   r[1],  ..., r[m''-1],
+   //---   cut[0], cut[1], ... cut[ncuts-1]
+   //---      -->
+   //---   r[0],    r[1],    ..., r[m''-1],
+   //---   conv[0], conv[1], ..., conv[b-1],
+   //---   cut[0],  cut[1],  ...  cut[ncuts-1]
+   //---
+   //--- since the convexity constraints are just sum{} lambda = 1
+   //---   there is exactly one entry 1.0, in the convexity row of the
+   //---   block (none for a ray)
+   //---
+   const int  convexity_index = modelCore->nBaseRows;
+   const int  nTouched        = static_cast<int>(m_masterColRows.size());
+   const bool isPoint         = var->getVarType() != DecompVar_Ray;
+   assert(m_masterRowType[convexity_index] == DecompRow_Convex);
+   assert(m_masterSI->getNumRows() ==
+          modelCore->getNumRows() + m_numConvexCon);
+   assert(blockIndex >= 0 && blockIndex < m_numConvexCon);
+   vector<int>    colInd;
+   vector<double> colEls;
+   colInd.reserve(nTouched + 1);
+   colEls.reserve(nTouched + 1);
+
+   for (i = 0; i < nTouched; i++) {
+      r = m_masterColRows[i];
+
+      if (r >= convexity_index && (i == 0 ||
+                                   m_masterColRows[i - 1] < convexity_index)) {
+         if (isPoint) {
+            colInd.push_back(convexity_index + blockIndex);
+            colEls.push_back(1.0);
+         }
+      }
+
+      const double v = work[r];
+      work[r] = 0.0;
+      mark[r] = 0;
+
+      if (!UtilIsZero(v, m_app->m_param.TolZero)) {
+         colInd.push_back(r < convexity_index ? r : r + m_numConvexCon);
+         colEls.push_back(v);
+      }
+   }
+
+   if (isPoint &&
+         (nTouched == 0 || m_masterColRows[nTouched - 1] < convexity_index)) {
+      colInd.push_back(convexity_index + blockIndex);
+      colEls.push_back(1.0);
+   }
+
+   sparseCol = new CoinPackedVector(static_cast<int>(colInd.size()),
+                                    colInd.empty() ? 0 : &colInd[0],
+                                    colEls.empty() ? 0 : &colEls[0]);
+   CoinAssertHint(sparseCol, "Error: Out of Memory");
+   UTIL_DEBUG(m_app->m_param.LogDebugLevel, 5,
+              (*m_osLog) << "\nPRINT sparseCol\n";
+              UtilPrintPackedVector(*sparseCol);
+             );
+   return sparseCol;
+}
+
+//------------------------------------------------------------------------- //
+void DecompAlgo::createMasterCols(const DecompVarList&        vars,
+                                  vector<CoinPackedVector*>& cols)
+{
+   DecompVarList::const_iterator li;
+   cols.clear();
+   cols.reserve(vars.size());
+
+   if (m_algo != DECOMP) {
+      updateCoreByCol();
+   }
+
+   for (li = vars.begin(); li != vars.end(); ++li) {
+      cols.push_back(createMasterCol(*li));
+   }
+}
+
+//------------------------------------------------------------------------- //
+//member of varpool versus algo class? different for DC??
+void DecompAlgo::addVarsToPool(DecompVarList& newVars)
 {
-   int                   blockIndex;
-   double*               denseCol  = NULL;
    CoinPackedVector*     sparseCol = NULL;
    DecompConstraintSet* modelCore = m_modelCore.getModel();
    UtilPrintFuncBegin(m_osLog, m_classTag,
@@ -5460,9 +6954,14 @@ void DecompAlgo::addVarsToPool(DecompVarList& newVars)
       assert((getNumRowType(DecompRow_Original) +
               getNumRowType(DecompRow_Branch)   +
               getNumRowType(DecompRow_Cut)) == modelCore->getNumRows());
-      denseCol = new double[modelCore->getNumRows() + m_numConvexCon];
    }
 
+   //---
+   //--- get the master columns = A''s, with the convexity constraint
+   //---
+   vector<CoinPackedVector*> sparseCols;
+   createMasterCols(newVars, sparseCols);
+
    //---
    //--- is it ok to purge vars that are parallel?
    //---   just make sure at least one gets thru so process can continue
@@ -5475,128 +6974,18 @@ void DecompAlgo::addVarsToPool(DecompVarList& newVars)
    //---   then, we accept the first two, even though should not have
    //---
    bool foundGoodCol = false;
+   int  index        = 0;
    DecompVarList::iterator li;
 
-   for (li = newVars.begin(); li != newVars.end(); ++li) {
-      //---
-      //--- get dense column = A''s, append convexity constraint on end
-      //---    THINK: PC specific
-      //---
-      //TODO - fix this derive method for decomp
-      if (m_algo == DECOMP) {
-         blockIndex = (*li)->getBlockId();
-         sparseCol  = new CoinPackedVector((*li)->m_s);
-         UTIL_DEBUG(m_app->m_param.LogDebugLevel, 5,
-                    (*m_osLog) << "\nPRINT m_s\n";
-                    UtilPrintPackedVector((*li)->m_s);
-                   );
-         //add in convexity constraint
-         sparseCol->insert(modelCore->getNumCols() + blockIndex, 1.0);
-         UTIL_DEBUG(m_app->m_param.LogDebugLevel, 5,
-                    (*m_osLog) << "\nPRINT sparseCol\n";
-                    UtilPrintPackedVector(*sparseCol);
-                   );
-      } else {
-         //---
-         //--- this creates a dense array of the column (in x-space)
-         //---  it is stored as a sparse vector, so we have translate
-         //---  it to do the matrix multiply
-         //---
-         //--- we put the dense array into the mem pool at dblArrNCoreCols
-         //---
-         (*li)->fillDenseArr(modelCore->getNumCols(),
-                             m_memPool.dblArrNCoreCols);
-         //---
-         //--- modelCore->M = A'' + branch-rows + new cuts
-         //---    here, we caculate M.s (where s is a var in x-space)
-         //---
-         modelCore->M->times(m_memPool.dblArrNCoreCols, denseCol);
-         //---
-         //--- Let A'' = original rows and branching rows.
-         //---
-         //--- a dense column here gives the coefficients in the
-         //--- reformulation by [A'' + cuts] * column (in x-space)
-         //---
-         //--- dimensions:
-         //---      (m'' + ncuts x n) * (n x 1) -> (m'' + ncuts x 1)
-         //---
-         //--- but this is missing the convexity constraints, and these
-         //--- need to be in order as originally setup (after A'', but
-         //--- before cuts)
-         //---
-         //--- shift all the cuts over to make space for convexity cons
-         //---
-         //--- since the convexity constraints are just sum{} lambda = 1
-         //--- we know that there is exactly one entry 1.0 for the approriate
-         //--- convexity row (depends on block id)
-         //---
-         //---   r[0],   r[1],  ..., r[m''-1],
-         //---   cut[0], cut[1], ... cut[ncuts-1]
-         //---      -->
-         //---   r[0],    r[1],    ..., r[m''-1],
-         //---   conv[0], conv[1], ..., conv[b-1],
-         //---   cut[0],  cut[1],  ...  cut[ncuts-1]
-         //---
-         int r, b;
-         //number of rows in core (A''+cuts)
-         int mpp             = modelCore->getNumRows();
-         //number of rows in original core (before cuts: A'')
-         int convexity_index = modelCore->nBaseRows;
-         //in the master, the convexity constraints are put just
-         //   after A'' (before any cuts were added)
-         assert(m_masterRowType[convexity_index] == DecompRow_Convex);
-         assert(mpp - convexity_index == getNumRowType(DecompRow_Cut));
-         //---
-         //--- for each cut row, move it to right/down
-         //---    o=original, b=branch, x=convex, c=cut
-         //---                             0123456789012
-         //---    LP                     : oooobbbbxxccc
-         //---    Core (current denseCol): oooobbbbccc
-         //--- make room in denseCol, 0 out, then fill in for block
-         //---    nRows=13, nCuts=3, nConv=2
-         //---       r=12..10 <-- r=10..8
-         //---                             0123456789012
-         //---                           : oooobbbb..ccc
-         //---                           : oooobbbb00ccc
-         //---                           : oooobbbb10ccc
-         //---
-         int nCuts = mpp - convexity_index;
-         int nRows = m_masterSI->getNumRows();
-         assert(nRows == mpp + m_numConvexCon);
-
-         for (r = (nRows - 1); r >= (nRows - nCuts); r--) {
-            denseCol[r] = denseCol[r - m_numConvexCon];
-         }
-
-         for (b = 0; b < m_numConvexCon; b++) {
-            denseCol[convexity_index + b] = 0.0;
-         }
-
-         denseCol[convexity_index + (*li)->getBlockId()] = 1.0;
-
-         if ((*li)->getVarType() == DecompVar_Ray) {
-            denseCol[convexity_index + (*li)->getBlockId()] = 0.0;
-         }
-
-         //---
-         //--- creat a sparse column from the dense column
-         //---
-         sparseCol
-         = UtilPackedVectorFromDense(modelCore->getNumRows() +
-                                     m_numConvexCon,
-                                     denseCol, m_app->m_param.TolZero);
-         UTIL_DEBUG(m_app->m_param.LogDebugLevel, 5,
-                    (*m_osLog) << "\nPRINT sparseCol\n";
-                    UtilPrintPackedVector(*sparseCol);
-                   );
-      }//END: else(m_algo == DECOMP)
-
+   for (li = newVars.begin(); li != newVars.end(); ++li, ++index) {
+      sparseCol = sparseCols[index];
       DecompWaitingCol waitingCol(*li, sparseCol);
 
-      //TOOD: since DecompVarList does not have its own class...
-      //  this is ugly, fix this later... make a helper funciton of DecompVar?
-      //TODO: this is very expensive - use hash like in cuts
-      if (m_varpool.isDuplicate(m_vars, waitingCol)) {
+      //---
+      //--- check for duplicates (by hash) against the vars in the master
+      //---   and the vars already waiting in the pool
+      //---
+      if (m_varpool.isDuplicate(m_varsIndex, waitingCol)) {
          UTIL_DEBUG(m_app->m_param.LogDebugLevel, 3,
                     (*m_osLog) << "Duplicate variable, already in vars!!\n";
                     (*li)->print(m_infinity,
@@ -5641,7 +7030,8 @@ void DecompAlgo::addVarsToPool(DecompVarList& newVars)
       //---   cosine=1.0 means the vars are exactly parallel
       //---
       if (foundGoodCol &&
-            m_varpool.isParallel(m_vars, waitingCol, m_param.ParallelColsLimit)) {
+            m_varpool.isParallel(m_varsColIndex, waitingCol,
+                                 m_param.ParallelColsLimit)) {
          UTIL_DEBUG(m_app->m_param.LogDebugLevel, 3,
                     (*m_osLog) << "Parallel variable, already in vars.\n";
                    );
@@ -5659,46 +7049,14 @@ void DecompAlgo::addVarsToPool(DecompVarList& newVars)
       //---
       //--- passed all filters, add the column to var pool
       //---
-      m_varpool.push_back(waitingCol);
+      m_varpool.addCol(waitingCol);
       foundGoodCol = true;
    } //END: for(li = newVars.begin(); li != newVars.end(); li++)
 
    //---
-   //--- in the case of Wengtes, you might get all duplicate
-   //---    columns - if this is the case, you don't want to stop
-   //---    searching - rather, reduce alpha and repeat gen vars
-   //---
-   if (m_phase        == PHASE_PRICE2 &&
-         newVars.size() >  0            &&
-         !foundGoodCol && m_param.DualStab) {
-      m_phaseForce           = PHASE_PRICE2;
-      m_param.DualStabAlpha *= 0.90;
-
-      if (m_param.LogDebugLevel >= 2)
-         (*m_osLog) << "No vars passed doing Wengtes. Reduce alpha to "
-                    << m_param.DualStabAlpha << " and repeat." << endl;
-
-      //---
-      //--- adjust dual solution with updated stability parameter
-      //---
-      adjustMasterDualSolution();
-   } else {
-      m_phaseForce = PHASE_UNKNOWN;
-   }
-
-   //---
-   //--- if Wengtes parameter has been reduced, set it back to original
+   //--- NOTE: with dual stabilization, all the columns might be
+   //---   duplicates - the mis-price is handled by isDualStabMisprice
    //---
-   if (foundGoodCol && m_param.DualStabAlpha < m_param.DualStabAlphaOrig) {
-      m_param.DualStabAlpha = m_param.DualStabAlphaOrig;
-
-      if (m_param.LogDebugLevel >= 2)
-         (*m_osLog) << "Good column found doing Wengtes. Setting alpha back "
-                    << "to its original setting "
-                    << m_param.DualStabAlpha << "." << endl;
-   }
-
-   UTIL_DELARR(denseCol);
    UtilPrintFuncEnd(m_osLog, m_classTag,
                     "addVarsToPool()", m_param.LogDebugLevel, 2);
 }
@@ -5852,13 +7210,8 @@ void DecompAlgo::addVarsFromPool()
    //---
    //THINK is this all neccessary? just to keep memory small? or
    //doing this for some reason of efficiency?
-   for (vi = m_varpool.begin(); vi != viLast; ++vi) {
-      (*vi).deleteCol();
-      (*vi).clearVar(); //needed? dangling pointer if not
-   }
-
    //TODO: is this slow for vector? if so, maybe list is still the way to go
-   m_varpool.erase(m_varpool.begin(), viLast);
+   m_varpool.eraseCols(m_varpool.begin(), viLast);
    UTIL_DEBUG(m_app->m_param.LogDebugLevel, 10,
               (*m_osLog) << "\nVAR POOL AFTER:\n";
               m_varpool.print(m_infinity, m_osLog);
@@ -5881,6 +7234,72 @@ void DecompAlgo::addVarsFromPool()
                     "addVarsFromPool()", m_param.LogDebugLevel, 2);
 }
 
+//------------------------------------------------------------------------- //
+void DecompAlgo::addVarsToMaster(DecompVarList& newVars)
+{
+   const int n_newcols = static_cast<int>(newVars.size());
+
+   if (n_newcols == 0) {
+      return;
+   }
+
+   UtilPrintFuncBegin(m_osLog, m_classTag,
+                      "addVarsToMaster()", m_param.LogDebugLevel, 2);
+   vector<CoinPackedVector*> sparseCols;
+   createMasterCols(newVars, sparseCols);
+
+   double* clb = new double[n_newcols];
+   double* cub = new double[n_newcols];
+   double* obj = new double[n_newcols];
+   const CoinPackedVectorBase** colBlock =
+      new const CoinPackedVectorBase*[n_newcols];
+   vector<string>   colNames;
+   bool             hasNames  = m_masterSI->getColNames().size() > 0;
+   const int        colIndex0 = m_masterSI->getNumCols();
+   int              index     = 0;
+   DecompVarList::iterator li;
+
+   for (li = newVars.begin(); li != newVars.end(); ++li, ++index) {
+      DecompVar* var  = *li;
+      colBlock[index] = sparseCols[index];
+      clb[index]      = var->getLowerBound();
+      cub[index]      = var->getUpperBound();
+      obj[index]      = m_phaseLast == PHASE_PRICE1 ?
+                        0.0 : var->getOriginalCost();
+      var->setColMasterIndex(colIndex0 + index);
+      m_masterColType.push_back(DecompCol_Structural);
+
+      if (hasNames) {
+         colNames.push_back("lam(c_" + UtilIntToStr(m_colIndexUnique)
+                            + ",b_" + UtilIntToStr(var->getBlockId()) + ")");
+      }
+
+      m_colIndexUnique++;
+   }
+
+   m_masterSI->addCols(n_newcols, colBlock, clb, cub, obj);
+
+   if (hasNames) {
+      m_masterSI->setColNames(colNames, 0,
+                              static_cast<int>(colNames.size()),
+                              colIndex0);
+   }
+
+   appendVars(newVars);
+   newVars.clear();
+
+   for (index = 0; index < n_newcols; index++) {
+      UTIL_DELPTR(colBlock[index]);
+   }
+
+   UTIL_DELARR(colBlock);
+   UTIL_DELARR(clb);
+   UTIL_DELARR(cub);
+   UTIL_DELARR(obj);
+   UtilPrintFuncEnd(m_osLog, m_classTag,
+                    "addVarsToMaster()", m_param.LogDebugLevel, 2);
+}
+
 
 /*-------------------------------------------------------------------------*/
 void DecompAlgo::addCutsToPool(const double*    x,
@@ -6396,6 +7815,12 @@ void DecompAlgo::solveRelaxed(const double*         redCostX,
    }
 
    m_isColGenExact = (solverStatus == DecompSolStatOptimal);
+
+   if (!isNested && whichBlock >= 0 &&
+         whichBlock < static_cast<int>(m_subProbIsExact.size())) {
+      m_subProbIsExact[whichBlock] = (solverStatus == DecompSolStatOptimal);
+   }
+
    UTIL_DEBUG(m_param.LogDebugLevel, 4,
 	      (*m_osLog) << "m_isColGenExact = " << m_isColGenExact << endl;
 	      );
@@ -6503,6 +7928,11 @@ void DecompAlgo::solveRelaxed(const double*         redCostX,
                  (*m_osLog) << "m_isColGenExact = " << m_isColGenExact << endl;
                 );
 
+      if (!isNested && whichBlock >= 0 &&
+            whichBlock < static_cast<int>(m_subProbIsExact.size())) {
+         m_subProbIsExact[whichBlock] = solveResult->m_isOptimal;
+      }
+
       // THINK: we really don't want to force the user to create vars
       // and check rc and obj, etc... but they might know how to be smart
       // and produce more than one, etc... THINK
@@ -6526,14 +7956,11 @@ void DecompAlgo::solveRelaxed(const double*         redCostX,
 
             //std::cout << "The variable Type is " << varType << std::endl;
             if (model->isSparse()) {
-               //TODO: this can just be a vector? ever need arb access?
-               map<int, int>::const_iterator mcit;
-               const map<int, int>& sparseToOrig = model->getMapSparseToOrig();
+               const vector<int>& sparseToOrig = model->getSparseToOrig();
+               const int nColsSparse = static_cast<int>(sparseToOrig.size());
 
-               for (mcit  = sparseToOrig.begin();
-                     mcit != sparseToOrig.end(); ++mcit) {
-                  i = mcit->first;  //sparse-index
-                  c = mcit->second; //original-index
+               for (i = 0; i < nColsSparse; i++) {
+                  c = sparseToOrig[i]; //original-index (i is sparse-index)
 
                   if (!UtilIsZero(milpSolution[i], m_app->m_param.TolZero)) {
                      ind.push_back(c);
@@ -6891,7 +8318,9 @@ bool DecompAlgo::isTailoffLB(const int    changeLen,
       //---
       std::vector< std::pair<int, double> > downBranchLB,
           downBranchUB, upBranchLB, upBranchUB;
-      bool gotBranch = chooseBranchSet(downBranchLB,
+      std::vector<DecompBranchRow> downBranchRows, upBranchRows;
+      bool gotBranch = chooseBranchRows(downBranchRows, upBranchRows) ||
+                       chooseBranchSet(downBranchLB,
                                        downBranchUB,
                                        upBranchLB,
                                        upBranchUB);
@@ -48,9 +48,14 @@
 #include "DecompParam.h"
 #include "DecompStats.h"
 #include "DecompVarPool.h"
+#include "DecompColArchive.h"
+#include "DecompPseudoCost.h"
+#include "DecompBranchRow.h"
 #include "DecompCutPool.h"
 #include "DecompMemPool.h"
 #include "DecompSolution.h"
+#include "DecompConcurrent.h"
+#include "DecompMasterWarmStart.h"
 #include "DecompAlgoCGL.h"
 #include "AlpsDecompTreeNode.h"
 #include "OsiClpSolverInterface.hpp"
@@ -118,6 +123,23 @@ protected:
     */
    DecompMemPool m_memPool;
 
+   /**
+    * Column-ordered copy of the core matrix (modelCore->M), used to build
+    * master columns M.s from the support of s (see createMasterCol). Rows
+    * are only ever appended to the core, so it is kept up to date by
+    * appending the new rows.
+    */
+   CoinPackedMatrix    m_coreByCol;
+
+   /**
+    * Sparse accumulator for createMasterCol: a dense work array over the
+    * core rows (all zero between calls), the rows touched by the current
+    * column and their marks.
+    */
+   std::vector<double> m_masterColWork;
+   std::vector<int>    m_masterColRows;
+   std::vector<char>   m_masterColMark;
+
    /**
     * Stream for log file (default to stdout).
     */
@@ -169,6 +191,46 @@ protected:
    DecompVarList m_vars;
    DecompVarPool m_varpool;
 
+   /**
+    * Hash index of the variables in m_vars (for duplicate detection).
+    */
+   DecompVarHashIndex m_varsIndex;
+
+   /**
+    * Archive of the columns compressed out of the master (x-space,
+    * bounded memory). It is kept across the nodes of the tree.
+    *
+    * m_colArchive points to m_colArchiveOwn, or to the archive of
+    * another DecompAlgo working on the same tree (see shareColArchive).
+    * It is always accessed in critical section DecompColArchive.
+    */
+   DecompColArchive   m_colArchiveOwn;
+   DecompColArchive*  m_colArchive;
+
+   /**
+    * Pseudo-costs of the integer columns (x-space), learned across the
+    * nodes of the tree (see BranchRule). Like m_colArchive, m_pseudoCost
+    * may be shared (see sharePseudoCost) and is always accessed in
+    * critical section DecompPseudoCost.
+    */
+   DecompPseudoCost   m_pseudoCostOwn;
+   DecompPseudoCost*  m_pseudoCost;
+
+   /**
+    * Branching rows of the current node (see setBranchRows), and the
+    * master row index of each branching row added to the master so far
+    * (by hash). The master rows are never removed: at the nodes where
+    * they do not apply, they are relaxed to be free.
+    */
+   std::vector<DecompBranchRow> m_branchRows;
+   std::map<std::string, int>  m_branchRowIndex;
+
+   /**
+    * Inverted column index of the variables in m_vars (for parallel
+    * column detection).
+    */
+   DecompVarColIndex  m_varsColIndex;
+
    /**
     * Containers for cuts (current and pool).
     */
@@ -204,6 +266,37 @@ protected:
    int m_rrLastBlock;
    int m_rrIterSinceAll;
 
+   //for asynchronous pricing
+   int                 m_asyncNextBlock;   //block to start with next time
+   std::vector<double> m_subProbSolveTime; //last solve time per block
+
+   //for adaptive partial pricing (RoundRobinAdaptive), per block:
+   //  running averages of the improvement (-most negative reduced cost)
+   //  and of the success (a column with negative reduced cost was
+   //  found), and the last pricing round the block was solved in
+   std::vector<double> m_pricingImprove;
+   std::vector<double> m_pricingSuccess;
+   std::vector<int>    m_pricingLastRound;
+   int                 m_pricingRound;
+
+   //for a bound after partial pricing rounds, per block (Phase II, reset
+   //  at each node): whether the last solve was exact, a lower bound on
+   //  min{(c - uA'')s} from the last exact solve and the duals u it was
+   //  solved at (an index in m_blockZDuals, -1 if none), and the rows of
+   //  the master touched by the block, with bounds on A''s over the
+   //  column bounds of the block (m_blockRangeOk[b] = 0 if unknown)
+   std::vector<char>                  m_subProbIsExact;
+   std::vector<double>                m_blockZ;
+   std::vector<int>                   m_blockZDualsId;
+   std::vector< std::vector<double> > m_blockZDuals;
+   std::vector< std::vector<int> >    m_blockRangeRows;
+   std::vector< std::vector<double> > m_blockRangeLo;
+   std::vector< std::vector<double> > m_blockRangeHi;
+   std::vector<char>                  m_blockRangeOk;
+   int                                m_blockRangeNumRows;
+   bool                               m_pricingBoundValid;
+   double                             m_pricingBoundRC;
+
    //
    int m_nArtCols;
 
@@ -249,6 +342,12 @@ protected:
 
    const AlpsDecompTreeNode* m_curNode;
 
+   /**
+    * Warm start for the first master solve of the next node (not owned,
+    *   NULL if none). Set by setMasterWarmStart, consumed in processNode.
+    */
+   const DecompMasterWarmStart* m_masterWarmStart;
+
    std:: vector<int>  m_masterOnlyCols;
    /**
     *  Map from original index to master index for master-only vars.
@@ -333,6 +432,43 @@ public:
 
    virtual void postProcessBranch(DecompStatus decompStatus) {};
 
+   /**
+    * Record the current master basis and the identity of its basic
+    *   columns so that the children of the current node can start from
+    *   them. Returns NULL if there is nothing to record (caller owns the
+    *   result).
+    */
+   DecompMasterWarmStart* getMasterWarmStart() const;
+
+   /**
+    * Prepare the next processNode to start from the warm start ws,
+    *   recorded by getMasterWarmStart at the parent. The parent's basic
+    *   columns which are not in the master anymore are taken back from
+    *   the column archive now (so that setMasterBounds sees them), the
+    *   basis is set just before the first master solve. ws must live
+    *   until then. If ws was recorded by another worker, only its basic
+    *   columns are used.
+    */
+   void setMasterWarmStart(const DecompMasterWarmStart* ws);
+
+   /**
+    * Use the column archive of algo instead of this one's, e.g., for the
+    *   DecompAlgo of the threads of a parallel tree search (which work on
+    *   copies of the same application, so the x-space columns of one
+    *   are valid for the others).
+    */
+   inline void shareColArchive(DecompAlgo* algo) {
+      m_colArchive = algo->m_colArchive;
+   }
+
+   /**
+    * Use the pseudo-costs of algo instead of this one's (as for
+    *   shareColArchive).
+    */
+   inline void sharePseudoCost(DecompAlgo* algo) {
+      m_pseudoCost = algo->m_pseudoCost;
+   }
+
    /**
     * Generate initial variables for master problem (PC/DC/RC).
     *   - in CPM, this does nothing
@@ -356,10 +492,12 @@ public:
                             DecompStatus& status);
 
    /**
-    * Run the initial phase for processing node.
+    * Run the initial phase for processing node. A node processed by an
+    * algorithm which has not yet processed any (e.g., a worker of a
+    * parallel tree search) starts from phase I, as the root.
     */
    virtual void phaseInit(DecompPhase& phase) {
-      if (getNodeIndex() == 0) {
+      if (getNodeIndex() == 0 || phase == PHASE_UNKNOWN) {
          phase = PHASE_PRICE1;
       }
    }
@@ -374,6 +512,37 @@ public:
     */
    virtual bool updateObjBound(const double mostNegRC = -DecompBigNum);
 
+   /**
+    * Lagrangian bound at the duals u, which need not be the duals of the
+    * master (e.g., stabilized duals). mostNegRC is the sum over the blocks
+    * of the best (nonpositive) reduced cost at u. Returns -m_infinity if
+    * u is not dual feasible.
+    */
+   double calcLagrangianBound(const double* u,
+                              const double  mostNegRC);
+
+   /**
+    * True if some artificial column is positive in the master solution
+    * (in Phase II, only when the duals are stabilized with a box).
+    */
+   bool isMasterArtPositive() const;
+
+   /**
+    * Reduced cost fixing of integer column j, whose term in the
+    *   Lagrangian bound is min{rc * lb, rc * ub} and whose value in the
+    *   master is x: moving it off that bound by d raises the bound by
+    *   |rc| * d, which must stay within gap. A bound which would cut off
+    *   x is not returned.
+    */
+   void fixVarByRedCost(const int                              j,
+                        const double                           rc,
+                        const double                           x,
+                        const double                           lb,
+                        const double                           ub,
+                        const double                           gap,
+                        std::vector< std::pair<int, double> >& lbFix,
+                        std::vector< std::pair<int, double> >& ubFix);
+
 
    virtual void solveMasterAsMIP() {}
 
@@ -432,11 +601,99 @@ public:
    virtual int generateVars(DecompVarList&     newVars,
 			    double&            mostNegReducedCost);
 
+   /**
+    * Price the column archive with the current duals. The archived
+    *   columns with negative reduced cost (which satisfy the node bounds
+    *   and are not already in the master) are taken out of the archive
+    *   and returned in newVars. No subproblem is solved, so this gives
+    *   no update to the bound.
+    */
+   int generateVarsFromArchive(DecompVarList& newVars);
+
+   /**
+    * Filter the columns (with negative reduced cost) of one pricing
+    *   round: per block, keep the SubProbNumColsPerBlock most negative,
+    *   skipping duplicates and columns nearly parallel to one already
+    *   kept (SubProbColsParallelLimit). The others are deleted.
+    */
+   void selectVarsPerBlock(DecompVarList& vars);
+
+   /**
+    * Adaptive partial pricing: pick the blocks to price in a round that
+    *   is not a full pass, by expected improvement per second.
+    */
+   void selectPricingBlocks(std::vector<int>& blocksToSolve);
+
+   /**
+    * Update the pricing history of the blocks solved in this round
+    *   (blockTime[b] >= 0), with their most negative reduced cost.
+    */
+   void updatePricingStats(const std::vector<double>& blockTime,
+                           const std::vector<double>& mostNegRCvec);
+
+   /**
+    * Cache the pricing results of the blocks solved exactly in this round
+    *   (blockTime[b] >= 0), at the duals u.
+    */
+   void updatePricingCache(const double*              u,
+                           const std::vector<double>& blockTime,
+                           const std::vector<double>& mostNegRCvec);
+
+   /**
+    * Sum over the blocks of a lower bound on the (nonpositive) best reduced
+    *   cost at the duals u, from the pricing cache: for block b, cached at
+    *   duals v, min{(c - uA'')s} >= z_b(v) - max{(u - v)A''s}. Returns
+    *   false if some block has no bound.
+    */
+   bool calcPricingCacheBound(const double* u,
+                              double&       mostNegRC);
+
+   /**
+    * Recompute the bounds on A''s for each block (m_blockRange*).
+    */
+   void updateBlockRowRange();
+
+   /**
+    * Forget the pricing cache (new node or objective).
+    */
+   void clearPricingCache();
+
    virtual int generateCuts(double*         xhat,
                             DecompCutList& newCuts);
 
    virtual void addVarsToPool(DecompVarList& newVars);
    virtual void addVarsFromPool();
+
+   /**
+    * Bring m_coreByCol up to date with the core matrix (append the rows
+    *   added since the last call).
+    */
+   void updateCoreByCol();
+
+   /**
+    * Build the master column of var: (A'' + cuts) s, with the convexity
+    *   row of its block. The work is proportional to the nonzeros of the
+    *   core columns in the support of s. Assumes updateCoreByCol() has
+    *   been called since the last change to the core.
+    */
+   CoinPackedVector* createMasterCol(DecompVar* var);
+
+   /**
+    * Build the master columns of vars (in order), see createMasterCol.
+    */
+   void createMasterCols(const DecompVarList&             vars,
+                         std::vector<CoinPackedVector*>& cols);
+
+   /**
+    * Add newVars to the master directly (no pool, no pricing checks).
+    *   The vars are moved into m_vars, newVars is left empty.
+    */
+   void addVarsToMaster(DecompVarList& newVars);
+
+   /**
+    * Set the master basis from the pending warm start (if any).
+    */
+   void applyMasterWarmStart();
    virtual void addCutsToPool(const double*    x,
                               DecompCutList& newCuts,
                               int&            m_cutsThisCall);
@@ -467,15 +724,33 @@ public:
 
    inline void appendVars(DecompVar* var) {
       m_vars.push_back(var);
+      m_varsIndex.insert(var);
+      m_varsColIndex.insert(var);
    }
    inline void appendVars(DecompVarList& varList) {
       copy(varList.begin(), varList.end(), back_inserter(m_vars));
+      m_varsIndex.insert(varList);
+      m_varsColIndex.insert(varList);
    }
    virtual void setMasterBounds(const double* lbs,
                                 const double* ubs);
    virtual void setSubProbBounds(const double* lbs,
                                  const double* ubs);
 
+   /**
+    * Reduced cost fixing in original space, at the end of a node: given
+    *   the incumbent globalUB, return the bounds (index, value) which
+    *   can be tightened without cutting off a better solution. Returns
+    *   the number of bounds in lbFix and ubFix.
+    *
+    * PC: only the master-only columns (their Lagrangian term is
+    *   separable) and only when every block has a cached exact
+    *   pricing value (see calcPricingCacheBound).
+    */
+   virtual int fixVarsByRedCost(const double                           globalUB,
+                                std::vector< std::pair<int, double> >& lbFix,
+                                std::vector< std::pair<int, double> >& ubFix);
+
    //int chooseBranchVar(int    & branchedOnIndex,
    //	       double & branchedOnValue);
    virtual bool
@@ -484,6 +759,110 @@ public:
                    std::vector< std::pair<int, double> >& upBranchLb,
                    std::vector< std::pair<int, double> >& upBranchUb);
 
+   /**
+    * Choose the branching variable by pseudo-cost (BranchRule = 1) or
+    * reliability branching (BranchRule = 2). Strong branching is only
+    * done once the node is processed (m_phase is PHASE_DONE), not when
+    * processNode checks for branching candidates, and it leaves m_xhat
+    * as it found it. Returns false if there is no candidate.
+    */
+   bool chooseBranchVarPseudoCost(int&    branchedOnIndex,
+                                  double& branchedOnValue);
+
+   /**
+    * Strong branching on column j (original space) at the current node:
+    * evaluate each child for BranchStrongCandIter iterations (see
+    * evalStrongBranch) and return their bounds (m_infinity if
+    * infeasible).
+    */
+   void strongBranchVar(const int    j,
+                        const double x,
+                        const double parentLB,
+                        double&      downLB,
+                        double&      upLB);
+
+   /**
+    * Update the pseudo-cost of column j from a child which branched in
+    * direction dir (-1 down, 1 up) on the parent value x, and moved the
+    * bound from parentLB to childLB.
+    */
+   void updatePseudoCost(const int    j,
+                         const int    dir,
+                         const double x,
+                         const double parentLB,
+                         const double childLB);
+
+   /**
+    * Strong branching evaluator: process the child of node with column
+    * bounds lbs/ubs (original space) for maxIters price (PC) or cut (CPM)
+    * iterations, starting from the master basis ws (NULL: the current
+    * one), and return its bound (m_infinity if infeasible).
+    *
+    * What processNode changes is rolled back: the node bounds, phase,
+    * status, stats, m_xhat and the master basis. The columns generated
+    * stay in the master, so the child does not have to generate them
+    * again, and the IP feasible points found are kept (getXhatIPBest).
+    */
+   double evalStrongBranch(const AlpsDecompTreeNode*    node,
+                           const double*                lbs,
+                           const double*                ubs,
+                           const DecompMasterWarmStart* ws,
+                           const double                 parentLB,
+                           const double                 globalUB,
+                           const int                    maxIters);
+
+   /**
+    * Choose a branching object given as rows of x (PC only): the one of
+    * DecompApp::APPchooseBranchRows if any, else the one of
+    * BranchRowRule. Returns false if there is none (then the variables
+    * are branched on, see chooseBranchSet).
+    */
+   virtual bool chooseBranchRows(std::vector<DecompBranchRow>& downRows,
+                                 std::vector<DecompBranchRow>& upRows);
+
+   /**
+    * Ryan-Foster: the pair of set partitioning rows (r1,r2) of the core
+    * covered together by the most fractional total of the master columns.
+    * The down child has, for each block, the columns which cover both or
+    * neither (x(r1) - x(r2) = 0); the up child has the columns which
+    * cover at most one of them (x(r1) + x(r2) <= 1). These rows only hold
+    * column by column, so this needs BranchEnforceInSubProb.
+    */
+   bool chooseBranchRowsRyanFoster(std::vector<DecompBranchRow>& downRows,
+                                   std::vector<DecompBranchRow>& upRows);
+
+   /**
+    * The block whose sum of integer x's is the most fractional: the
+    * children bound that sum by its floor and by its ceiling.
+    */
+   bool chooseBranchRowsBlockSum(std::vector<DecompBranchRow>& downRows,
+                                 std::vector<DecompBranchRow>& upRows);
+
+   /**
+    * Set the branching rows of the node (original space), before its
+    * bounds are set (setMasterBounds). The rows over several blocks, and
+    * the rows of a block unless BranchEnforceInSubProb, are master rows.
+    * Otherwise, they are added to the subproblem of their block, and
+    * setMasterBounds fixes to 0 the master columns which violate them.
+    */
+   void setBranchRows(const std::vector<DecompBranchRow>& rows);
+
+   /**
+    * Add a branching row to the master (PC), the same way as a cut: a
+    *   row of the core, its reformulation (lambda) in the master, and
+    *   artificial columns (fixed to 0) for phase I. Returns its master
+    *   row index.
+    */
+   int addBranchRowToMaster(const DecompBranchRow& row);
+
+   /**
+    * Does the column of var satisfy the branching rows of its block
+    *   enforced in the subproblems? denseS (original space) must be all
+    *   zero, as for DecompVar::doesSatisfyBounds.
+    */
+   bool doesSatisfyBranchRows(const DecompVar* var,
+                              double*          denseS) const;
+
 
 
 
@@ -652,6 +1031,24 @@ public:
    void generateVarsCalcRedCost(const double* u,
                                 double*        redCostX);
 
+   /**
+    * Asynchronous pricing over all blocks (SubProbAsyncBlockLimit > 0).
+    * Threads claim blocks from a shared queue and stream the columns of
+    * each block into potentialVars as soon as it finishes. Once enough
+    * blocks have found negative reduced cost columns, no more blocks are
+    * started, except ones expected to finish before the blocks still in
+    * flight. Returns true if every block was solved (valid for the LB).
+    * The solve time of each block solved is set in blockTime.
+    */
+   bool generateVarsAsync(const double*        u,
+                          const double*        redCostX,
+                          const double*        origObjective,
+                          const int            nBaseCoreRows,
+                          const int            nCoreCols,
+                          DecompVarList&       potentialVars,
+                          std::vector<double>& mostNegRCvec,
+                          std::vector<double>& blockTime);
+
 
 
 
@@ -672,6 +1069,9 @@ public:
    inline const double* getColUBNode() const {
       return m_colUBNode;
    }
+   inline const std::vector<DecompBranchRow>& getBranchRows() const {
+      return m_branchRows;
+   }
    //inline OsiSolverInterface * getSubProbSI(int b){
    // return m_subprobSI[b];
    //}
@@ -785,6 +1185,21 @@ public:
     */
    virtual void adjustMasterDualSolution() {};
 
+   /**
+    * Dual stabilization: called after each pricing call with the columns
+    * found (before they go to the pool).
+    */
+   virtual void updateDualStab(const DecompVarList& newVars) {};
+
+   /**
+    * Dual stabilization: called after the new columns went to the pool.
+    * Returns true if the pricing call was a mis-price (no column found
+    * only because of the stabilization) and must be repeated.
+    */
+   virtual bool isDualStabMisprice() {
+      return false;
+   };
+
 
    inline double getMasterObjValue() const {
       if (!m_masterSI) {
@@ -906,12 +1321,22 @@ public:
    virtual inline void setObjBoundIP(const double thisBound) {
       UtilPrintFuncBegin(m_osLog, m_classTag,
                          "setObjBoundIP()", m_param.LogDebugLevel, 2);
+      double bestBound = thisBound;
+
+      //---
+      //--- in Concurrent mode, share this bound with the other racers
+      //---   and use the best one found by any of them as our cutoff
+      //---
+      if (m_app->m_concurrent) {
+         m_app->m_concurrent->publishUB(thisBound, m_app->m_threadIndex);
+         bestBound = std::min(bestBound, m_app->m_concurrent->getBestUB());
+      }
 
-      if (thisBound < m_nodeStats.objBest.second) {
+      if (bestBound < m_nodeStats.objBest.second) {
          UTIL_MSG(m_app->m_param.LogDebugLevel, 3,
                   (*m_osLog) << "New Global UB = "
-                  << UtilDblToStr(thisBound) << std::endl;);
-         m_nodeStats.objBest.second = thisBound;
+                  << UtilDblToStr(bestBound) << std::endl;);
+         m_nodeStats.objBest.second = bestBound;
       }
 
       //---
@@ -1036,6 +1461,10 @@ public:
       m_stats      (),
       m_nodeStats  (),
       m_memPool    (),
+      m_coreByCol  (),
+      m_masterColWork(),
+      m_masterColRows(),
+      m_masterColMark(),
       m_osLog      (&std::cout),
       m_cgl          (0),
       m_origColLB  (),
@@ -1047,6 +1476,14 @@ public:
       m_modelCore  (utilParam),	 
       m_vars       (),
       m_varpool    (),
+      m_varsIndex  (),
+      m_colArchiveOwn(),
+      m_colArchive (&m_colArchiveOwn),
+      m_pseudoCostOwn(),
+      m_pseudoCost (&m_pseudoCostOwn),
+      m_branchRows (),
+      m_branchRowIndex(),
+      m_varsColIndex(),
       m_cuts       (),
       m_cutpool    (),
       m_xhat       (0),
@@ -1057,6 +1494,23 @@ public:
       m_numConvexCon (1),
       m_rrLastBlock (-1),
       m_rrIterSinceAll(0),
+      m_asyncNextBlock(0),
+      m_subProbSolveTime(),
+      m_pricingImprove(),
+      m_pricingSuccess(),
+      m_pricingLastRound(),
+      m_pricingRound(0),
+      m_subProbIsExact(),
+      m_blockZ(),
+      m_blockZDualsId(),
+      m_blockZDuals(),
+      m_blockRangeRows(),
+      m_blockRangeLo(),
+      m_blockRangeHi(),
+      m_blockRangeOk(),
+      m_blockRangeNumRows(-1),
+      m_pricingBoundValid(false),
+      m_pricingBoundRC(0.0),
 
       m_colLBNode(NULL),
       m_colUBNode(NULL),
@@ -1065,6 +1519,8 @@ public:
       m_masterObjLast(m_infinity),
       m_firstPhase2Call(false),
       m_isStrongBranch(false),
+      m_curNode(NULL),
+      m_masterWarmStart(NULL),
       m_masterOnlyCols(),
       subProbSolvePhase(SUBSOLVE_PHASE_EXACT),
       m_branchingImplementation(DecompBranchInSubproblem)
@@ -74,6 +74,86 @@ void DecompAlgoC::setMasterBounds(const double* lbs,
                     "setMasterBounds()", m_param.LogDebugLevel, 2);
 }
 
+//===========================================================================//
+int DecompAlgoC::fixVarsByRedCost(const double                 globalUB,
+                                  vector< pair<int, double> >& lbFix,
+                                  vector< pair<int, double> >& ubFix)
+{
+   lbFix.clear();
+   ubFix.clear();
+
+   if (!m_param.RedCostFixing        ||
+         globalUB >= m_infinity       ||
+         !m_masterSI->isProvenOptimal()) {
+      return 0;
+   }
+
+   UtilPrintFuncBegin(m_osLog, m_classTag,
+                      "fixVarsByRedCost()", m_param.LogDebugLevel, 2);
+   //---
+   //--- L(u) = sum_r u_r * (u_r > 0 ? rowLB_r : rowUB_r)
+   //---      + sum_j min{rc_j * lb_j, rc_j * ub_j}
+   //---   is computed from scratch, since cuts may have been added to
+   //---   the master after its last solve (their duals are then zero)
+   //---
+   DecompConstraintSet* modelCore   = m_modelCore.getModel();
+   const char*           integerMark = modelCore->getIntegerMark();
+   const int             nRows       = m_masterSI->getNumRows();
+   const int             nCols       = m_masterSI->getNumCols();
+   const double*         u           = m_masterSI->getRowPrice();
+   const double*         x           = m_masterSI->getColSolution();
+   const double*         obj         = m_masterSI->getObjCoefficients();
+   const double*         rowLB       = m_masterSI->getRowLower();
+   const double*         rowUB       = m_masterSI->getRowUpper();
+   const double*         colLB       = m_masterSI->getColLower();
+   const double*         colUB       = m_masterSI->getColUpper();
+   vector<double>        rc(nCols);
+   double                lagBound    = 0.0;
+   double                bd;
+   int                   r, c;
+   m_masterSI->getMatrixByCol()->transposeTimes(u, &rc[0]);
+
+   for (r = 0; r < nRows; r++) {
+      bd = u[r] > 0.0 ? rowLB[r] : rowUB[r];
+
+      if (bd > -m_infinity && bd < m_infinity) {
+         lagBound += u[r] * bd;
+      } else if (fabs(u[r]) > DecompEpsilon) {
+         lagBound = -m_infinity;
+         break;
+      }
+   }
+
+   for (c = 0; c < nCols && lagBound > -m_infinity; c++) {
+      rc[c] = obj[c] - rc[c];
+      bd    = rc[c] > 0.0 ? colLB[c] : colUB[c];
+
+      if (bd > -m_infinity && bd < m_infinity) {
+         lagBound += rc[c] * bd;
+      } else if (fabs(rc[c]) > DecompEpsilon) {
+         lagBound = -m_infinity;
+      }
+   }
+
+   if (lagBound > -m_infinity && globalUB - lagBound >= 0.0) {
+      for (c = 0; c < nCols; c++) {
+         if (integerMark[c] == 'I') {
+            fixVarByRedCost(c, rc[c], x[c], colLB[c], colUB[c],
+                            globalUB - lagBound, lbFix, ubFix);
+         }
+      }
+   }
+
+   UTIL_MSG(m_param.LogDebugLevel, 3,
+            (*m_osLog) << "Reduced cost fixing: tightened "
+            << lbFix.size() << " LBs and " << ubFix.size() << " UBs"
+            << endl;
+           );
+   UtilPrintFuncEnd(m_osLog, m_classTag,
+                    "fixVarsByRedCost()", m_param.LogDebugLevel, 2);
+   return static_cast<int>(lbFix.size() + ubFix.size());
+}
+
 //===========================================================================//
 bool DecompAlgoC::updateObjBound(const double mostNegRC)
 {
@@ -84,7 +84,7 @@ private:
    bool updateObjBound(const double mostNegRC = -DecompBigNum);
 
    void phaseInit(DecompPhase& phase) {
-      if (getNodeIndex() == 0) {
+      if (getNodeIndex() == 0 || phase == PHASE_UNKNOWN) {
          phase = PHASE_CUT;
       }
    }
@@ -108,6 +108,14 @@ private:
    void setSubProbBounds(const double* lbs,
                          const double* ubs) {};
 
+   /**
+    * Reduced cost fixing (LP): the master columns are the original
+    *   columns, all integer columns are candidates.
+    */
+   int fixVarsByRedCost(const double                           globalUB,
+                        std::vector< std::pair<int, double> >& lbFix,
+                        std::vector< std::pair<int, double> >& ubFix);
+
 public:
    virtual DecompSolverResult*
    solveDirect(const DecompSolution* startSol  = NULL);
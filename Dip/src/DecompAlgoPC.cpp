@@ -40,6 +40,16 @@ void DecompAlgoPC::phaseInit(DecompPhase& phase)
    //---
    UtilPrintFuncBegin(m_osLog, m_classTag,
                       "phaseInit()", m_param.LogDebugLevel, 2);
+   //---
+   //--- reset the dual stabilization for this node
+   //---
+   m_stabAlpha       = m_param.DualStabAlpha;
+   m_stabMisprice    = 0;
+   m_stabActive      = m_param.DualStab != DualStabNone;
+   m_stabBoxOn       = false;
+   m_stabNumPrice    = 0;
+   m_stabNumCenter   = 0;
+   m_stabNumMisprice = 0;
 
    //---
    //--- set column bounds
@@ -111,7 +121,8 @@ void DecompAlgoPC::phaseInit(DecompPhase& phase)
    }
 
    if (phase != PHASE_DONE)
-      if (getNodeIndex() == 0 && !m_isStrongBranch) {
+      if ((getNodeIndex() == 0 && !m_isStrongBranch) ||
+            phase == PHASE_UNKNOWN) {
          phase = PHASE_PRICE1;
       }
 
@@ -150,7 +161,7 @@ void DecompAlgoPC::adjustMasterDualSolution()
    //---
    int            r;
    const double* u      = &m_dualSolution[0];
-   double         alpha  = m_param.DualStabAlpha;
+   double         alpha  = getDualStabAlpha();
    double         alpha1 = 1.0 - alpha;
    copy(u, u + nRows, m_dualRM.begin()); //copy for sake of debugging
 
@@ -211,6 +222,213 @@ void DecompAlgoPC::adjustMasterDualSolution()
                     "adjustMasterDualSolution()", m_param.LogDebugLevel, 2);
 }
 
+//===========================================================================//
+double DecompAlgoPC::getDualStabAlpha() const
+{
+   //---
+   //--- only smooth in Phase II (in Phase I, a mis-price would end the
+   //---   phase and declare the node infeasible); after k mis-prices in
+   //---   a row, alpha_k = 1 - (k + 1)(1 - alpha) reaches 0 (no smoothing)
+   //---   in a few steps
+   //---
+   if (!m_stabActive || m_phase != PHASE_PRICE2 ||
+         (m_param.DualStab != DualStabWentges &&
+          m_param.DualStab != DualStabInOut)) {
+      return 0.0;
+   }
+
+   return std::max<double>(0.0, 1.0 - (m_stabMisprice + 1) *
+                           (1.0 - m_stabAlpha));
+}
+
+//===========================================================================//
+void DecompAlgoPC::updateDualStab(const DecompVarList& newVars)
+{
+   if (!m_stabActive || m_phase != PHASE_PRICE2) {
+      return;
+   }
+
+   UtilPrintFuncBegin(m_osLog, m_classTag,
+                      "updateDualStab()", m_param.LogDebugLevel, 2);
+   m_stabNumPrice++;
+
+   if (m_param.DualStab == DualStabInOut &&
+         m_stabMisprice == 0 && !newVars.empty()) {
+      //---
+      //--- subgradient at the pricing duals, g = b - A''s, from the best
+      //---   column of each block which found one (blocks without a
+      //---   column and the master-only columns are left out)
+      //---
+      //--- if g points from the center towards the master duals, the
+      //---   smoothing is too strong - decrease alpha, else increase it
+      //---
+      int                               r, i;
+      const int                         nRows = m_masterSI->getNumRows();
+      const double*                     rhs   = m_masterSI->getRightHandSide();
+      map<int, DecompVar*>              best;
+      map<int, DecompVar*>::iterator    mit;
+      DecompVarList::const_iterator     li;
+      vector<double>                    g(rhs, rhs + nRows);
+
+      for (li = newVars.begin(); li != newVars.end(); ++li) {
+         mit = best.find((*li)->getBlockId());
+
+         if (mit == best.end()) {
+            best.insert(make_pair((*li)->getBlockId(), *li));
+         } else if ((*li)->getReducedCost() < mit->second->getReducedCost()) {
+            mit->second = *li;
+         }
+      }
+
+      //---
+      //--- the core may have grown (cuts, branching rows) since the
+      //---   column-wise copy was last built
+      //---
+      updateCoreByCol();
+
+      for (mit = best.begin(); mit != best.end(); ++mit) {
+         CoinPackedVector* col = createMasterCol(mit->second);
+         const int*        ind = col->getIndices();
+         const double*     els = col->getElements();
+
+         for (i = 0; i < col->getNumElements(); i++) {
+            g[ind[i]] -= els[i];
+         }
+
+         UTIL_DELPTR(col);
+      }
+
+      double dir = 0.0;
+
+      for (r = 0; r < nRows && r < static_cast<int>(m_dual.size()); r++) {
+         if (m_masterRowType[r] != DecompRow_Convex) {
+            dir += g[r] * (m_dualRM[r] - m_dual[r]);
+         }
+      }
+
+      if (dir > 0.0) {
+         m_stabAlpha = std::max<double>(0.0, m_stabAlpha - 0.1);
+      } else {
+         m_stabAlpha = std::min<double>(0.99,
+                                        m_stabAlpha + 0.1 * (1.0 - m_stabAlpha));
+      }
+
+      UTIL_DEBUG(m_param.LogDebugLevel, 3,
+                 (*m_osLog) << "In-out: g.(dualRM - center) = "
+                 << UtilDblToStr(dir) << " alpha = "
+                 << UtilDblToStr(m_stabAlpha) << endl;);
+   }
+
+   //---
+   //--- the center might have moved (see setObjBound), move the box
+   //---
+   if (m_param.DualStab == DualStabBoxStep ||
+         m_param.DualStab == DualStabPenalty) {
+      setDualStabBox(true);
+   }
+
+   UtilPrintFuncEnd(m_osLog, m_classTag,
+                    "updateDualStab()", m_param.LogDebugLevel, 2);
+}
+
+//===========================================================================//
+bool DecompAlgoPC::isDualStabMisprice()
+{
+   if (!m_stabActive || m_phase != PHASE_PRICE2) {
+      return false;
+   }
+
+   if (m_nodeStats.varsThisCall > 0) {
+      m_stabMisprice = 0;
+      return false;
+   }
+
+   const bool isBox = m_param.DualStab == DualStabBoxStep ||
+                      m_param.DualStab == DualStabPenalty;
+
+   //---
+   //--- no column at the master duals themselves (alpha = 0, or the
+   //---   box is not binding) is a true end of pricing
+   //---
+   if (isBox ? !isMasterArtPositive() : getDualStabAlpha() <= 0.0) {
+      if (m_stabBoxOn) {
+         setDualStabBox(false);
+      }
+
+      return false;
+   }
+
+   m_stabMisprice++;
+   m_stabNumMisprice++;
+
+   if (m_stabMisprice >= m_param.DualStabMaxMisprice) {
+      UTIL_MSG(m_param.LogLevel, 3,
+               (*m_osLog) << "Dual stabilization mis-priced "
+               << m_stabMisprice << " times in a row, drop it." << endl;);
+      m_stabActive = false;
+
+      if (m_stabBoxOn) {
+         setDualStabBox(false);
+      }
+   } else if (isBox) {
+      //---
+      //--- the master duals are on the border of the box, recenter it
+      //---
+      copy(m_dualST.begin(), m_dualST.end(), m_dual.begin());
+      setDualStabBox(true);
+   }
+
+   UTIL_DEBUG(m_param.LogDebugLevel, 3,
+              (*m_osLog) << "Dual stabilization mis-price, alpha = "
+              << UtilDblToStr(getDualStabAlpha()) << endl;);
+   return true;
+}
+
+//===========================================================================//
+void DecompAlgoPC::setDualStabBox(const bool on)
+{
+   //---
+   //--- the artificial column of row r has coefficient +1 (G) or -1 (L),
+   //---   its reduced cost cost - (+/-)u_r >= 0 bounds u_r by the cost:
+   //---     G: u_r <= center_r + delta_r,  L: u_r >= center_r - delta_r
+   //---   the bound on the column is the penalty for leaving the box
+   //---   (infinite for a box-step)
+   //---
+   int                     c;
+   const int               nCols = m_masterSI->getNumCols();
+   const CoinPackedMatrix* M     = m_masterSI->getMatrixByCol();
+   const double            ub    = !on ? 0.0 :
+                                   m_param.DualStab == DualStabBoxStep ?
+                                   m_infinity : m_param.DualStabBoxPenalty;
+
+   for (c = 0; c < nCols; c++) {
+      if (!isMasterColArtificial(c)                     ||
+            m_masterColType[c] == DecompCol_ArtForConvexL ||
+            m_masterColType[c] == DecompCol_ArtForConvexG) {
+         continue;
+      }
+
+      double cost = 0.0;
+
+      if (on) {
+         const CoinShallowPackedVector col = M->getVector(c);
+         assert(col.getNumElements() == 1);
+         const int    r      = col.getIndices()[0];
+         const double center = r < static_cast<int>(m_dual.size()) ?
+                               m_dual[r] : 0.0;
+         const double delta  = m_param.DualStabBoxWidth *
+                               (1.0 + fabs(center));
+         cost = col.getElements()[0] > 0.0 ?
+                center + delta : delta - center;
+      }
+
+      m_masterSI->setObjCoeff(c, cost);
+      m_masterSI->setColBounds(c, 0.0, ub);
+   }
+
+   m_stabBoxOn = on;
+}
+
 
 //===========================================================================//
 int DecompAlgoPC::adjustColumnsEffCnt()
@@ -440,10 +658,18 @@ int DecompAlgoPC::compressColumns()
                  << " currSol= " << setw(10)
                  << UtilDblToStr(masterSolution[colMasterIndex], 3) << endl;
                 );
-      //add this var to pool - THINK what exactly does that entail
+      //---
+      //--- keep a compact copy in the column archive, where it can be
+      //---   priced again (at this node or any other) before the
+      //---   subproblems are called
+      //---
       (*li)->resetEffectiveness();
-      //this deletes the var object (we won't do this
-      // once we move to pool)
+#ifdef _OPENMP
+#pragma omp critical (DecompColArchive)
+#endif
+      m_colArchive->add(*li);
+      m_varsIndex.erase(*li);
+      m_varsColIndex.erase(*li);
       delete *li;
       li = m_vars.erase(li); //removes link in list
       lpColsToDelete.push_back(colMasterIndex);
@@ -570,9 +796,33 @@ void DecompAlgoPC::phaseDone()
    UtilPrintFuncBegin(m_osLog, m_classTag,
                       "phaseDone()", m_param.LogDebugLevel, 2);
 
+   //---
+   //--- leave the master without the box (unless the node ended in
+   //---   Phase I, which set the artificial columns itself)
+   //---
+   if (m_stabBoxOn) {
+      if (m_phaseLast == PHASE_PRICE2) {
+         setDualStabBox(false);
+      }
+
+      m_stabBoxOn = false;
+   }
+
+   if (m_param.DualStab && m_stabNumPrice > 0) {
+      UTIL_MSG(m_param.LogLevel, 2,
+               (*m_osLog)
+               << "DualStab = "       << m_param.DualStab
+               << ": pricing calls = " << m_stabNumPrice
+               << " center moves = "   << m_stabNumCenter
+               << " mis-prices = "     << m_stabNumMisprice
+               << " alpha = "          << UtilDblToStr(m_stabAlpha, 3)
+               << endl;);
+   }
+
    if (m_param.SolveMasterAsMip                                &&
          getNodeIndex() % m_param.SolveMasterAsMipFreqNode == 0  &&
-         m_stopCriteria != DecompStopTime) {
+         m_stopCriteria != DecompStopTime                      &&
+         m_stopCriteria != DecompStopConcurrent) {
       solveMasterAsMIP();
    }
 
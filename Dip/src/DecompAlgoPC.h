@@ -66,6 +66,26 @@ private:
     */
    std::vector<double> m_dualST;
 
+   /**
+    * Dual stabilization state, reset at each node (see m_param.DualStab).
+    *
+    * The weight of the center m_dual in the smoothed duals (auto-adjusted
+    * for DualStabInOut), the number of mis-prices in a row, whether the
+    * stabilization is still on for this node and whether the box is set
+    * on the artificial columns of the master.
+    */
+   double m_stabAlpha;
+   int    m_stabMisprice;
+   bool   m_stabActive;
+   bool   m_stabBoxOn;
+
+   /**
+    * Dual stabilization statistics for the node (logged in phaseDone).
+    */
+   int    m_stabNumPrice;
+   int    m_stabNumCenter;
+   int    m_stabNumMisprice;
+
    /**
     * @}
     */
@@ -114,7 +134,29 @@ private:
     */
    virtual void adjustMasterDualSolution();
 
+   /**
+    * Dual stabilization: adjust alpha (DualStabInOut) and the box
+    * (DualStabBoxStep, DualStabPenalty) after a pricing call.
+    */
+   virtual void updateDualStab(const DecompVarList& newVars);
+
+   /**
+    * Dual stabilization: true if the last pricing call was a mis-price,
+    * in which case the stabilization has been weakened for the repeat.
+    */
+   virtual bool isDualStabMisprice();
 
+   /**
+    * The weight of the center in the smoothed duals for the next pricing
+    * call (0 if the duals are not smoothed).
+    */
+   double getDualStabAlpha() const;
+
+   /**
+    * Set (on) or remove (off) the box around the center, through the
+    * costs and bounds of the artificial columns of the master.
+    */
+   void setDualStabBox(const bool on);
 
    /**
     *
@@ -129,6 +171,10 @@ private:
             //(*m_osLog) << "Bound improved " << m_nodeStats.objBest.first
             //       << " to " << thisBound << " , update duals" << endl;
             copy(m_dualST.begin(), m_dualST.end(), m_dual.begin());
+
+            if (m_phase == PHASE_PRICE2) {
+               m_stabNumCenter++;
+            }
          }
       }
 
@@ -199,7 +245,14 @@ public:
                 bool             doSetup    = true,
 		const DecompAlgoType   algo = PRICE_AND_CUT) :
       DecompAlgo(algo, app, utilParam),
-      m_classTag("D-ALGOPC") {
+      m_classTag("D-ALGOPC"),
+      m_stabAlpha      (0.0),
+      m_stabMisprice   (0),
+      m_stabActive     (false),
+      m_stabBoxOn      (false),
+      m_stabNumPrice   (0),
+      m_stabNumCenter  (0),
+      m_stabNumMisprice(0) {
       //---
       //--- do any parameter overrides of the defaults here
       //---    by default turn off gomory cuts for PC
@@ -16,11 +16,15 @@
 #include "DecompAlgo.h"
 #include "DecompVar.h"
 #include "DecompConfig.h"
+#include "UtilHypergraph.h"
 #include <vector>
 #include <set>
 #include <fstream>
 #include <string>
 #include "iterator"
+#ifdef _OPENMP
+#include "omp.h"
+#endif
 //#if defined(autoDecomp) && defined(PaToH)
 
 #include <vector>
@@ -155,6 +159,13 @@ void DecompApp::initializeApp()
       if (m_param.BlockFile != ""){
 	 readBlockFile();
       }
+   } else if (m_param.HypergraphPartitioner == "Native" &&
+              !m_param.BlockFileOutput) {
+      //---
+      //--- automatic structure detection; the built-in partitioner is
+      //---   thread safe, so candidates can be partitioned in parallel
+      //---
+      singlyBorderStructureDetection();
    } else
       // automatic structure detection
    {
@@ -1008,8 +1019,7 @@ void DecompApp::createModelPartSparse(DecompConstraintSet* model,
    //---
    //--- for each row in rowsPart, create the row using sparse mapping
    //---
-   int                      i, k, r, begInd;
-   const map<int, int>&      origToSparse   = model->getMapOrigToSparse();
+   int                      i, k, r, begInd, sparseIndex;
    const CoinPackedMatrix* M              = NULL;
 
    if (m_param.InstanceFormat == "MPS") {
@@ -1036,8 +1046,6 @@ void DecompApp::createModelPartSparse(DecompConstraintSet* model,
 
    vector<double      >&    rowVal         = model->m_rowVal;//used as temp
 
-   map<int, int>::const_iterator mit;
-
    begInd = 0;
 
    rowBeg.push_back(0);
@@ -1065,10 +1073,10 @@ void DecompApp::createModelPartSparse(DecompConstraintSet* model,
       matValI = matVal + matBeg[r];
 
       for (k = 0; k < matLen[r]; k++) {
-         origIndex = matIndI[k];
-         mit       = origToSparse.find(origIndex);
-         assert(mit != origToSparse.end());
-         rowInd.push_back(mit->second);
+         origIndex   = matIndI[k];
+         sparseIndex = model->getSparseIndex(origIndex);
+         assert(sparseIndex >= 0);
+         rowInd.push_back(sparseIndex);
          rowVal.push_back(matValI[k]);
       }
 
@@ -1527,47 +1535,83 @@ void DecompApp::singlyBorderStructureDetection()
       partweights[i] = 1;
    }
 
-   // calling HMETIS_PartKway API to perform the hypergraph partitioning
+   clock_t begin = clock();
+
+   if (m_param.HypergraphPartitioner == "PaToH") {
 #ifdef PaToH
-   PaToH_Parameters args;
-   args._k = nparts;
-   //  PaToH_Initialize_Parameters(&args, PATOH_CUTPART, PATOH_SUGPARAM_QUALITY);
-   PaToH_Initialize_Parameters(&args, PATOH_CONPART,
-                               PATOH_SUGPARAM_DEFAULT);
-   // the number of constraint in the multilevel algorithm
-   int nconst = 1; // single constraint
-   PaToH_Alloc(&args, numVertices, numHyperedges, nconst,
-               vwgts, hewgts, eptr, eind);
-   int cut = 0;
-   PaToH_Part(&args, numVertices, numHyperedges, nconst , 0 , vwgts,
-              hewgts, eptr, eind, NULL, part, partweights, &cut);
-   edgecut[0] = cut ;
-   int computedCut = PaToH_Compute_Cut(nparts, PATOH_CONPART, numVertices,
-                                       numHyperedges, hewgts, eptr, eind,
-                                       part);
-   UTIL_MSG(m_param.LogDebugLevel, 2,
-            (*m_osLog)
-            << "The computedCut is "
-            << computedCut << "\n";
-           );
+      PaToH_Parameters args;
+      args._k = nparts;
+      //  PaToH_Initialize_Parameters(&args, PATOH_CUTPART, PATOH_SUGPARAM_QUALITY);
+      PaToH_Initialize_Parameters(&args, PATOH_CONPART,
+                                  PATOH_SUGPARAM_DEFAULT);
+      // the number of constraint in the multilevel algorithm
+      int nconst = 1; // single constraint
+      PaToH_Alloc(&args, numVertices, numHyperedges, nconst,
+                  vwgts, hewgts, eptr, eind);
+      int cut = 0;
+      PaToH_Part(&args, numVertices, numHyperedges, nconst , 0 , vwgts,
+                 hewgts, eptr, eind, NULL, part, partweights, &cut);
+      edgecut[0] = cut ;
+      int computedCut = PaToH_Compute_Cut(nparts, PATOH_CONPART, numVertices,
+                                          numHyperedges, hewgts, eptr, eind,
+                                          part);
+      UTIL_MSG(m_param.LogDebugLevel, 2,
+               (*m_osLog)
+               << "The computedCut is "
+               << computedCut << "\n";
+              );
 #else
-   clock_t begin = clock();
+      throw UtilException("PaToH selected as partitioner, but it's not available",
+                          "singlyBorderStructureDetection", "DecompApp");
+#endif
+   } else if (m_param.HypergraphPartitioner == "hMetis") {
 #if defined(COIN_HAS_HMETIS)
-   // maximum load imbalance (%)
-   int ubfactor = 5;
-   HMETIS_PartRecursive(numVertices, numHyperedges, vwgts, eptr,
-                        eind, hewgts, nparts, ubfactor, options, part, edgecut);
+      // maximum load imbalance (%)
+      int ubfactor = m_param.HypergraphUBFactor;
+      HMETIS_PartRecursive(numVertices, numHyperedges, vwgts, eptr,
+                           eind, hewgts, nparts, ubfactor, options, part,
+                           edgecut);
+#else
+      throw UtilException("hMetis selected as partitioner, but it's not available",
+                          "singlyBorderStructureDetection", "DecompApp");
+#endif
+   } else if (m_param.HypergraphPartitioner == "Native") {
+      //---
+      //--- the vertices are the columns (eind holds column indices)
+      //---
+      int numThreads = m_param.HypergraphNumThreads;
+#ifdef _OPENMP
+
+      if (numThreads <= 0) {
+         numThreads = omp_get_num_procs();
+      }
+
+#else
+      numThreads = 1;
 #endif
+      edgecut[0] = UtilHypergraphPartition(numCols, numHyperedges, vwgts,
+                                           eptr, eind, hewgts, nparts,
+                                           m_param.HypergraphUBFactor,
+                                           numThreads, 1, part);
+   } else {
+      throw UtilException("Unknown hypergraph partitioner " +
+                          m_param.HypergraphPartitioner,
+                          "singlyBorderStructureDetection", "DecompApp");
+   }
+
    clock_t end = clock();
    UTIL_MSG(m_param.LogLevel, 2,
             (*m_osLog)
             << "********************************************" << "\n"
-            << "The time elapse for hypergraph partitioning is "
-            << (end - begin) / CLOCKS_PER_SEC << " seconds" << "\n"
+            << "The time elapse for hypergraph partitioning ("
+            << m_param.HypergraphPartitioner << ") is "
+            << static_cast<double>(end - begin) / CLOCKS_PER_SEC
+            << " cpu seconds" << "\n"
+            << "The number of coupling rows (cut hyperedges) is "
+            << edgecut[0] << "\n"
             << "********************************************"
             << "\n";
            );
-#endif
    /*
     *The following codes try to find the hyperedges in the
     * vertex separator set by traversing the hyperedges.
@@ -1708,7 +1752,11 @@ void DecompApp::singlyBorderStructureDetection()
    UTIL_DELARR(intHyperedges);
    UTIL_DELARR(partweights);
 #ifdef PaToH
-   PaToH_Free();
+
+   if (m_param.HypergraphPartitioner == "PaToH") {
+      PaToH_Free();
+   }
+
 #endif
 
    if (m_threadIndex != 0) {
@@ -1723,6 +1771,18 @@ void DecompApp::setModelRelax(DecompConstraintSet* model,
    if (model && !model->hasPrepRun()) {
       model->prepareModel(m_infinity);
    }
+
+   if (model) {
+      UTIL_MSG(m_param.LogLevel, 2,
+               (*m_osLog) << "Block " << blockId << " (" << modelName << ")"
+               << " nRows = " << model->getNumRows()
+               << " nCols = " << model->getNumCols()
+               << (model->isSparse() ? " (sparse)" : " (dense)")
+               << " memory = "
+               << UtilDblToStr(model->getMemoryUsage() / 1024.0, 1)
+               << " KB" << std::endl;
+              );
+   }
    
    //---
    //--- make sure this block has not been set yet
@@ -32,6 +32,7 @@ extern "C" {
 }
 //===========================================================================//
 class DecompAlgo;
+class DecompConcurrentState;
 
 //===========================================================================//
 /*!
@@ -139,6 +140,14 @@ public:
 
    int m_threadIndex;
 
+   /**
+    * State shared by all racers during the Concurrent process
+    * (shared incumbent, stop flag). NULL when not racing; owned
+    * by the caller.
+    **/
+
+   DecompConcurrentState* m_concurrent;
+
    /** The value of infinity **/
    
    double m_infinity;
@@ -319,6 +328,26 @@ public:
       return 0;
    }
 
+   /**
+    * Branching objects (PC only): the user can branch on rows of x, e.g.,
+    * aggregated flows, instead of on single variables. Each child gets a
+    * list of branching rows (see DecompBranchRow for how a row of a block
+    * differs from a row over several blocks). A solveRelaxed defined by the
+    * user must honor the rows of its block (DecompAlgo::getBranchRows) if
+    * BranchEnforceInSubProb, as it honors the node column bounds.
+    *
+    * @param[in] x The current (fractional) solution, in original space.
+    * @param[out] downRows The branching rows of the down child.
+    * @param[out] upRows The branching rows of the up child.
+    * @return True, if a branching object was found; otherwise, the
+    *         framework chooses one (see DecompParam::BranchRowRule).
+    */
+   virtual bool APPchooseBranchRows(const double*                 x,
+                                    std::vector<DecompBranchRow>& downRows,
+                                    std::vector<DecompBranchRow>& upRows) {
+      return false;
+   }
+
    /**
     * This function allows the user to return their own dual vector
     * to be used in the generation of new variables (in the reduced-cost
@@ -450,7 +479,8 @@ public:
       m_modelCore  (utilParam),
       m_matrix     ( NULL  ),
       m_modelC     ( NULL  ),
-      m_threadIndex(  0    )
+      m_threadIndex(  0    ),
+      m_concurrent ( NULL  )
    {
       //---
       //--- get application parameters
@@ -28,6 +28,7 @@ std::vector< std::pair<int, double> >& upBranchUB)
    //---
    //--- Default branching in DIP is the most simple approach possible.
    //---   Choose variables farthest from integer - based on x formulation.
+   //---   BranchRule > 0 chooses by pseudo-cost (or reliability) instead.
    //---
    std::vector<int>::iterator intIt;
    int    branchedOnIndex, j;
@@ -62,24 +63,31 @@ std::vector< std::pair<int, double> >& upBranchUB)
    }
    else
    {
-      for (intIt = modelCore->integerVars.begin();
-         intIt != modelCore->integerVars.end(); ++intIt)
+      if (m_param.BranchRule > 0)
       {
-         j = *intIt;
-         x = m_xhat[j];
-         obj += m_xhat[j] * objCoeff[j];
-         dist = fabs(x - floor(x + 0.5));
-
-         if (dist > maxDist)
+         chooseBranchVarPseudoCost(branchedOnIndex, branchedOnValue);
+      }
+      else
+      {
+         for (intIt = modelCore->integerVars.begin();
+            intIt != modelCore->integerVars.end(); ++intIt)
          {
-            maxDist = dist;
-            branchedOnIndex = j;
-            branchedOnValue = x;
-         }
-         if (std::find(m_branchedMasterOnly.begin(), m_branchedMasterOnly.end(), branchedOnIndex)
-            != m_branchedMasterOnly.end())
-         {
-            branchedOnIndex = -1;
+            j = *intIt;
+            x = m_xhat[j];
+            obj += m_xhat[j] * objCoeff[j];
+            dist = fabs(x - floor(x + 0.5));
+
+            if (dist > maxDist)
+            {
+               maxDist = dist;
+               branchedOnIndex = j;
+               branchedOnValue = x;
+            }
+            if (std::find(m_branchedMasterOnly.begin(), m_branchedMasterOnly.end(), branchedOnIndex)
+               != m_branchedMasterOnly.end())
+            {
+               branchedOnIndex = -1;
+            }
          }
       }
 
@@ -131,4 +139,825 @@ std::vector< std::pair<int, double> >& upBranchUB)
          "chooseBranchSet()", m_param.LogDebugLevel, 1);
    }
 
-}
\ No newline at end of file
+}
+
+// --------------------------------------------------------------------- //
+bool DecompAlgo::chooseBranchVarPseudoCost(int&    branchedOnIndex,
+                                           double& branchedOnValue)
+{
+   UtilPrintFuncBegin(m_osLog, m_classTag,
+      "chooseBranchVarPseudoCost()", m_param.LogDebugLevel, 2);
+   //---
+   //--- the candidates are the fractional integer variables, scored by
+   //---   the product of their estimated down and up bound gains
+   //---
+   std::vector<int>::iterator intIt;
+   std::vector<int>    candIndex;
+   std::vector<double> candValue;
+   std::vector<double> candScore;
+   std::vector<char>   candReliable;
+   int    j, k;
+   double x, bestScore;
+   DecompConstraintSet* modelCore = m_modelCore.getModel();
+   const int nCands = static_cast<int>(modelCore->integerVars.size());
+   candIndex.reserve(nCands);
+   candValue.reserve(nCands);
+   candScore.reserve(nCands);
+   candReliable.reserve(nCands);
+   branchedOnIndex = -1;
+   branchedOnValue = 0.0;
+#ifdef _OPENMP
+#pragma omp critical (DecompPseudoCost)
+#endif
+   {
+      for (intIt = modelCore->integerVars.begin();
+         intIt != modelCore->integerVars.end(); ++intIt)
+      {
+         j = *intIt;
+         x = m_xhat[j];
+
+         if (fabs(x - floor(x + 0.5)) <= DecompEpsilon)
+         {
+            continue;
+         }
+
+         if (std::find(m_branchedMasterOnly.begin(),
+            m_branchedMasterOnly.end(), j) != m_branchedMasterOnly.end())
+         {
+            continue;
+         }
+
+         candIndex.push_back(j);
+         candValue.push_back(x);
+         candScore.push_back(DecompPseudoCost::score(
+            (x - floor(x)) * m_pseudoCost->getDown(j),
+            (ceil(x) - x)  * m_pseudoCost->getUp(j)));
+         candReliable.push_back(m_pseudoCost->getNumReliable(j)
+            >= m_param.BranchReliability);
+      }
+   }
+
+   //---
+   //--- reliability branching: strong branch on the unreliable candidates,
+   //---   best score first, once this node is done (not while processNode
+   //---   only checks if there is a candidate, nor during strong branching)
+   //---
+   const double parentLB = getObjBestBoundLB();
+
+   if (m_param.BranchRule == 2 && m_param.BranchStrongCand > 0 &&
+      m_phase == PHASE_DONE && !m_isStrongBranch && m_curNode &&
+      parentLB > -m_infinity && !candIndex.empty())
+   {
+      std::vector< std::pair<double, int> > order;
+      int    nStrong = 0;
+      double downLB, upLB;
+
+      for (k = 0; k < static_cast<int>(candIndex.size()); k++)
+      {
+         order.push_back(std::make_pair(-candScore[k], k));
+      }
+
+      std::sort(order.begin(), order.end());
+
+      for (size_t o = 0; o < order.size(); o++)
+      {
+         if (nStrong >= m_param.BranchStrongCand)
+         {
+            break;
+         }
+
+         k = order[o].second;
+
+         if (candReliable[k])
+         {
+            continue;
+         }
+
+         strongBranchVar(candIndex[k], candValue[k], parentLB, downLB, upLB);
+         updatePseudoCost(candIndex[k], -1, candValue[k], parentLB, downLB);
+         updatePseudoCost(candIndex[k],  1, candValue[k], parentLB, upLB);
+         candScore[k] = DecompPseudoCost::score(downLB - parentLB,
+            upLB - parentLB);
+         nStrong++;
+         UTIL_MSG(m_param.LogDebugLevel, 3,
+            (*m_osLog) << "strong branch on " << candIndex[k]
+            << " x= " << UtilDblToStr(candValue[k])
+            << " downLB= " << UtilDblToStr(downLB)
+            << " upLB= " << UtilDblToStr(upLB) << "\n";
+         );
+      }
+   }
+
+   bestScore = -1.0;
+
+   for (k = 0; k < static_cast<int>(candIndex.size()); k++)
+   {
+      if (candScore[k] > bestScore)
+      {
+         bestScore       = candScore[k];
+         branchedOnIndex = candIndex[k];
+         branchedOnValue = candValue[k];
+      }
+   }
+
+   UtilPrintFuncEnd(m_osLog, m_classTag,
+      "chooseBranchVarPseudoCost()", m_param.LogDebugLevel, 2);
+   return branchedOnIndex != -1;
+}
+
+// --------------------------------------------------------------------- //
+void DecompAlgo::strongBranchVar(const int    j,
+                                 const double x,
+                                 const double parentLB,
+                                 double&      downLB,
+                                 double&      upLB)
+{
+   DecompConstraintSet* modelCore = m_modelCore.getModel();
+   const int nCols = modelCore->getNumCols();
+   std::vector<double> lbs(m_colLBNode, m_colLBNode + nCols);
+   std::vector<double> ubs(m_colUBNode, m_colUBNode + nCols);
+   const double ub = ubs[j];
+   //---
+   //--- down: x[j] <= floor(x)
+   //---
+   ubs[j] = floor(x);
+   downLB = evalStrongBranch(m_curNode, &lbs[0], &ubs[0], NULL, parentLB,
+      m_globalUB, m_param.BranchStrongCandIter);
+   //---
+   //--- up: x[j] >= ceil(x)
+   //---
+   ubs[j] = ub;
+   lbs[j] = ceil(x);
+   upLB = evalStrongBranch(m_curNode, &lbs[0], &ubs[0], NULL, parentLB,
+      m_globalUB, m_param.BranchStrongCandIter);
+}
+
+// --------------------------------------------------------------------- //
+double DecompAlgo::evalStrongBranch(const AlpsDecompTreeNode*    node,
+                                    const double*                lbs,
+                                    const double*                ubs,
+                                    const DecompMasterWarmStart* ws,
+                                    const double                 parentLB,
+                                    const double                 globalUB,
+                                    const int                    maxIters)
+{
+   UtilPrintFuncBegin(m_osLog, m_classTag,
+      "evalStrongBranch()", m_param.LogDebugLevel, 2);
+   DecompConstraintSet* modelCore = m_modelCore.getModel();
+   const int nCols = modelCore->getNumCols();
+   //---
+   //--- snapshot what processNode changes
+   //---
+   const int                 limitTotalCutIters   = m_param.TotalCutItersLimit;
+   const int                 limitTotalPriceIters = m_param.TotalPriceItersLimit;
+   const int                 solveMasterAsMip     = m_param.SolveMasterAsMip;
+   const double              globalLBLast         = m_globalLB;
+   const double              globalUBLast         = m_globalUB;
+   const DecompPhase         phaseLast            = m_phaseLast;
+   const DecompStatus        status               = m_status;
+   const DecompNodeStats     nodeStats            = m_nodeStats;
+   const AlpsDecompTreeNode* curNode              = m_curNode;
+   std::vector<double> xhat(m_xhat, m_xhat + nCols);
+   std::vector<double> lbNode(m_colLBNode, m_colLBNode + nCols);
+   std::vector<double> ubNode(m_colUBNode, m_colUBNode + nCols);
+   DecompMasterWarmStart* basis = getMasterWarmStart();
+   double childLB;
+   //---
+   //--- a truncated processNode of the child, from the given basis
+   //---
+   m_param.TotalCutItersLimit   = 0;
+   m_param.TotalPriceItersLimit = maxIters;
+   m_param.SolveMasterAsMip     = 0;
+   setStrongBranchIter(true);
+   setMasterWarmStart(ws ? ws : basis);
+   setMasterBounds(lbs, ubs);
+   setSubProbBounds(lbs, ubs);
+   childLB = processNode(node, parentLB, globalUB) == STAT_INFEASIBLE ?
+      m_infinity : std::max(parentLB, getObjBestBoundLB());
+   //---
+   //--- roll back (the generated columns stay in the master)
+   //---
+   setMasterWarmStart(basis);
+   setMasterBounds(&lbNode[0], &ubNode[0]);
+   setSubProbBounds(&lbNode[0], &ubNode[0]);
+   applyMasterWarmStart();
+   UTIL_DELPTR(basis);
+   setStrongBranchIter(false);
+   std::copy(xhat.begin(), xhat.end(), m_xhat);
+   m_param.TotalCutItersLimit   = limitTotalCutIters;
+   m_param.TotalPriceItersLimit = limitTotalPriceIters;
+   m_param.SolveMasterAsMip     = solveMasterAsMip;
+   m_globalLB                   = globalLBLast;
+   m_globalUB                   = globalUBLast;
+   m_phaseLast                  = phaseLast;
+   m_status                     = status;
+   m_nodeStats                  = nodeStats;
+   m_curNode                    = curNode;
+   UTIL_MSG(m_param.LogLevel, 3,
+      (*m_osLog) << "Strong branch child LB = " << UtilDblToStr(childLB)
+      << " (parent LB = " << UtilDblToStr(parentLB) << ")" << std::endl;
+   );
+   UtilPrintFuncEnd(m_osLog, m_classTag,
+      "evalStrongBranch()", m_param.LogDebugLevel, 2);
+   return childLB;
+}
+
+// --------------------------------------------------------------------- //
+void DecompAlgo::updatePseudoCost(const int    j,
+                                  const int    dir,
+                                  const double x,
+                                  const double parentLB,
+                                  const double childLB)
+{
+   //---
+   //--- an infeasible child (or a parent without a bound) says nothing
+   //---   about the gain per unit
+   //---
+   const double frac = dir < 0 ? x - floor(x) : ceil(x) - x;
+
+   if (frac <= DecompEpsilon || parentLB <= -m_infinity ||
+      childLB >= m_infinity)
+   {
+      return;
+   }
+
+   const double gain = std::max(childLB - parentLB, 0.0) / frac;
+#ifdef _OPENMP
+#pragma omp critical (DecompPseudoCost)
+#endif
+   m_pseudoCost->update(j, dir, gain);
+}
+
+// --------------------------------------------------------------------- //
+//---
+//--- the block of each column of the core (-1 if it is in no block, e.g.,
+//---   master-only), from the active columns of the blocks
+//---
+static void getColBlocks(const std::map<int, DecompSubModel>& modelRelax,
+                         const int                            nCols,
+                         std::vector<int>&                    colBlock)
+{
+   std::map<int, DecompSubModel>::const_iterator mit;
+   colBlock.assign(nCols, -1);
+
+   for (mit = modelRelax.begin(); mit != modelRelax.end(); ++mit)
+   {
+      const DecompConstraintSet* model = mit->second.getModel();
+
+      if (!model)
+      {
+         continue;
+      }
+
+      const std::vector<int>& cols = model->isSparse() ?
+                                     model->getSparseToOrig() :
+                                     model->getActiveColumns();
+      std::vector<int>::const_iterator it;
+
+      //---
+      //--- if no active columns are set, they are all active (one block)
+      //---
+      if (cols.empty())
+      {
+         colBlock.assign(nCols, mit->first);
+         continue;
+      }
+
+      for (it = cols.begin(); it != cols.end(); ++it)
+      {
+         colBlock[*it] = mit->first;
+      }
+   }
+}
+
+// --------------------------------------------------------------------- //
+bool DecompAlgo::chooseBranchRows(std::vector<DecompBranchRow>& downRows,
+                                  std::vector<DecompBranchRow>& upRows)
+{
+   downRows.clear();
+   upRows.clear();
+
+   //---
+   //--- the branching rows are enforced through the master columns
+   //---
+   if (m_algo != PRICE_AND_CUT || !m_masterSI)
+   {
+      return false;
+   }
+
+   UtilPrintFuncBegin(m_osLog, m_classTag,
+      "chooseBranchRows()", m_param.LogDebugLevel, 2);
+   bool gotBranch = m_app->APPchooseBranchRows(m_xhat, downRows, upRows);
+
+   if (!gotBranch)
+   {
+      downRows.clear();
+      upRows.clear();
+
+      switch (m_param.BranchRowRule)
+      {
+      case 1:
+         //---
+         //--- the Ryan-Foster rows only hold column by column: summed
+         //---   over lambda in the master, the current point can still
+         //---   satisfy them and the same pair would be chosen again
+         //---   (rejected in initSetup)
+         //---
+         assert(m_param.BranchEnforceInSubProb);
+         gotBranch = chooseBranchRowsRyanFoster(downRows, upRows);
+         break;
+      case 2:
+         gotBranch = chooseBranchRowsBlockSum(downRows, upRows);
+         break;
+      default:
+         break;
+      }
+   }
+
+   if (gotBranch && (downRows.empty() || upRows.empty()))
+   {
+      throw UtilException("A branching object must give rows to both children",
+         "chooseBranchRows", "DecompAlgo");
+   }
+
+   UtilPrintFuncEnd(m_osLog, m_classTag,
+      "chooseBranchRows()", m_param.LogDebugLevel, 2);
+   return gotBranch;
+}
+
+// --------------------------------------------------------------------- //
+bool DecompAlgo::chooseBranchRowsRyanFoster(std::vector<DecompBranchRow>& downRows,
+                                            std::vector<DecompBranchRow>& upRows)
+{
+   DecompConstraintSet*    modelCore   = m_modelCore.getModel();
+   const CoinPackedMatrix* M           = modelCore->getMatrix();
+   const CoinPackedMatrix* masterByCol = m_masterSI->getMatrixByCol();
+   const double*           lambda      = m_masterSI->getColSolution();
+   const int               nBaseRows   = modelCore->nBaseRowsOrig;
+   const int               nCols       = modelCore->getNumCols();
+   int                     r, k;
+   assert(!M->isColOrdered());
+   //---
+   //--- the set partitioning rows of the core: x(r) = 1, with coefficients
+   //---   1 on integer columns
+   //---
+   std::vector<char> isSetPart(nBaseRows, 0);
+
+   for (r = 0; r < nBaseRows; r++)
+   {
+      if (!UtilIsZero(modelCore->rowLB[r] - 1.0) ||
+         !UtilIsZero(modelCore->rowUB[r] - 1.0))
+      {
+         continue;
+      }
+
+      const CoinShallowPackedVector row = M->getVector(r);
+      isSetPart[r] = 1;
+
+      for (k = 0; k < row.getNumElements(); k++)
+      {
+         if (!UtilIsZero(row.getElements()[k] - 1.0) ||
+            modelCore->integerMark[row.getIndices()[k]] != 'I')
+         {
+            isSetPart[r] = 0;
+            break;
+         }
+      }
+   }
+
+   //---
+   //--- the coefficient of a master column in an original row r is (A''s)_r,
+   //---   so a column covers r if it is 1 there; add up, for each pair of
+   //---   rows, the fractional columns which cover both
+   //---
+   std::map< std::pair<int, int>, double > pairValue;
+   std::vector<int> covered;
+   DecompVarList::iterator li;
+
+   for (li = m_vars.begin(); li != m_vars.end(); ++li)
+   {
+      const int    c = (*li)->getColMasterIndex();
+      const double l = lambda[c];
+
+      if (l <= DecompEpsilon || l >= 1.0 - DecompEpsilon)
+      {
+         continue;
+      }
+
+      const CoinShallowPackedVector col = masterByCol->getVector(c);
+      covered.clear();
+
+      for (k = 0; k < col.getNumElements(); k++)
+      {
+         r = col.getIndices()[k];
+
+         if (r < nBaseRows && isSetPart[r] &&
+            UtilIsZero(col.getElements()[k] - 1.0))
+         {
+            covered.push_back(r);
+         }
+      }
+
+      std::sort(covered.begin(), covered.end());
+
+      for (size_t i1 = 0; i1 < covered.size(); i1++)
+      {
+         for (size_t i2 = i1 + 1; i2 < covered.size(); i2++)
+         {
+            pairValue[std::make_pair(covered[i1], covered[i2])] += l;
+         }
+      }
+   }
+
+   //---
+   //--- the pair covered by the most fractional total
+   //---
+   std::map< std::pair<int, int>, double >::const_iterator pit;
+   std::pair<int, int> bestPair(-1, -1);
+   double bestDist = DecompEpsilon;
+   double bestValue = 0.0;
+
+   for (pit = pairValue.begin(); pit != pairValue.end(); ++pit)
+   {
+      const double dist = std::min(pit->second, 1.0 - pit->second);
+
+      if (dist > bestDist)
+      {
+         bestDist  = dist;
+         bestPair  = pit->first;
+         bestValue = pit->second;
+      }
+   }
+
+   if (bestPair.first < 0)
+   {
+      return false;
+   }
+
+   //---
+   //--- the rows of each block (the columns of x(r1), x(r2) are sorted)
+   //---
+   const int r1 = bestPair.first;
+   const int r2 = bestPair.second;
+   const CoinShallowPackedVector row1 = M->getVector(r1);
+   const CoinShallowPackedVector row2 = M->getVector(r2);
+   std::vector<int>    colBlock;
+   std::vector<int>    cols;
+   std::vector<double> a1(nCols, 0.0);
+   std::vector<double> a2(nCols, 0.0);
+   std::map<int, DecompBranchRow> downByBlock, upByBlock;
+   std::map<int, DecompBranchRow>::iterator bit;
+   std::vector<int>::const_iterator it;
+   getColBlocks(m_modelRelax, nCols, colBlock);
+
+   for (k = 0; k < row1.getNumElements(); k++)
+   {
+      a1[row1.getIndices()[k]] = row1.getElements()[k];
+      cols.push_back(row1.getIndices()[k]);
+   }
+
+   for (k = 0; k < row2.getNumElements(); k++)
+   {
+      a2[row2.getIndices()[k]] = row2.getElements()[k];
+      cols.push_back(row2.getIndices()[k]);
+   }
+
+   std::sort(cols.begin(), cols.end());
+   cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+
+   for (it = cols.begin(); it != cols.end(); ++it)
+   {
+      const int j = *it;
+      const int b = colBlock[j];
+
+      if (b < 0)
+      {
+         continue;
+      }
+
+      DecompBranchRow& down = downByBlock[b];
+      DecompBranchRow& up   = upByBlock[b];
+
+      if (!UtilIsZero(a1[j] - a2[j]))
+      {
+         down.m_ind.push_back(j);
+         down.m_els.push_back(a1[j] - a2[j]);
+      }
+
+      up.m_ind.push_back(j);
+      up.m_els.push_back(a1[j] + a2[j]);
+   }
+
+   for (bit = downByBlock.begin(); bit != downByBlock.end(); ++bit)
+   {
+      if (bit->second.m_ind.empty())
+      {
+         continue;
+      }
+
+      bit->second.m_blockId = bit->first;
+      bit->second.m_lb      = 0.0;
+      bit->second.m_ub      = 0.0;
+      downRows.push_back(bit->second);
+   }
+
+   for (bit = upByBlock.begin(); bit != upByBlock.end(); ++bit)
+   {
+      bit->second.m_blockId = bit->first;
+      bit->second.m_lb      = -m_infinity;
+      bit->second.m_ub      = 1.0;
+      upRows.push_back(bit->second);
+   }
+
+   UTIL_MSG(m_param.LogDebugLevel, 3,
+      (*m_osLog) << "Ryan-Foster rows " << r1 << " " << r2
+      << " covered together " << UtilDblToStr(bestValue)
+      << " blocks " << upRows.size() << "\n";
+   );
+   return !downRows.empty() && !upRows.empty();
+}
+
+// --------------------------------------------------------------------- //
+bool DecompAlgo::chooseBranchRowsBlockSum(std::vector<DecompBranchRow>& downRows,
+                                          std::vector<DecompBranchRow>& upRows)
+{
+   DecompConstraintSet* modelCore = m_modelCore.getModel();
+   const int            nCols     = modelCore->getNumCols();
+   std::vector<int>     colBlock;
+   std::map<int, double>           blockSum;
+   std::map<int, DecompBranchRow> blockRow;
+   std::map<int, double>::const_iterator sit;
+   std::vector<int>::const_iterator      it;
+   getColBlocks(m_modelRelax, nCols, colBlock);
+   std::vector<int> intVars(modelCore->integerVars);
+   std::sort(intVars.begin(), intVars.end());
+
+   for (it = intVars.begin(); it != intVars.end(); ++it)
+   {
+      const int b = colBlock[*it];
+
+      if (b < 0)
+      {
+         continue;
+      }
+
+      blockSum[b] += m_xhat[*it];
+      blockRow[b].m_ind.push_back(*it);
+      blockRow[b].m_els.push_back(1.0);
+   }
+
+   int    bestBlock = -1;
+   double bestDist  = DecompEpsilon;
+   double bestSum   = 0.0;
+
+   for (sit = blockSum.begin(); sit != blockSum.end(); ++sit)
+   {
+      const double dist = fabs(sit->second - floor(sit->second + 0.5));
+
+      if (dist > bestDist)
+      {
+         bestDist  = dist;
+         bestBlock = sit->first;
+         bestSum   = sit->second;
+      }
+   }
+
+   if (bestBlock < 0)
+   {
+      return false;
+   }
+
+   //---
+   //--- sum(x) <= floor (down), sum(x) >= ceil (up)
+   //---
+   DecompBranchRow& row = blockRow[bestBlock];
+   row.m_blockId = bestBlock;
+   row.m_lb      = -m_infinity;
+   row.m_ub      = floor(bestSum);
+   downRows.push_back(row);
+   row.m_lb      = ceil(bestSum);
+   row.m_ub      = m_infinity;
+   upRows.push_back(row);
+   UTIL_MSG(m_param.LogDebugLevel, 3,
+      (*m_osLog) << "Block " << bestBlock << " sum of x "
+      << UtilDblToStr(bestSum) << "\n";
+   );
+   return true;
+}
+
+// --------------------------------------------------------------------- //
+void DecompAlgo::setBranchRows(const std::vector<DecompBranchRow>& rows)
+{
+   UtilPrintFuncBegin(m_osLog, m_classTag,
+      "setBranchRows()", m_param.LogDebugLevel, 2);
+   m_branchRows = rows;
+
+   //---
+   //--- master: add the rows seen for the first time, set the bounds of
+   //---   the rows of this node and relax the others; the rows of a block
+   //---   are only master rows if the subproblems do not enforce them,
+   //---   and then they hold for the sum of its columns only
+   //---
+   if (m_algo == PRICE_AND_CUT && m_masterSI)
+   {
+      DecompConstraintSet* modelCore = m_modelCore.getModel();
+      std::map<int, const DecompBranchRow*> active;
+      std::map<std::string, int>::const_iterator mit;
+      std::vector<DecompBranchRow>::const_iterator it;
+
+      for (it = rows.begin(); it != rows.end(); ++it)
+      {
+         if (it->m_blockId >= 0 && m_param.BranchEnforceInSubProb)
+         {
+            continue;
+         }
+
+         mit = m_branchRowIndex.find(it->getStrHash(m_infinity));
+         active[mit != m_branchRowIndex.end() ?
+                mit->second : addBranchRowToMaster(*it)] = &(*it);
+      }
+
+      for (mit = m_branchRowIndex.begin(); mit != m_branchRowIndex.end(); ++mit)
+      {
+         const int r     = mit->second;
+         const int rCore = r - m_numConvexCon;
+         std::map<int, const DecompBranchRow*>::const_iterator ait
+            = active.find(r);
+         const double lb = ait != active.end() ? ait->second->m_lb : -m_infinity;
+         const double ub = ait != active.end() ? ait->second->m_ub :  m_infinity;
+         char   sense;
+         double rhs, range;
+         assert(m_masterRowType[r] == DecompRow_Cut);
+         m_masterSI->setRowBounds(r, lb, ub);
+         UtilBoundToSense(lb, ub, m_infinity, sense, rhs, range);
+         modelCore->rowLB[rCore]    = lb;
+         modelCore->rowUB[rCore]    = ub;
+         modelCore->rowSense[rCore] = sense;
+         modelCore->rowRhs[rCore]   = rhs;
+      }
+   }
+
+   //---
+   //--- subproblems: the rows of each block (see setMasterBounds for the
+   //---   master columns)
+   //---
+   if (m_param.BranchEnforceInSubProb)
+   {
+      std::map<int, DecompSubModel>::iterator               mit;
+      std::map<int, std::vector<DecompSubModel> >::iterator nit;
+      std::vector<DecompSubModel>::iterator                 vit;
+
+      for (mit = m_modelRelax.begin(); mit != m_modelRelax.end(); ++mit)
+      {
+         mit->second.setBranchRows(rows);
+      }
+
+      for (nit = m_modelRelaxNest.begin(); nit != m_modelRelaxNest.end(); ++nit)
+      {
+         for (vit = nit->second.begin(); vit != nit->second.end(); ++vit)
+         {
+            vit->setBranchRows(rows);
+         }
+      }
+   }
+
+   UtilPrintFuncEnd(m_osLog, m_classTag,
+      "setBranchRows()", m_param.LogDebugLevel, 2);
+}
+
+// --------------------------------------------------------------------- //
+int DecompAlgo::addBranchRowToMaster(const DecompBranchRow& brow)
+{
+   DecompConstraintSet* modelCore    = m_modelCore.getModel();
+   std::vector<std::string>& coreRowNames = modelCore->getRowNamesMutable();
+   const int            nEls         = brow.getNumElements();
+   const int            rowIndex     = m_masterSI->getNumRows();
+   int                  colIndex     = m_masterSI->getNumCols();
+   char                 sense;
+   double               rhs, range;
+   std::string          rowName      = "branch(" + UtilIntToStr(rowIndex) + ")";
+   CoinPackedVector     row(nEls,
+                            nEls ? &brow.m_ind[0] : NULL,
+                            nEls ? &brow.m_els[0] : NULL);
+   //---
+   //--- the row in terms of lambda, as for a cut
+   //---
+   CoinPackedVector* rowReform
+      = m_cutpool.createRowReform(modelCore->getNumCols(), &row, m_vars);
+   std::map<int, int>::iterator mit;
+
+   for (int k = 0; k < nEls; k++)
+   {
+      mit = m_masterOnlyColsMap.find(brow.m_ind[k]);
+
+      if (mit != m_masterOnlyColsMap.end())
+      {
+         rowReform->insert(mit->second, brow.m_els[k]);
+      }
+   }
+
+   //---
+   //--- the master row and the core row: a cut, as far as the duals and
+   //---   the master columns are concerned
+   //---
+   m_masterSI->addRow(*rowReform, brow.m_lb, brow.m_ub);
+   m_masterSI->setRowName(rowIndex, rowName);
+   UTIL_DELPTR(rowReform);
+   modelCore->M->appendRow(row);
+   coreRowNames.push_back(rowName);
+   modelCore->rowHash.push_back(brow.getStrHash(m_infinity));
+   UtilBoundToSense(brow.m_lb, brow.m_ub, m_infinity, sense, rhs, range);
+   modelCore->rowLB.push_back(brow.m_lb);
+   modelCore->rowUB.push_back(brow.m_ub);
+   modelCore->rowSense.push_back(sense);
+   modelCore->rowRhs.push_back(rhs);
+   m_masterRowType.push_back(DecompRow_Cut);
+   m_branchRowIndex[brow.getStrHash(m_infinity)] = rowIndex;
+   m_varpool.setColsAreValid(false);
+
+   //---
+   //--- artificial columns for phase I (fixed to 0)
+   //---
+   if (sense == 'L' || sense == 'E')
+   {
+      CoinPackedVector artCol;
+      artCol.insert(rowIndex, -1.0);
+      m_masterSI->addCol(artCol, 0.0, 0.0, 0.0);
+      m_masterSI->setColName(colIndex, "sBL(c_" + UtilIntToStr(colIndex)
+         + "_" + UtilIntToStr(rowIndex) + ")");
+      m_masterColType.push_back(DecompCol_ArtForCutL);
+      m_masterArtCols.push_back(colIndex);
+      colIndex++;
+   }
+
+   if (sense == 'G' || sense == 'E')
+   {
+      CoinPackedVector artCol;
+      artCol.insert(rowIndex, 1.0);
+      m_masterSI->addCol(artCol, 0.0, 0.0, 0.0);
+      m_masterSI->setColName(colIndex, "sBG(c_" + UtilIntToStr(colIndex)
+         + "_" + UtilIntToStr(rowIndex) + ")");
+      m_masterColType.push_back(DecompCol_ArtForCutG);
+      m_masterArtCols.push_back(colIndex);
+      colIndex++;
+   }
+
+   UTIL_MSG(m_param.LogDebugLevel, 3,
+      (*m_osLog) << "Branching row " << rowName << " block "
+      << brow.m_blockId << " nonzeros " << nEls << "\n";
+   );
+   return rowIndex;
+}
+
+// --------------------------------------------------------------------- //
+bool DecompAlgo::doesSatisfyBranchRows(const DecompVar* var,
+                                       double*          denseS) const
+{
+   if (!m_param.BranchEnforceInSubProb)
+   {
+      return true;
+   }
+
+   const int     blockId = var->getBlockId();
+   const int     sz      = var->m_s.getNumElements();
+   const int*    inds    = var->m_s.getIndices();
+   const double* elems   = var->m_s.getElements();
+   std::vector<DecompBranchRow>::const_iterator it;
+   bool isFeas  = true;
+   bool isDense = false;
+   int  i;
+
+   for (it = m_branchRows.begin(); it != m_branchRows.end(); ++it)
+   {
+      if (it->m_blockId != blockId)
+      {
+         continue;
+      }
+
+      if (!isDense)
+      {
+         for (i = 0; i < sz; ++i)
+         {
+            denseS[inds[i]] = elems[i];
+         }
+
+         isDense = true;
+      }
+
+      if (!it->isSatisfied(denseS))
+      {
+         isFeas = false;
+         break;
+      }
+   }
+
+   if (isDense)
+   {
+      for (i = 0; i < sz; ++i)
+      {
+         denseS[inds[i]] = 0.0;
+      }
+   }
+
+   return isFeas;
+}
@@ -0,0 +1,112 @@
+//===========================================================================//
+// This file is part of the DIP Solver Framework.                            //
+//                                                                           //
+// DIP is distributed under the Eclipse Public License as part of the        //
+// COIN-OR repository (http://www.coin-or.org).                              //
+//                                                                           //
+// Authors: Matthew Galati, SAS Institute Inc. (matthew.galati@sas.com)      //
+//          Ted Ralphs, Lehigh University (ted@lehigh.edu)                   //
+//          Jiadong Wang, Lehigh University (jiw508@lehigh.edu)              //
+//                                                                           //
+// Copyright (C) 2002-2018, Lehigh University, Matthew Galati, Ted Ralphs    //
+// All Rights Reserved.                                                      //
+//===========================================================================//
+
+#ifndef DECOMP_BRANCH_ROW_INCLUDE
+#define DECOMP_BRANCH_ROW_INCLUDE
+
+//===========================================================================//
+/**
+ * \class DecompBranchRow
+ * \brief A branching row lb <= a.x <= ub (original space).
+ *
+ * Branching objects which are not bounds on single variables (Ryan-Foster
+ * pairs, sums of x over a block, aggregated flows) give each child a list
+ * of branching rows.
+ *
+ * A row of a block (blockId >= 0) only involves the columns of that block.
+ * If BranchEnforceInSubProb, it is enforced in the block's subproblem, so
+ * it holds for each of its columns (extreme points) on its own; otherwise
+ * it is a row of the master, which only holds for the sum of the columns
+ * weighted by lambda. A row which is only valid column by column (e.g.,
+ * Ryan-Foster) therefore needs BranchEnforceInSubProb. A row over several
+ * blocks (blockId = -1) is always a master row.
+ *
+ * \see DecompAlgo::chooseBranchRows, DecompAlgo::setBranchRows
+ */
+//===========================================================================//
+#include "Decomp.h"
+#include "UtilHash.h"
+#include "UtilMacros.h"
+
+//===========================================================================//
+class DecompBranchRow {
+
+public:
+   /** Block of the row (-1 if it is over several blocks). */
+   int                 m_blockId;
+   /** Row coefficients, (original) column indices sorted. */
+   std::vector<int>    m_ind;
+   std::vector<double> m_els;
+   double              m_lb;
+   double              m_ub;
+
+public:
+   inline int getNumElements() const {
+      return static_cast<int>(m_ind.size());
+   }
+
+   /** Activity of the row at the (dense, original space) point x. */
+   inline double activity(const double* x) const {
+      double act = 0.0;
+
+      for (size_t k = 0; k < m_ind.size(); k++) {
+         act += m_els[k] * x[m_ind[k]];
+      }
+
+      return act;
+   }
+
+   /** Is the (dense, original space) point x within the row bounds? */
+   inline bool isSatisfied(const double* x,
+                           const double  tol = DecompEpsilon) const {
+      const double act = activity(x);
+      return act >= m_lb - tol && act <= m_ub + tol;
+   }
+
+   /** Hash of the row and its bounds (as for cuts). */
+   std::string getStrHash(const double infinity) const {
+      char   sense;
+      double rhs, range;
+      UtilBoundToSense(m_lb, m_ub, infinity, sense, rhs, range);
+      return UtilCreateStringHash(getNumElements(),
+                                  m_ind.empty() ? NULL : &m_ind[0],
+                                  m_els.empty() ? NULL : &m_els[0],
+                                  sense, rhs, infinity);
+   }
+
+public:
+   DecompBranchRow() :
+      m_blockId(-1),
+      m_ind    (),
+      m_els    (),
+      m_lb     (0.0),
+      m_ub     (0.0) {
+   }
+
+   DecompBranchRow(const int                  blockId,
+                   const std::vector<int>&    ind,
+                   const std::vector<double>& els,
+                   const double               lb,
+                   const double               ub) :
+      m_blockId(blockId),
+      m_ind    (ind),
+      m_els    (els),
+      m_lb     (lb),
+      m_ub     (ub) {
+   }
+
+   ~DecompBranchRow() {}
+};
+
+#endif
@@ -0,0 +1,243 @@
+//===========================================================================//
+// This file is part of the DIP Solver Framework.                            //
+//                                                                           //
+// DIP is distributed under the Eclipse Public License as part of the        //
+// COIN-OR repository (http://www.coin-or.org).                              //
+//                                                                           //
+// Authors: Matthew Galati, SAS Institute Inc. (matthew.galati@sas.com)      //
+//          Ted Ralphs, Lehigh University (ted@lehigh.edu)                   //
+//          Jiadong Wang, Lehigh University (jiw508@lehigh.edu)              //
+//                                                                           //
+// Copyright (C) 2002-2018, Lehigh University, Matthew Galati, Ted Ralphs    //
+// All Rights Reserved.                                                      //
+//===========================================================================//
+
+
+#include "DecompColArchive.h"
+
+using namespace std;
+
+// --------------------------------------------------------------------- //
+bool DecompColArchive::add(const DecompVar* var)
+{
+   if (m_maxBytes == 0 ||
+         m_hashIndex.contains(var->getBlockId(), var->getHash())) {
+      return false;
+   }
+
+   const int      len   = var->m_s.getNumElements();
+   const int*     ind   = var->m_s.getIndices();
+   const double* els   = var->m_s.getElements();
+   const size_t   bytes = slotBytes(len);
+
+   if (bytes > m_maxBytes) {
+      return false;
+   }
+
+   //---
+   //--- make room: evict the least recently used (oldest) columns
+   //---
+   while (m_bytes + bytes > m_maxBytes) {
+      while (!m_isLive[m_first]) {
+         m_first++;
+      }
+
+      erase(m_first);
+      m_nEvicted++;
+   }
+
+   if (getNumSlots() - m_nLive > m_nLive) {
+      compact();
+   }
+
+   //---
+   //--- append the column (m_s is sorted, see DecompVar)
+   //---
+   m_ind.insert(m_ind.end(), ind, ind + len);
+   m_els.insert(m_els.end(), els, els + len);
+   m_colBeg.push_back(static_cast<int>(m_ind.size()));
+   m_blockId.push_back(var->getBlockId());
+   m_varType.push_back(static_cast<char>(var->getVarType()));
+   m_origCost.push_back(var->getOriginalCost());
+   m_hash.push_back(var->getHash());
+   m_isLive.push_back(1);
+   m_hashIndex.insert(var->getBlockId(), var->getHash());
+   m_nLive++;
+   m_bytes += bytes;
+   m_nAdded++;
+   return true;
+}
+
+// --------------------------------------------------------------------- //
+void DecompColArchive::price(const double*   redCostX,
+                             const double*   alpha,
+                             vector<double>& redCost) const
+{
+   const int nSlots = getNumSlots();
+   redCost.resize(nSlots);
+
+   if (nSlots == 0) {
+      return;
+   }
+
+   //---
+   //--- one pass of the (SIMD) sparse kernel over the whole block, dead
+   //---   slots included - they are overwritten below
+   //---
+   UtilSparseColsDot(nSlots, &m_colBeg[0],
+                     m_ind.empty() ? 0 : &m_ind[0],
+                     m_els.empty() ? 0 : &m_els[0],
+                     redCostX, &redCost[0]);
+
+   for (int k = 0; k < nSlots; k++) {
+      if (!m_isLive[k]) {
+         redCost[k] = DecompBigNum;
+      } else if (m_varType[k] == DecompVar_Point) {
+         redCost[k] -= alpha[m_blockId[k]];
+      }
+   }
+}
+
+// --------------------------------------------------------------------- //
+void DecompColArchive::selectBest(const vector<double>& redCost,
+                                  const double          threshold,
+                                  const int             maxPerBlock,
+                                  vector<int>&          slots) const
+{
+   //---
+   //--- a bounded max-heap (worst on top) of (redCost, slot) per block
+   //---
+   typedef pair<double, int> RcSlot;
+   map<int, vector<RcSlot> > heaps;
+   map<int, vector<RcSlot> >::iterator mit;
+   const int nSlots = getNumSlots();
+   slots.clear();
+
+   for (int k = 0; k < nSlots; k++) {
+      if (!m_isLive[k] || redCost[k] >= threshold) {
+         continue;
+      }
+
+      vector<RcSlot>& heap = heaps[m_blockId[k]];
+      const RcSlot    rs(redCost[k], k);
+
+      if (maxPerBlock <= 0 || static_cast<int>(heap.size()) < maxPerBlock) {
+         heap.push_back(rs);
+         push_heap(heap.begin(), heap.end());
+      } else if (rs < heap.front()) {
+         pop_heap(heap.begin(), heap.end());
+         heap.back() = rs;
+         push_heap(heap.begin(), heap.end());
+      }
+   }
+
+   for (mit = heaps.begin(); mit != heaps.end(); ++mit) {
+      vector<RcSlot>& heap = mit->second;
+      sort_heap(heap.begin(), heap.end());
+
+      for (size_t i = 0; i < heap.size(); i++) {
+         slots.push_back(heap[i].second);
+      }
+   }
+}
+
+// --------------------------------------------------------------------- //
+DecompVar* DecompColArchive::createVar(const int    k,
+                                       const double redCost) const
+{
+   assert(m_isLive[k]);
+   vector<int>    ind(m_ind.begin() + m_colBeg[k],
+                      m_ind.begin() + m_colBeg[k + 1]);
+   vector<double> els(m_els.begin() + m_colBeg[k],
+                      m_els.begin() + m_colBeg[k + 1]);
+   DecompVar* var = new DecompVar(ind, els, redCost, m_origCost[k],
+                                  static_cast<DecompVarType>(m_varType[k]));
+   CoinAssertHint(var, "Error: Out of Memory");
+   var->setBlockId(m_blockId[k]);
+   return var;
+}
+
+// --------------------------------------------------------------------- //
+DecompVar* DecompColArchive::restore(const int    k,
+                                     const double redCost)
+{
+   DecompVar* var = createVar(k, redCost);
+   erase(k);
+   m_nRestored++;
+   return var;
+}
+
+// --------------------------------------------------------------------- //
+void DecompColArchive::drop(const int k)
+{
+   assert(m_isLive[k]);
+   erase(k);
+}
+
+// --------------------------------------------------------------------- //
+void DecompColArchive::erase(const int k)
+{
+   //---
+   //--- only mark it dead, so the slot numbers stay valid until the
+   //---   next add
+   //---
+   m_isLive[k] = 0;
+   m_hashIndex.erase(m_blockId[k], m_hash[k]);
+   m_bytes -= slotBytes(m_colBeg[k + 1] - m_colBeg[k]);
+   m_nLive--;
+}
+
+// --------------------------------------------------------------------- //
+void DecompColArchive::compact()
+{
+   const int nSlots = getNumSlots();
+   int       nKeep  = 0;
+   int       nnz    = 0;
+
+   for (int k = 0; k < nSlots; k++) {
+      if (!m_isLive[k]) {
+         continue;
+      }
+
+      for (int i = m_colBeg[k]; i < m_colBeg[k + 1]; i++) {
+         m_ind[nnz] = m_ind[i];
+         m_els[nnz] = m_els[i];
+         nnz++;
+      }
+
+      m_colBeg  [nKeep + 1] = nnz;
+      m_blockId [nKeep]     = m_blockId[k];
+      m_varType [nKeep]     = m_varType[k];
+      m_origCost[nKeep]     = m_origCost[k];
+      m_hash    [nKeep]     = m_hash[k];
+      m_isLive  [nKeep]     = 1;
+      nKeep++;
+   }
+
+   m_colBeg.resize(nKeep + 1);
+   m_ind.resize(nnz);
+   m_els.resize(nnz);
+   m_blockId.resize(nKeep);
+   m_varType.resize(nKeep);
+   m_origCost.resize(nKeep);
+   m_hash.resize(nKeep);
+   m_isLive.resize(nKeep);
+   m_first = 0;
+}
+
+// --------------------------------------------------------------------- //
+void DecompColArchive::clear()
+{
+   m_colBeg.assign(1, 0);
+   m_ind.clear();
+   m_els.clear();
+   m_blockId.clear();
+   m_varType.clear();
+   m_origCost.clear();
+   m_hash.clear();
+   m_isLive.clear();
+   m_hashIndex.clear();
+   m_first = 0;
+   m_nLive = 0;
+   m_bytes = 0;
+}
@@ -0,0 +1,172 @@
+//===========================================================================//
+// This file is part of the DIP Solver Framework.                            //
+//                                                                           //
+// DIP is distributed under the Eclipse Public License as part of the        //
+// COIN-OR repository (http://www.coin-or.org).                              //
+//                                                                           //
+// Authors: Matthew Galati, SAS Institute Inc. (matthew.galati@sas.com)      //
+//          Ted Ralphs, Lehigh University (ted@lehigh.edu)                   //
+//          Jiadong Wang, Lehigh University (jiw508@lehigh.edu)              //
+//                                                                           //
+// Copyright (C) 2002-2018, Lehigh University, Matthew Galati, Ted Ralphs    //
+// All Rights Reserved.                                                      //
+//===========================================================================//
+
+
+#ifndef DECOMP_COL_ARCHIVE_INCLUDE
+#define DECOMP_COL_ARCHIVE_INCLUDE
+
+#include "Decomp.h"
+#include "DecompVar.h"
+#include "DecompVarPool.h"
+
+// --------------------------------------------------------------------- //
+/**
+   Archive of the columns which have been compressed out of the master.
+
+   The columns are kept in x-space (s, not A''s), so they stay valid when
+   cuts or branching rows are added to the master, and across the nodes of
+   the tree. They are stored compactly, one column after the other in
+   three flat arrays (column starts, indices and elements - the CSC layout
+   of a matrix whose columns are the archived s's), so that the whole
+   archive is repriced in a single pass of a (SIMD) sparse kernel.
+
+   The memory used is bounded by maxBytes. The columns are kept in the
+   order in which they left the master, so the least recently used column
+   is always the oldest one: once over budget, columns are evicted from the
+   front. Columns which are taken back into the master (or evicted) are
+   only marked dead; the arrays are compacted once the dead columns
+   outnumber the live ones.
+*/
+class DecompColArchive {
+private:
+   DecompColArchive(const DecompColArchive&);
+   DecompColArchive& operator=(const DecompColArchive&);
+
+private:
+   /** Column storage (CSC), slot k is [m_colBeg[k], m_colBeg[k+1]). */
+   std::vector<int>         m_colBeg;
+   std::vector<int>         m_ind;
+   std::vector<double>      m_els;
+
+   /** Per slot data. */
+   std::vector<int>         m_blockId;
+   std::vector<char>        m_varType;
+   std::vector<double>      m_origCost;
+   std::vector<UtilHashKey> m_hash;
+   std::vector<char>        m_isLive;
+
+   /** First live slot (the least recently used column). */
+   int                      m_first;
+   int                      m_nLive;
+   size_t                   m_bytes;
+   size_t                   m_maxBytes;
+
+   /** Hash index of the live columns (no duplicates in the archive). */
+   DecompVarHashIndex       m_hashIndex;
+
+   /** Statistics. */
+   int                      m_nAdded;
+   int                      m_nRestored;
+   int                      m_nEvicted;
+
+private:
+   inline size_t slotBytes(const int len) const {
+      return len * (sizeof(int) + sizeof(double))
+             + 2 * sizeof(int) + sizeof(char) + sizeof(double)
+             + sizeof(UtilHashKey) + sizeof(char);
+   }
+   void erase(const int k);
+   void compact();
+
+public:
+   /** Archive a copy of var. Returns false if it is already archived
+       or the archive is disabled (maxBytes = 0). */
+   bool add(const DecompVar* var);
+
+   /**
+    * Price the archived columns: redCost[k] = redCostX.s - alpha[block]
+    * (alpha is not subtracted for rays). Slots of dead columns get
+    * DecompBigNum. redCost is resized to getNumSlots().
+    */
+   void price(const double*        redCostX,
+              const double*        alpha,
+              std::vector<double>& redCost) const;
+
+   /**
+    * Slots of the (at most) maxPerBlock live columns of each block with the
+    * most negative redCost < threshold (as returned by price), grouped by
+    * block and sorted by redCost within a block. maxPerBlock <= 0 means
+    * no limit.
+    */
+   void selectBest(const std::vector<double>& redCost,
+                   const double               threshold,
+                   const int                  maxPerBlock,
+                   std::vector<int>&          slots) const;
+
+   /** Return a copy of slot k as a new var. */
+   DecompVar* createVar(const int    k,
+                        const double redCost) const;
+
+   /** Remove slot k from the archive and return it as a new var. */
+   DecompVar* restore(const int    k,
+                      const double redCost);
+
+   /** Remove slot k from the archive (e.g., it is already in master). */
+   void drop(const int k);
+
+   void clear();
+
+   inline void setMaxBytes(const size_t maxBytes) {
+      m_maxBytes = maxBytes;
+   }
+   inline int getNumSlots() const {
+      return static_cast<int>(m_blockId.size());
+   }
+   inline int getNumCols() const {
+      return m_nLive;
+   }
+   inline size_t getNumBytes() const {
+      return m_bytes;
+   }
+   inline bool isLive(const int k) const {
+      return m_isLive[k] != 0;
+   }
+   inline int getBlockId(const int k) const {
+      return m_blockId[k];
+   }
+   inline UtilHashKey getHash(const int k) const {
+      return m_hash[k];
+   }
+   inline int getNumAdded() const {
+      return m_nAdded;
+   }
+   inline int getNumRestored() const {
+      return m_nRestored;
+   }
+   inline int getNumEvicted() const {
+      return m_nEvicted;
+   }
+
+public:
+   DecompColArchive() :
+      m_colBeg   (1, 0),
+      m_ind      (),
+      m_els      (),
+      m_blockId  (),
+      m_varType  (),
+      m_origCost (),
+      m_hash     (),
+      m_isLive   (),
+      m_first    (0),
+      m_nLive    (0),
+      m_bytes    (0),
+      m_maxBytes (0),
+      m_hashIndex(),
+      m_nAdded   (0),
+      m_nRestored(0),
+      m_nEvicted (0) {}
+   ~DecompColArchive() {}
+};
+
+#endif
@@ -0,0 +1,160 @@
+//===========================================================================//
+// This file is part of the DIP Solver Framework.                            //
+//                                                                           //
+// DIP is distributed under the Eclipse Public License as part of the        //
+// COIN-OR repository (http://www.coin-or.org).                              //
+//                                                                           //
+// Authors: Matthew Galati, SAS Institute Inc. (matthew.galati@sas.com)      //
+//          Ted Ralphs, Lehigh University (ted@lehigh.edu)                   //
+//          Jiadong Wang, Lehigh University (jiw508@lehigh.edu)              //
+//                                                                           //
+// Copyright (C) 2002-2018, Lehigh University, Matthew Galati, and Ted Ralphs//
+// All Rights Reserved.                                                      //
+//===========================================================================//
+
+//===========================================================================//
+#ifndef DecompConcurrent_h_
+#define DecompConcurrent_h_
+
+//===========================================================================//
+/**
+ * \class DecompConcurrentState
+ * \brief State shared by all racers of the Concurrent mode.
+ *
+ * In Concurrent mode, main runs branch-and-cut and one branch-and-price
+ * per candidate block number at the same time. Each racer works on its
+ * own copy of DecompApp; the only thing they share is this object:
+ *   - the value of the best integer solution found by any racer, which
+ *     every DecompAlgo uses as its cutoff (see DecompAlgo::setObjBoundIP),
+ *   - a stop flag, raised by the first racer that closes the gap, which
+ *     makes the others give up at their next check,
+ *   - which racer won and when.
+ *
+ * Readers never lock (they poll on every master iteration and every
+ * node); writers serialize through a named critical section, since they
+ * only fire when an incumbent improves or a racer finishes.
+ */
+//===========================================================================//
+
+//===========================================================================//
+#include "UtilTimer.h"
+
+//===========================================================================//
+class DecompConcurrentState {
+
+private:
+   /** Best integer objective found by any racer. */
+   double m_bestUB;
+
+   /** Racer which found m_bestUB (-1 if none). */
+   int    m_bestUBIndex;
+
+   /** Set once any racer has closed the gap. */
+   int    m_stop;
+
+   /** Racer which closed the gap first (-1 if none). */
+   int    m_winner;
+
+   /** Wallclock time (since construction) when the winner finished. */
+   double m_winnerTime;
+
+   /** Wallclock timer, started at construction. */
+   UtilTimer m_timer;
+
+public:
+   /** Value of the shared incumbent (infinity if none). */
+   inline double getBestUB() const {
+      double bestUB;
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+      bestUB = m_bestUB;
+      return bestUB;
+   }
+
+   /** True once any racer has asked the others to stop. */
+   inline bool isStopped() const {
+      int stop;
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+      stop = m_stop;
+      return stop != 0;
+   }
+
+   inline int getBestUBIndex() const {
+      return m_bestUBIndex;
+   }
+   inline int getWinner() const {
+      return m_winner;
+   }
+   inline double getWinnerTime() const {
+      return m_winnerTime;
+   }
+
+   /**
+    * Offer a new incumbent value found by racer threadIndex.
+    * Returns true if it improved the shared incumbent.
+    */
+   bool publishUB(const double thisBound,
+                  const int    threadIndex) {
+      bool improved = false;
+
+      if (thisBound >= getBestUB()) {
+         return false;
+      }
+
+#ifdef _OPENMP
+#pragma omp critical (DecompConcurrentUB)
+#endif
+      {
+         if (thisBound < m_bestUB) {
+            m_bestUBIndex = threadIndex;
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+            m_bestUB      = thisBound;
+            improved      = true;
+         }
+      }
+      return improved;
+   }
+
+   /**
+    * Racer threadIndex has closed the gap: raise the stop flag.
+    * Returns true if this racer is the winner (the first one to ask).
+    */
+   bool requestStop(const int threadIndex) {
+      bool isWinner = false;
+#ifdef _OPENMP
+#pragma omp critical (DecompConcurrentStop)
+#endif
+      {
+         if (!m_stop) {
+            m_winner     = threadIndex;
+            m_winnerTime = m_timer.getRealTime();
+            isWinner     = true;
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+            m_stop       = 1;
+         }
+      }
+      return isWinner;
+   }
+
+public:
+   DecompConcurrentState(const double infinity) :
+      m_bestUB     (infinity),
+      m_bestUBIndex(-1),
+      m_stop       (0),
+      m_winner     (-1),
+      m_winnerTime (0.0),
+      m_timer      () {
+      m_timer.start();
+   }
+
+   ~DecompConcurrentState() {}
+};
+
+#endif
@@ -85,22 +85,19 @@ void DecompConstraintSet::prepareModel(double infinity, bool modelIsCore)
       //---   for duplicates, in case the user already
       //---   provided this set
       //---
-      set<int> activeColumnsSet(activeColumns.begin(), activeColumns.end());
-      map<int, int>::const_iterator mcit;
-      activeColumns.reserve(m_sparseToOrig.size());
-
-      for (mcit  = m_sparseToOrig.begin();
-            mcit != m_sparseToOrig.end(); ++mcit) {
-         activeColumnsSet.insert(mcit->second);
-      }
-
-      set<int>::iterator sit;
+      //--- m_origSorted is already sorted and unique, so this is
+      //---   a merge rather than a set build
+      //---
+      vector<int> activeColumnsUser(activeColumns);
+      std::sort(activeColumnsUser.begin(), activeColumnsUser.end());
       activeColumns.clear();
-
-      for (sit  = activeColumnsSet.begin();
-            sit != activeColumnsSet.end(); ++sit) {
-         activeColumns.push_back(*sit);
-      }
+      activeColumns.reserve(m_origSorted.size() + activeColumnsUser.size());
+      std::set_union(m_origSorted.begin(), m_origSorted.end(),
+                     activeColumnsUser.begin(), activeColumnsUser.end(),
+                     back_inserter(activeColumns));
+      activeColumns.erase(std::unique(activeColumns.begin(),
+                                      activeColumns.end()),
+                          activeColumns.end());
    } else {
       int nActiveColumns = static_cast<int>(activeColumns.size());
 
@@ -116,15 +113,8 @@ void DecompConstraintSet::prepareModel(double infinity, bool modelIsCore)
       fixNonActiveColumns();
    }
 
-   //---
-   //--- create set from vector - easier to check overlap, etc
-   //---
    vector<int>::iterator vit;
 
-   for (vit = activeColumns.begin(); vit != activeColumns.end(); ++vit) {
-      activeColumnsS.insert(*vit);
-   }
-
    //---
    //--- set column markers (original number of cols)
    //---
@@ -305,3 +295,40 @@ CoinPackedMatrix* DecompConstraintSet::sparseToOrigMatrix()
    UTIL_DELARR(matIndOrig);
    return MOrig;
 }
+
+//===========================================================================//
+size_t DecompConstraintSet::getMemoryUsage() const
+{
+   size_t bytes = sizeof(DecompConstraintSet);
+
+   if (M) {
+      //---
+      //--- elements + indices, plus starts and lengths per major vector
+      //---
+      bytes += M->getNumElements() * (sizeof(double) + sizeof(int));
+      bytes += M->getMajorDim() * (sizeof(CoinBigIndex) + sizeof(int));
+   }
+
+   bytes += (rowLB.capacity() + rowUB.capacity() + rowRhs.capacity() +
+             colLB.capacity() + colUB.capacity()) * sizeof(double);
+   bytes += rowSense.capacity() + integerMark.capacity();
+   bytes += (integerVars.capacity() + activeColumns.capacity() +
+             masterOnlyCols.capacity() + m_sparseToOrig.capacity() +
+             m_origSorted.capacity() + m_origSortedSparse.capacity())
+            * sizeof(int);
+   vector<string>::const_iterator sit;
+
+   for (sit = rowNames.begin(); sit != rowNames.end(); ++sit) {
+      bytes += sizeof(string) + sit->capacity();
+   }
+
+   for (sit = colNames.begin(); sit != colNames.end(); ++sit) {
+      bytes += sizeof(string) + sit->capacity();
+   }
+
+   for (sit = rowHash.begin(); sit != rowHash.end(); ++sit) {
+      bytes += sizeof(string) + sit->capacity();
+   }
+
+   return bytes;
+}
@@ -44,7 +44,6 @@ public:
    std::vector<std::string>       colNames;
    std::vector<std::string>       rowNames;
    std::vector<int>          activeColumns; //if block, define the active columns
-   std::set<int>             activeColumnsS;//if block, define the active columns
    std::vector<int>          masterOnlyCols;
    bool                 prepHasRun;
 
@@ -55,10 +54,16 @@ public:
    std::vector<double      > m_rowVal;
 
    //for special case of sparse representation
+   //  m_sparseToOrig[s]   = original index of sparse column s
+   //  m_origSorted        = original indices of the block, sorted
+   //  m_origSortedSparse  = sparse index of m_origSorted[k]
+   //  these replace a pair of std::map<int,int>, which cost ~100 bytes
+   //  per active column per block and a tree walk per lookup
    bool          m_isSparse;
    int           m_numColsOrig;
-   std::map<int, int> m_origToSparse;
-   std::map<int, int> m_sparseToOrig;
+   std::vector<int> m_sparseToOrig;
+   std::vector<int> m_origSorted;
+   std::vector<int> m_origSortedSparse;
    double        m_infinity;
 
 public:
@@ -67,7 +72,7 @@ public:
       m_isSparse    = true;
    }
    inline const bool isSparse() const {
-      return m_origToSparse.size() ? true : false;
+      return m_sparseToOrig.size() ? true : false;
    };
    inline const CoinPackedMatrix* getMatrix() const {
       return M;
@@ -120,10 +125,24 @@ public:
    inline const bool     hasPrepRun() const {
       return prepHasRun;
    };
-   inline const std::map<int, int>& getMapOrigToSparse() const {
-      return m_origToSparse;
+   /** Sparse index of original column origIndex (-1 if not in block). */
+   inline const int getSparseIndex(const int origIndex) const {
+      std::vector<int>::const_iterator it =
+         std::lower_bound(m_origSorted.begin(), m_origSorted.end(),
+                          origIndex);
+
+      if (it == m_origSorted.end() || *it != origIndex) {
+         return -1;
+      }
+
+      return m_origSortedSparse[it - m_origSorted.begin()];
    };
-   inline const std::map<int, int>& getMapSparseToOrig() const {
+   /** Original index of sparse column sparseIndex. */
+   inline const int getOrigIndex(const int sparseIndex) const {
+      return m_sparseToOrig[sparseIndex];
+   };
+   /** Original index of every sparse column (indexed by sparse index). */
+   inline const std::vector<int>& getSparseToOrig() const {
       return m_sparseToOrig;
    };
    inline const std::vector<int>& getMasterOnlyCols() const {
@@ -140,6 +159,9 @@ public:
    void fixNonActiveColumns();
    CoinPackedMatrix* sparseToOrigMatrix();
 
+   /** Approximate heap memory (bytes) held by this constraint set. */
+   size_t getMemoryUsage() const;
+
    inline void appendRow(CoinPackedVector& row,
                          double             loBound,
                          double             upBound) {
@@ -180,8 +202,24 @@ public:
       assert(!(origIndex == -1 && m_isSparse));
 
       if (origIndex >= 0) {
-         m_origToSparse.insert(std::make_pair(origIndex, index));
-         m_sparseToOrig.insert(std::make_pair(index, origIndex));
+         assert(getSparseIndex(origIndex) == -1);
+         m_sparseToOrig.push_back(origIndex);
+
+         //---
+         //--- columns are almost always pushed in original order,
+         //---   so this is an append; otherwise keep the array sorted
+         //---
+         if (m_origSorted.empty() || origIndex > m_origSorted.back()) {
+            m_origSorted.push_back(origIndex);
+            m_origSortedSparse.push_back(index);
+         } else {
+            std::vector<int>::iterator it =
+               std::lower_bound(m_origSorted.begin(), m_origSorted.end(),
+                                origIndex);
+            size_t k = it - m_origSorted.begin();
+            m_origSorted.insert(it, origIndex);
+            m_origSortedSparse.insert(m_origSortedSparse.begin() + k, index);
+         }
       }
    }
 
@@ -192,6 +230,12 @@ public:
       rowUB.reserve(nRows);
       colLB.reserve(nCols);
       colUB.reserve(nCols);
+
+      if (m_isSparse) {
+         m_sparseToOrig.reserve(nCols);
+         m_origSorted.reserve(nCols);
+         m_origSortedSparse.reserve(nCols);
+      }
    }
 public:
    DecompConstraintSet() :
@@ -23,17 +23,25 @@
 #include "DecompAlgoPC.h"
 #include "DecompAlgoRC.h"
 //===========================================================================//
+#include "DecompConcurrent.h"
 #include "UtilTimer.h"
 #include <algorithm>
 #ifdef _OPENMP
 #include "omp.h"
 #endif
+#ifdef DIP_HAS_CBC
+#include "CbcEventHandler.hpp"
+#endif
 using namespace std;
 
 void blockNumberFinder(DecompParam utilParam,
                        std::vector<int>& blockNums,
                        const CoinPackedMatrix* matrix);
 
+void blockNumberScreen(const DecompApp& milp,
+                       UtilParameters& utilParam,
+                       std::vector<int>& blockNums);
+
 void DecompAuto(DecompApp milp,
                 UtilParameters& utilParam,
                 UtilTimer& timer,
@@ -41,6 +49,57 @@ void DecompAuto(DecompApp milp,
 
 DecompSolverResult* solveDirect(const DecompApp& decompApp);
 
+#ifdef DIP_HAS_CBC
+//===========================================================================//
+/**
+ * In Concurrent mode, lets the standalone branch-and-cut racer share its
+ * incumbents, use the ones found by the branch-and-price racers as its
+ * cutoff, and stop once another racer has closed the gap.
+ */
+class DecompConcurrentCbcHandler : public CbcEventHandler {
+private:
+   DecompConcurrentState* m_concurrent;
+   int                    m_threadIndex;
+
+public:
+   virtual CbcAction event(CbcEvent whichEvent) {
+      switch (whichEvent) {
+      case solution:
+      case heuristicSolution:
+         m_concurrent->publishUB(model_->getObjValue(), m_threadIndex);
+         break;
+      case node:
+         if (m_concurrent->isStopped()) {
+            return stop;
+         }
+
+         if (m_concurrent->getBestUB() < model_->getCutoff()) {
+            model_->setCutoff(m_concurrent->getBestUB());
+         }
+
+         break;
+      default:
+         break;
+      }
+
+      return noAction;
+   }
+
+   virtual CbcEventHandler* clone() const {
+      return new DecompConcurrentCbcHandler(*this);
+   }
+
+public:
+   DecompConcurrentCbcHandler(DecompConcurrentState* concurrent,
+                              const int              threadIndex) :
+      CbcEventHandler(),
+      m_concurrent   (concurrent),
+      m_threadIndex  (threadIndex) {
+   }
+   virtual ~DecompConcurrentCbcHandler() {}
+};
+#endif
+
 //===========================================================================//
 
 int main(int argc, char** argv)
@@ -54,6 +113,7 @@ int main(int argc, char** argv)
       decompMainParam.timeSetupCpu  = 0.0;
       decompMainParam.timeSolveReal = 0.0;
       decompMainParam.timeSolveCpu  = 0.0;
+      decompMainParam.stopped       = false;
 
       //---
       //--- Parse cpmmand line and store parameters
@@ -86,8 +146,15 @@ int main(int argc, char** argv)
          milp.m_param.Concurrent = false ;
          milp.m_param.NumBlocksCand = 0;
       }
-      if (milp.m_param.NumBlocksCand == 0) {
+      //---
+      //--- the candidate block numbers are taken from the row lengths,
+      //---   so the problem has to be read in first
+      //---
+      if (milp.m_param.Concurrent && milp.m_param.NumBlocksCand > 0) {
+         milp.readProblem();
+         m_matrix = milp.getMatrix();
 	 blockNumberFinder(milp.m_param, blockNumCandidates, m_matrix);
+         blockNumberScreen(milp, utilParam, blockNumCandidates);
       }
       // obtain the number of CPU (core)s on machines with operating
       // system Linux, Solaris, & AIX and Mac OS X
@@ -120,6 +187,11 @@ int main(int argc, char** argv)
             (numThreads + 1),
             utilParam);
 
+      //---
+      //--- the racers share their incumbent and a stop flag
+      //---
+      DecompConcurrentState concurrent(milp.m_infinity);
+
       if (milp.m_param.Concurrent == true ) {
          printf("===== START Concurrent Computations Process. =====\n");
 #ifdef _OPENMP
@@ -139,6 +211,7 @@ int main(int argc, char** argv)
             }
 
             milpArray[i].m_threadIndex = i;
+            milpArray[i].m_concurrent  = &concurrent;
             DecompAuto(milpArray[i], utilParamArray[i],
                        timerArray[i], decompMainParamArray[i]);
          }
@@ -154,7 +227,8 @@ int main(int argc, char** argv)
          printf("======== SUMMARY OF CONCURRENT COMPUTATIONS =======\n");
          cout << "Method" << setw(20) << "BlockNumber" << setw(20)
               << "WallClockTime" << setw(20) << "CPUTime" << setw(20)
-              << "BestLB" << setw(25) << "BestUB" << endl;
+              << "BestLB" << setw(25) << "BestUB" << setw(12)
+              << "Status" << endl;
 
          for (int i = 0 ; i < (numThreads + 1); i++) {
             if (i == 0) {
@@ -181,7 +255,26 @@ int main(int argc, char** argv)
                  << decompMainParamArray[i].bestLB
                  << setw(25) << setprecision(7)
                  << decompMainParamArray[i].bestUB
-                 << endl;
+                 << setw(12);
+
+            if (i == concurrent.getWinner()) {
+               cout << "Winner";
+            } else if (decompMainParamArray[i].stopped) {
+               cout << "Stopped";
+            } else {
+               cout << "Finished";
+            }
+
+            cout << endl;
+         }
+
+         if (concurrent.getWinner() >= 0) {
+            cout << "Racer " << concurrent.getWinner()
+                 << " closed the gap after " << setprecision(7)
+                 << concurrent.getWinnerTime()
+                 << " seconds (wallclock)." << endl;
+         } else {
+            cout << "No racer closed the gap." << endl;
          }
       }
    } catch (CoinError& ex) {
@@ -325,6 +418,173 @@ void blockNumberFinder(DecompParam decompParam,
    }
 }
 
+/*
+ *   Screening of the candidate block numbers, so that the full solves
+ *     are only started for the most promising ones.
+ */
+struct DecompBlockCand {
+   int    numBlocks;
+   int    numBlocksFound;
+   double borderFrac; // fraction of the rows left in the border
+   double imbalance;  // 1 - (rows in smallest block / rows in largest)
+   double probeLB;    // root bound after the probe
+   double score;      // smaller is better
+};
+
+void blockNumberScreen(const DecompApp& milp,
+                       UtilParameters& utilParam,
+                       std::vector<int>& blockNums)
+{
+   const DecompParam& param = milp.m_param;
+   std::sort(blockNums.begin(), blockNums.end());
+   blockNums.erase(std::unique(blockNums.begin(), blockNums.end()),
+                   blockNums.end());
+   const int numCands = static_cast<int>(blockNums.size());
+
+   if (param.BlockCandKeep <= 0 || numCands <= param.BlockCandKeep) {
+      return;
+   }
+
+   //---
+   //--- partition (and probe) every candidate on its own copy of the app
+   //---
+   std::vector<DecompBlockCand> cands(numCands);
+   UtilTimer timer;
+   timer.start();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+
+   for (int i = 0; i < numCands; i++) {
+      DecompBlockCand& cand = cands[i];
+      cand.numBlocks      = blockNums[i];
+      cand.numBlocksFound = 0;
+      cand.borderFrac     = 1.0;
+      cand.imbalance      = 1.0;
+      cand.probeLB        = -COIN_DBL_MAX;
+
+      try {
+         DecompApp      app(milp);
+         UtilParameters probeParam(utilParam);
+         app.NumBlocks                = blockNums[i];
+         app.m_threadIndex            = i + 1;
+         app.m_param.BlockFileOutput  = false;
+         app.m_param.LogLevel         = 0;
+         app.m_param.LogDebugLevel    = 0;
+         app.initializeApp();
+         //---
+         //--- border size and balance of the blocks found
+         //---
+         const int numRows = app.getMatrix()->getNumRows();
+         int       inBlocks = 0;
+         int       minRows  = numRows;
+         int       maxRows  = 0;
+         std::map<int, std::vector<int> >::const_iterator mit;
+
+         for (mit = app.m_blocks.begin(); mit != app.m_blocks.end(); ++mit) {
+            const int blockRows = static_cast<int>(mit->second.size());
+            inBlocks += blockRows;
+            minRows   = std::min(minRows, blockRows);
+            maxRows   = std::max(maxRows, blockRows);
+         }
+
+         cand.numBlocksFound = static_cast<int>(app.m_blocks.size());
+         cand.borderFrac     = numRows ?
+                               1.0 - inBlocks / static_cast<double>(numRows) : 1.0;
+         cand.imbalance      = maxRows ?
+                               1.0 - minRows / static_cast<double>(maxRows) : 1.0;
+
+         //---
+         //--- prune: a single block is no decomposition at all
+         //---
+         if (cand.numBlocksFound < 2 || param.BlockCandProbeTime <= 0) {
+            continue;
+         }
+
+         //---
+         //--- short root price-and-cut probe
+         //---
+         char probeTime[32];
+         sprintf(probeTime, "%g", param.BlockCandProbeTime);
+         probeParam.Add("PRICE_AND_CUT", "TimeLimit", probeTime);
+         probeParam.Add("PRICE_AND_CUT", "LogLevel", "0");
+         probeParam.Add("PRICE_AND_CUT", "LogDebugLevel", "0");
+         DecompAlgoPC    algo(&app, probeParam);
+         AlpsDecompModel alpsModel(probeParam, &algo);
+         alpsModel.getParam().nodeLimit = 0;
+         alpsModel.getParam().msgLevel  = 0;
+         alpsModel.solve();
+         cand.probeLB = alpsModel.getGlobalLB();
+      } catch (CoinError& ex) {
+         cand.numBlocksFound = 0;
+      }
+   }
+
+   //---
+   //--- score: border size + block balance + loss of bound against the
+   //---   best probe (relative, capped at 1); degenerate candidates last
+   //---
+   double bestLB = -COIN_DBL_MAX;
+
+   for (int i = 0; i < numCands; i++) {
+      if (cands[i].numBlocksFound >= 2) {
+         bestLB = std::max(bestLB, cands[i].probeLB);
+      }
+   }
+
+   for (int i = 0; i < numCands; i++) {
+      DecompBlockCand& cand = cands[i];
+
+      if (cand.numBlocksFound < 2) {
+         cand.score = COIN_DBL_MAX;
+         continue;
+      }
+
+      double boundLoss = 0.0;
+
+      if (bestLB > -COIN_DBL_MAX) {
+         boundLoss = cand.probeLB > -COIN_DBL_MAX ?
+                     std::min(1.0, (bestLB - cand.probeLB) /
+                              std::max(1.0, fabs(bestLB))) : 1.0;
+      }
+
+      cand.score = cand.borderFrac + 0.25 * cand.imbalance + boundLoss;
+   }
+
+   std::vector<std::pair<double, int> > ranking;
+
+   for (int i = 0; i < numCands; i++) {
+      ranking.push_back(std::make_pair(cands[i].score, i));
+   }
+
+   std::sort(ranking.begin(), ranking.end());
+   blockNums.clear();
+
+   for (int r = 0; r < numCands; r++) {
+      const DecompBlockCand& cand = cands[ranking[r].second];
+
+      if (r < param.BlockCandKeep && cand.score < COIN_DBL_MAX) {
+         blockNums.push_back(cand.numBlocks);
+      }
+
+      if (param.LogLevel >= 1) {
+         cout << "BlockCand " << setw(4) << cand.numBlocks
+              << " Found= "   << setw(4) << cand.numBlocksFound
+              << " Border= "  << setw(8) << UtilDblToStr(cand.borderFrac, 4)
+              << " Imbal= "   << setw(8) << UtilDblToStr(cand.imbalance, 4)
+              << " ProbeLB= " << setw(12) << UtilDblToStr(cand.probeLB, 4)
+              << " Score= "   << setw(8) << UtilDblToStr(cand.score, 4)
+              << (r < static_cast<int>(blockNums.size()) ? " (kept)" : "")
+              << endl;
+      }
+   }
+
+   if (param.LogLevel >= 1) {
+      cout << "Screening of " << numCands << " block candidates took "
+           << UtilDblToStr(timer.getRealTime(), 2) << " seconds" << endl;
+   }
+}
+
 void DecompAuto(DecompApp milp,
                 UtilParameters& utilParam,
                 UtilTimer& timer,
@@ -347,10 +607,33 @@ void DecompAuto(DecompApp milp,
       decompMainParam.bestUB = result->m_objUB;
       decompMainParam.timeSolveCpu  = timer.getCpuTime();
       decompMainParam.timeSolveReal = timer.getRealTime();
+
+      if (milp.m_concurrent) {
+         if (result->m_isOptimal) {
+            milp.m_concurrent->requestStop(milp.m_threadIndex);
+         } else if (milp.m_concurrent->isStopped()) {
+            decompMainParam.stopped = true;
+         }
+      }
+
       UTIL_DELPTR(result);
       return ;
    }
 
+   //---
+   //--- in a parallel tree search (ALPS:nodeThreads > 1), each thread
+   //---   works with its own copy of the application and algorithm;
+   //---   copy the application before it is initialized, as in probing
+   //---
+   const int nodeThreads = milp.m_param.Concurrent ? 1 :
+                           utilParam.GetSetting("nodeThreads", 1, "ALPS");
+   vector<DecompApp*>  workerApps;
+   vector<DecompAlgo*> workerAlgos;
+
+   for (int t = 1; t < nodeThreads; t++) {
+      workerApps.push_back(new DecompApp(milp));
+   }
+
    //---
    //--- Initialize
    //---
@@ -394,6 +677,19 @@ void DecompAuto(DecompApp milp,
       //--- create the driver AlpsDecomp model
       //---
       AlpsDecompModel alpsModel(utilParam, algo);
+
+      for (size_t t = 0; t < workerApps.size(); t++) {
+         workerApps[t]->initializeApp();
+
+         if (decompMainParam.doCut) {
+            workerAlgos.push_back(new DecompAlgoC(workerApps[t], utilParam));
+         } else {
+            workerAlgos.push_back(new DecompAlgoPC(workerApps[t], utilParam));
+         }
+
+         alpsModel.addDecompAlgo(workerAlgos.back());
+      }
+
       timer.stop();
       decompMainParam.timeSetupCpu  = timer.getCpuTime();
       decompMainParam.timeSetupReal = timer.getRealTime();
@@ -404,6 +700,18 @@ void DecompAuto(DecompApp milp,
       alpsModel.solve();
       timer.stop();
 
+      //---
+      //--- in Concurrent mode, the first racer to close the gap tells
+      //---   the others to stop
+      //---
+      if (milp.m_concurrent) {
+         if (alpsModel.isConcurrentStopped()) {
+            decompMainParam.stopped = true;
+         } else if (alpsModel.getSolStatus() == AlpsExitStatusOptimal) {
+            milp.m_concurrent->requestStop(milp.m_threadIndex);
+         }
+      }
+
       if (milp.m_param.Concurrent == 1) {
          std::cout << "====== The thread number is " << milp.m_threadIndex
                    << "====" << std::endl;
@@ -567,6 +875,9 @@ void DecompAuto(DecompApp milp,
       //---
       delete algo;
    }
+
+   UtilDeleteVectorPtr(workerAlgos);
+   UtilDeleteVectorPtr(workerApps);
 }
 
 DecompSolverResult* solveDirect(const DecompApp& decompApp)
@@ -647,12 +958,23 @@ DecompSolverResult* solveDirect(const DecompApp& decompApp)
       int logIpLevel = decompApp.m_param.LogIpLevel;
       cbc.setLogLevel(logIpLevel);
       cbc.setDblParam(CbcModel::CbcMaximumSeconds, timeLimit);
+
+      //---
+      //--- in Concurrent mode, race against the branch-and-price runs
+      //---   (status 5 means our event handler stopped the search)
+      //---
+      if (decompApp.m_concurrent) {
+         DecompConcurrentCbcHandler handler(decompApp.m_concurrent,
+                                            decompApp.m_threadIndex);
+         cbc.passInEventHandler(&handler);
+      }
+
       cbc.branchAndBound();
-      const int statusSet[2] = {0, 1};
+      const int statusSet[3] = {0, 1, 5};
       int       solStatus    = cbc.status();
       int       solStatus2   = cbc.secondaryStatus();
       
-      if (!UtilIsInSet(solStatus, statusSet, 2)) {
+      if (!UtilIsInSet(solStatus, statusSet, 3)) {
 	 cerr << "Error: CBC IP solver status = "
 	      << solStatus << endl;
 	 throw UtilException("CBC solver status", "solveDirect", "solveDirect");
@@ -667,7 +989,12 @@ DecompSolverResult* solveDirect(const DecompApp& decompApp)
       //---
       objLB = cbc.getBestPossibleObjValue();
       
-      if (cbc.isProvenOptimal() || cbc.isSecondsLimitReached()) {
+      if (result) {
+	 result->m_isOptimal = cbc.isProvenOptimal();
+      }
+
+      if (cbc.isProvenOptimal() || cbc.isSecondsLimitReached() ||
+	  solStatus == 5) {
 	 objUB = cbc.getObjValue();
 	 
 	 if (result && cbc.getSolutionCount()) {
@@ -769,6 +1096,7 @@ DecompSolverResult* solveDirect(const DecompApp& decompApp)
 				"solveDirect", "DecompAlgoC");
 	 
 	 if (result) {
+	    result->m_isOptimal = solStatus != CPXMIP_TIME_LIM_FEAS;
 	    const double* solDbl = masterSICpx->getColSolution();
 	    vector<double> solVec(solDbl, solDbl + numCols);
 	    result->m_solution.push_back(solVec);
@@ -0,0 +1,97 @@
+//===========================================================================//
+// This file is part of the DIP Solver Framework.                            //
+//                                                                           //
+// DIP is distributed under the Eclipse Public License as part of the        //
+// COIN-OR repository (http://www.coin-or.org).                              //
+//                                                                           //
+// Authors: Matthew Galati, SAS Institute Inc. (matthew.galati@sas.com)      //
+//          Ted Ralphs, Lehigh University (ted@lehigh.edu)                   //
+//          Jiadong Wang, Lehigh University (jiw508@lehigh.edu)              //
+//                                                                           //
+// Copyright (C) 2002-2018, Lehigh University, Matthew Galati, and Ted Ralphs//
+// All Rights Reserved.                                                      //
+//===========================================================================//
+
+//===========================================================================//
+#ifndef DecompMasterWarmStart_h_
+#define DecompMasterWarmStart_h_
+
+//===========================================================================//
+/**
+ * \class DecompMasterWarmStart
+ * \brief The master basis at the end of a node, in a form a child can use.
+ *
+ * Column indices in the master are not stable between nodes (compression
+ * deletes structural columns, other nodes append new ones), so the basis
+ * is stored by column identity instead of by index:
+ *   - the structural columns which were basic, by block and fingerprint
+ *     (DecompVar::getHash) - the columns themselves are not copied, one
+ *     which has been deleted since is taken back from the column archive
+ *     (if it has been evicted from there too, a slack takes its place),
+ *   - the status of the non-structural columns (artificials and
+ *     master-only), in master order - these are never deleted, so the
+ *     k-th one is the same column at every node,
+ *   - the status of the master rows - rows are never deleted, rows added
+ *     after this was recorded start with a basic slack.
+ *
+ * All other structural columns are nonbasic at their lower bound.
+ *
+ * In the parallel search each worker has its own master, with its own
+ * rows (cuts) and non-structurals in its own order, so the row and
+ * non-structural status only mean something to the master which recorded
+ * them (m_producer). Any other worker uses the basic structural columns
+ * alone, each one taking the place of the slack of one of its rows.
+ *
+ * \see DecompAlgo::getMasterWarmStart, DecompAlgo::setMasterWarmStart
+ */
+//===========================================================================//
+
+//===========================================================================//
+#include "Decomp.h"
+#include "UtilHash.h"
+
+class DecompAlgo;
+
+//===========================================================================//
+class DecompMasterWarmStart {
+
+public:
+   /** The algorithm (worker) whose master this was recorded from. */
+   const DecompAlgo* m_producer;
+
+   /** Block and fingerprint of the structural columns which were basic. */
+   std::vector< std::pair<int, UtilHashKey> > m_basicCols;
+
+   /** Status (CoinWarmStartBasis::Status) of the non-structural columns. */
+   std::vector<char> m_nonStructStatus;
+
+   /** Status (CoinWarmStartBasis::Status) of the master rows. */
+   std::vector<char> m_rowStatus;
+
+public:
+   /** Copy, so each child node owns its warm start. */
+   DecompMasterWarmStart* clone() const {
+      DecompMasterWarmStart* ws = new DecompMasterWarmStart();
+      ws->m_producer        = m_producer;
+      ws->m_basicCols       = m_basicCols;
+      ws->m_nonStructStatus = m_nonStructStatus;
+      ws->m_rowStatus       = m_rowStatus;
+      return ws;
+   }
+
+public:
+   DecompMasterWarmStart() :
+      m_producer       (NULL),
+      m_basicCols      (),
+      m_nonStructStatus(),
+      m_rowStatus      () {
+   }
+
+   ~DecompMasterWarmStart() {}
+
+private:
+   DecompMasterWarmStart(const DecompMasterWarmStart&);
+   DecompMasterWarmStart& operator=(const DecompMasterWarmStart&);
+};
+
+#endif
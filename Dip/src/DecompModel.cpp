@@ -17,10 +17,148 @@
 //===========================================================================//
 #include "DecompModel.h"
 #include "DecompSolverResult.h"
+#include "CoinWarmStart.hpp"
+#ifdef COIN_HAS_CBC
+#include "CbcEventHandler.hpp"
+#endif
 //===========================================================================//
 using namespace std;
 //===========================================================================//
 
+#ifdef COIN_HAS_CBC
+//===========================================================================//
+/**
+ * Heuristic (inexact) pricing: stops the subproblem MIP as soon as it has
+ * found solLimit solutions with objective (reduced cost) below the
+ * threshold, that is, columns with negative reduced cost. solLimit <= 0
+ * lets the MIP run to its usual limits.
+ */
+class DecompPricingCbcHandler : public CbcEventHandler {
+private:
+   double m_threshold;
+   int    m_solLimit;
+   int    m_nFound;
+
+public:
+   virtual CbcAction event(CbcEvent whichEvent) {
+      switch (whichEvent) {
+      case solution:
+      case heuristicSolution:
+         if (m_solLimit > 0 && model_->getObjValue() < m_threshold &&
+               ++m_nFound >= m_solLimit) {
+            return stop;
+         }
+
+         break;
+      default:
+         break;
+      }
+
+      return noAction;
+   }
+
+   virtual CbcEventHandler* clone() const {
+      return new DecompPricingCbcHandler(*this);
+   }
+
+public:
+   DecompPricingCbcHandler(const double threshold,
+                           const int    solLimit) :
+      CbcEventHandler(),
+      m_threshold    (threshold),
+      m_solLimit     (solLimit),
+      m_nFound       (0) {
+   }
+   virtual ~DecompPricingCbcHandler() {}
+};
+#endif
+
+//===========================================================================//
+DecompSubModel::~DecompSubModel()
+{
+   clearMIPSession();
+
+   if (m_osi) {
+      delete    m_osi;
+   }
+
+   if (m_colIndices) {
+      delete [] m_colIndices;
+   }
+}
+
+//===========================================================================//
+void DecompSubModel::clearMIPSession()
+{
+#ifdef COIN_HAS_CBC
+   UTIL_DELPTR(m_cbc);
+#endif
+   UTIL_DELPTR(m_cbcWarmStart);
+   m_mipStarts.clear();
+}
+
+//===========================================================================//
+void DecompSubModel::setBranchRows(const std::vector<DecompBranchRow>& rows)
+{
+   if (!m_osi) {
+      return;
+   }
+
+   if (m_numBaseRows < 0) {
+      m_numBaseRows = m_osi->getNumRows();
+   }
+
+   const int             nRows   = m_osi->getNumRows();
+   const int             blockId = getBlockId();
+   DecompConstraintSet* model   = getModel();
+   std::vector<DecompBranchRow>::const_iterator it;
+   int nBlockRows = 0;
+
+   for (it = rows.begin(); it != rows.end(); ++it) {
+      if (it->m_blockId == blockId) {
+         nBlockRows++;
+      }
+   }
+
+   if (nRows == m_numBaseRows && nBlockRows == 0) {
+      return;
+   }
+
+   //---
+   //--- remove the rows of the previous node, add the rows of this one
+   //---   (block-local indices if the block is sparse)
+   //---
+   if (nRows > m_numBaseRows) {
+      std::vector<int> rowsToDel(nRows - m_numBaseRows);
+      UtilIotaN(&rowsToDel[0], nRows - m_numBaseRows, m_numBaseRows);
+      m_osi->deleteRows(nRows - m_numBaseRows, &rowsToDel[0]);
+   }
+
+   for (it = rows.begin(); it != rows.end(); ++it) {
+      if (it->m_blockId != blockId) {
+         continue;
+      }
+
+      CoinPackedVector row;
+
+      for (int k = 0; k < it->getNumElements(); k++) {
+         const int j = model->isSparse() ?
+                       model->getSparseIndex(it->m_ind[k]) : it->m_ind[k];
+
+         if (j >= 0) {
+            row.insert(j, it->m_els[k]);
+         }
+      }
+
+      m_osi->addRow(row, it->m_lb, it->m_ub);
+   }
+
+   //---
+   //--- the persistent MIP session was built on the old rows
+   //---
+   clearMIPSession();
+}
+
 bool DecompSubModel::isPointFeasible(const double* x,
                                       const bool     isXSparse,
                                       const int      logLevel,
@@ -68,16 +206,14 @@ bool DecompSubModel::isPointFeasible(const double* x,
    //--- do we satisfy all (active) column bounds
    //---
    vector<int> ::const_iterator it;
-   map<int, int>::const_iterator mcit;
    const vector<int>&   activeColumns  = model->getActiveColumns();
    bool                 isSparse       = model->isSparse();
-   const map<int, int>& origToSparse   = model->getMapOrigToSparse();
-   const map<int, int>& sparseToOrig   = model->getMapSparseToOrig();
+   const vector<int>&   sparseToOrig   = model->getSparseToOrig();
 
    for (it = activeColumns.begin(); it != activeColumns.end(); ++it) {
       if (isSparse) {
-         mcit = origToSparse.find(*it);
-         c    = mcit->second;
+         c    = model->getSparseIndex(*it);
+         assert(c >= 0);
          xj   = isXSparse ? x[c] : x[*it];
       } else {
          c  = *it;
@@ -162,8 +298,7 @@ bool DecompSubModel::isPointFeasible(const double* x,
             ax = 0.0;
 
             for (i = 0; i < len; i++) {
-               mcit = sparseToOrig.find(ind[i]);
-               c    = mcit->second;
+               c    = sparseToOrig[ind[i]];
                ax  += x[c] * els[i];
             }
          }
@@ -358,7 +493,7 @@ void DecompSubModel::solveAsMIPSym(DecompSolverResult*  result,
 	   }
 	 */
 	 //We have to make sure that the solution is not one we already have
-	 if (memcmp(opt_solution, solution, numCols*DSIZE) == 0){
+	 if (memcmp(opt_solution, solution, numCols*DSIZE) != 0){
 	    vector<double> solVec(solution, solution + numCols);
 	    result->m_solution.push_back(solVec);
 	    result->m_nSolutions += 1;
@@ -382,6 +517,113 @@ void DecompSubModel::solveAsMIPSym(DecompSolverResult*  result,
 #endif
 }
 
+//===========================================================================//
+CbcModel& DecompSubModel::getMIPSessionCbc(DecompParam& param,
+                                           bool         doCutoff,
+                                           double       cutoff)
+{
+#ifdef COIN_HAS_CBC
+   //---
+   //--- without a persistent session, every call gets a fresh copy
+   //---
+   if (!param.SubProbPersistentMIP || !m_cbc) {
+      UTIL_DELPTR(m_cbc);
+      m_cbc = new CbcModel(*m_osi);
+
+      if (!param.SubProbPersistentMIP) {
+         return *m_cbc;
+      }
+
+      m_cbc->saveReferenceSolver();
+   } else {
+      //---
+      //--- go back to the clean reference model and drop the solutions
+      //---   of the last call (they were optimal for the old objective)
+      //---
+      m_cbc->resetToReferenceSolver();
+      m_cbc->deleteSolutions();
+   }
+
+   //---
+   //--- only the objective (reduced costs) and the bounds (branching)
+   //---   change between pricing calls, copy those from m_osi
+   //---
+   const int            numCols = m_osi->getNumCols();
+   const double*        objCoef = m_osi->getObjCoefficients();
+   const double*        colLB   = m_osi->getColLower();
+   const double*        colUB   = m_osi->getColUpper();
+   OsiSolverInterface* si      = m_cbc->solver();
+   si->setObjective(objCoef);
+   si->setColLower(colLB);
+   si->setColUpper(colUB);
+
+   //---
+   //--- re-solve the root LP starting from the basis of the last call
+   //---   and keep the new basis for the next one
+   //---
+   if (m_cbcWarmStart) {
+      si->setWarmStart(m_cbcWarmStart);
+   }
+
+   si->resolve();
+   UTIL_DELPTR(m_cbcWarmStart);
+   m_cbcWarmStart = si->getWarmStart();
+
+   //---
+   //--- the solutions of earlier calls are still feasible for the rows,
+   //---   pass the best one that respects the current bounds (and cutoff)
+   //---   as a MIP start
+   //---
+   int    bestStart = -1;
+   double bestObj   = doCutoff ? cutoff : COIN_DBL_MAX;
+
+   for (int s = 0; s < static_cast<int>(m_mipStarts.size()); s++) {
+      const vector<double>& sol   = m_mipStarts[s];
+      double                obj   = 0.0;
+      bool                  isFeas = true;
+
+      for (int i = 0; i < numCols; i++) {
+         if (sol[i] < colLB[i] - DecompEpsilon ||
+               sol[i] > colUB[i] + DecompEpsilon) {
+            isFeas = false;
+            break;
+         }
+
+         obj += objCoef[i] * sol[i];
+      }
+
+      if (isFeas && obj < bestObj) {
+         bestObj   = obj;
+         bestStart = s;
+      }
+   }
+
+   if (bestStart >= 0) {
+      m_cbc->setBestSolution(&m_mipStarts[bestStart][0], numCols,
+                             bestObj, true);
+   }
+
+   return *m_cbc;
+#else
+   throw UtilException("Cbc selected as solver, but it's not available",
+                       "getMIPSessionCbc", "DecompSubModel");
+#endif
+}
+
+//===========================================================================//
+void DecompSubModel::saveMIPStarts(const DecompSolverResult* result,
+                                   const DecompParam&        param)
+{
+   if (!param.SubProbPersistentMIP) {
+      return;
+   }
+
+   const int nStarts = std::min<int>(param.SubProbMIPStartLimit,
+                                     static_cast<int>(result->m_solution.size()));
+   m_mipStarts.assign(result->m_solution.begin(),
+                      result->m_solution.begin() + nStarts);
+}
+
 //===========================================================================//
 void DecompSubModel::solveAsMIPCbc(DecompSolverResult*  result,
 				   DecompParam&         param,
@@ -394,16 +636,40 @@ void DecompSubModel::solveAsMIPCbc(DecompSolverResult*  result,
 #ifdef COIN_HAS_CBC
    const int numCols    = m_osi->getNumCols();
    const int logIpLevel = param.LogIpLevel;
-   //TODO: what exactly does this do? make copy of entire model!?
-   CbcModel cbc(*m_osi);
+   //---
+   //--- either a fresh copy of the model or the persistent session
+   //---   (warm-started from the last call) if SubProbPersistentMIP
+   //---
+   CbcModel& cbc = getMIPSessionCbc(param, doCutoff, cutoff);
    cbc.setLogLevel(logIpLevel);
+   //---
+   //--- keep a pool of the best solutions found, each one is a candidate
+   //---   column (see DecompAlgo::selectVarsPerBlock)
+   //---
+   cbc.setMaximumSavedSolutions(param.SubProbNumColsPerBlock > 0 ?
+                                std::min<int>(param.SubProbNumSolLimit,
+                                              param.SubProbNumColsPerBlock) :
+                                param.SubProbNumSolLimit);
+   //---
+   //--- heuristic pricing: stop once SubProbInexactSolLimit columns with
+   //---   negative reduced cost (obj < cutoff = alpha) have been found
+   //---   (always passed in, so a persistent session drops the one of an
+   //---   earlier inexact call)
+   //---
+   DecompPricingCbcHandler pricingHandler(cutoff, doExact ? 0 :
+                                          param.SubProbInexactSolLimit);
+   cbc.passInEventHandler(&pricingHandler);
 #ifdef _OPENMP
-   cbc.setDblParam(CbcModel::CbcMaximumSeconds, timeLimit); 
+   cbc.setDblParam(CbcModel::CbcMaximumSeconds,
+                   doExact ? timeLimit :
+                   std::min<double>(timeLimit, param.SubProbTimeLimitInexact));
+   cbc.setAllowableFractionGap(doExact ? param.SubProbGapLimitExact :
+                               param.SubProbGapLimitInexact);
    cbc.branchAndBound();
-   const int statusSet[2] = {0, 1};
+   const int statusSet[3] = {0, 1, 5};
    result->m_solStatus    = cbc.status();
 
-   if (!UtilIsInSet(result->m_solStatus, statusSet, 2)) {
+   if (!UtilIsInSet(result->m_solStatus, statusSet, 3)) {
       cerr << "Error: CBC IP solver status = " << result->m_solStatus << endl;
       throw UtilException("CBC solver status",
                           "solveAsMIPCbc", "DecompSubModel");
@@ -442,10 +708,7 @@ void DecompSubModel::solveAsMIPCbc(DecompSolverResult*  result,
    } else {
       cbcTimeSet = UtilDblToStr(param.SubProbTimeLimitInexact, 
 				     -1, COIN_DBL_MAX);
-
-      cbcTimeSet = UtilDblToStr(param.SubProbTimeLimitExact, -1, 
-				COIN_DBL_MAX);
-      cbcGapSet  = UtilDblToStr(param.SubProbGapLimitExact, -1, 
+      cbcGapSet  = UtilDblToStr(param.SubProbGapLimitInexact, -1, 
 				COIN_DBL_MAX);
    } 
 
@@ -512,8 +775,8 @@ void DecompSubModel::solveAsMIPCbc(DecompSolverResult*  result,
    */
    int       nSeta = 0;
    int       nSetb = 0;
-   const int statusSet2a[4] = {0, 2, 3, 4};
-   nSeta = 4;
+   const int statusSet2a[5] = {0, 2, 3, 4, 5};
+   nSeta = 5;
    const int statusSet2b[5] = {0, 1, 2, 4, 5};
    nSetb = 5;
    result->m_solStatus2 = cbc.secondaryStatus();
@@ -599,6 +862,12 @@ void DecompSubModel::solveAsMIPCbc(DecompSolverResult*  result,
       //memcpy(result->m_solution,
       //  cbc.getColSolution(), numCols * sizeof(double));      
    }
+
+   saveMIPStarts(result, param);
+
+   if (!param.SubProbPersistentMIP) {
+      clearMIPSession();
+   }
    
 #else
       throw UtilException("Cbc selected as solver, but it's not available",
@@ -20,6 +20,10 @@
 #include "DecompParam.h"
 #include "DecompConstraintSet.h"
 #include "DecompSolverResult.h"
+#include "DecompBranchRow.h"
+
+class CbcModel;
+class CoinWarmStart;
 
 //===========================================================================//
 //naming convention - usually would do DecompModelXx, DecompModelYy
@@ -104,6 +108,29 @@ private:
    int                   m_numCols;
    int*                  m_colIndices;
    int                   m_counter;
+
+   /**
+    * Number of rows of the subproblem solver before any branching rows
+    * were added (-1 until setBranchRows is first called).
+    */
+   int                   m_numBaseRows;
+
+   /**
+    * Persistent MIP session (Cbc) kept across pricing calls when
+    * SubProbPersistentMIP is set: the solver object, the root LP basis
+    * of the last call and the last solutions (used as MIP starts).
+    */
+   CbcModel*                          m_cbc;
+   CoinWarmStart*                     m_cbcWarmStart;
+   std::vector< std::vector<double> > m_mipStarts;
+
+private:
+   CbcModel& getMIPSessionCbc(DecompParam& param,
+                              bool         doCutoff,
+                              double       cutoff);
+   void      saveMIPStarts(const DecompSolverResult* result,
+                           const DecompParam&        param);
+
 public:
 
    inline void setCounter(const int num) {
@@ -141,15 +168,21 @@ public:
       assert(m_numCols == m_osi->getNumCols());
 
       if (getModel()->isSparse()) {
+         //---
+         //--- gather the block's coefficients (original space) into
+         //---   block-local order and set them in one call
+         //---
          const DecompConstraintSet* model = getModel();
-         const std::map<int, int>& origToSparse = model->getMapOrigToSparse();
-         std::map<int, int>::const_iterator mcit;
+         const std::vector<int>& sparseToOrig = model->getSparseToOrig();
+         assert(static_cast<int>(sparseToOrig.size()) == m_numCols);
+         std::vector<double> objSparse(m_numCols);
 
-         for (mcit = origToSparse.begin();
-               mcit != origToSparse.end(); ++mcit) {
-            m_osi->setObjCoeff(mcit->second,           //sparse-index
-                               objCoeff[mcit->first]); //original-index
+         for (int i = 0; i < m_numCols; i++) {
+            objSparse[i] = objCoeff[sparseToOrig[i]];
          }
+
+         m_osi->setObjCoeffSet(m_colIndices,
+                               m_colIndices + m_numCols, &objSparse[0]);
       } else
          m_osi->setObjCoeffSet(m_colIndices,
                                m_colIndices + m_numCols, objCoeff);
@@ -166,20 +199,22 @@ public:
       //---   for e.g., in the case of one block (or sparse)
       //---
       if (model->isSparse()) {
-         const std::map<int, int>& origToSparse = model->getMapOrigToSparse();
-         std::map<int, int>::const_iterator mcit;
-
-         for (mcit  = origToSparse.begin();
-               mcit != origToSparse.end(); ++mcit) {
-            m_osi->setColLower(mcit->second,        //sparse-index
-                               colLB[mcit->first]); //original-index
-            m_osi->setColUpper(mcit->second,        //sparse-index
-                               colUB[mcit->first]); //original-index
-            //printf("setColBounds orig:%d sparse:%d lb:%g ub:%g\n",
-            //   mcit->first, mcit->second,
-            //   colLB[mcit->first],
-            //   colUB[mcit->first]);
+         //---
+         //--- bounds are in original space, the block is in block-local
+         //---   space: gather (lb,ub) pairs and set them in one call
+         //---
+         const std::vector<int>& sparseToOrig = model->getSparseToOrig();
+         const int nColsSparse = static_cast<int>(sparseToOrig.size());
+         std::vector<double> bounds(2 * nColsSparse);
+         assert(nColsSparse == m_numCols);
+
+         for (int i = 0; i < nColsSparse; i++) {
+            bounds[2 * i]     = colLB[sparseToOrig[i]];
+            bounds[2 * i + 1] = colUB[sparseToOrig[i]];
          }
+
+         m_osi->setColSetBounds(m_colIndices,
+                                m_colIndices + nColsSparse, &bounds[0]);
       } else {
          if (activeColumns.size()) {
             std::vector<int>::iterator vi;
@@ -233,6 +268,15 @@ public:
       return m_osi;
    }
 
+   /** Drop the persistent MIP session (e.g., after the model changed). */
+   void clearMIPSession();
+
+   /**
+    * Replace the branching rows in the subproblem solver by the rows of
+    *   rows which belong to this block (original space).
+    */
+   void setBranchRows(const std::vector<DecompBranchRow>& rows);
+
 public:
    void solveAsMIP(DecompSolverResult*  result,
 		   DecompParam&         param,
@@ -255,7 +299,11 @@ public:
       m_osi         (NULL),
       m_numCols     (0   ),
       m_colIndices  (NULL),
-      m_counter     ( 0 )
+      m_counter     ( 0 ),
+      m_numBaseRows (-1),
+      m_cbc         (NULL),
+      m_cbcWarmStart(NULL),
+      m_mipStarts   ()
    {};
 
    DecompSubModel& operator=(const DecompModel& rhs) {
@@ -279,7 +327,11 @@ public:
       m_osi         (NULL),
       m_numCols     (0   ),
       m_colIndices  (NULL),
-      m_counter     (0)
+      m_counter     (0),
+      m_numBaseRows (-1),
+      m_cbc         (NULL),
+      m_cbcWarmStart(NULL),
+      m_mipStarts   ()
    {};
    DecompSubModel(DecompConstraintSet* model,
                   std::string          modelName,
@@ -289,17 +341,13 @@ public:
       m_osi         (NULL),
       m_numCols     (0   ),
       m_colIndices  (NULL),
-      m_counter     (0)
+      m_counter     (0),
+      m_numBaseRows (-1),
+      m_cbc         (NULL),
+      m_cbcWarmStart(NULL),
+      m_mipStarts   ()
    {};
-   ~DecompSubModel() {
-      if (m_osi) {
-         delete    m_osi;
-      }
-
-      if (m_colIndices) {
-         delete [] m_colIndices;
-      }
-   }
+   ~DecompSubModel();
 };
 
 #endif
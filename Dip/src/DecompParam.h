@@ -95,6 +95,12 @@ public:
    double CompressColumnsSizeMultLimit;
    //do not start compression until master gap is within this limit
    double CompressColumnsMasterGapStart;
+   //memory (MB) for the archive of compressed columns, which is priced
+   //  before the subproblems (0 = do not archive)
+   double ColArchiveMaxMB;
+   //max number of archived columns taken back per block in one call,
+   //  the most negative reduced cost ones (0 = all with negative rc)
+   int    ColArchiveMaxPerBlock;
    int    CutDC;
    int    CutCGL;
 
@@ -111,6 +117,13 @@ public:
    double SubProbGapLimitInexact;
    double SubProbTimeLimitExact;
    double SubProbTimeLimitInexact;
+
+   //n > 0: heuristic pricing during the first IterLimitInexactSubSolving
+   //       rounds of a node, the subproblem MIP stops as soon as it has
+   //       found n columns with negative reduced cost; a round which finds
+   //       none is repeated with exact pricing (n = 0: exact only)
+
+   int    SubProbInexactSolLimit;
    // Notice:
    // NumConcurrentThreadsSubProb:  available thread number for parallelizing subproblems
    // NumThreadsIPSolver:  thread number for solving each IP subproblem
@@ -120,6 +133,27 @@ public:
 
    int    SubProbNumSolLimit;
 
+   //Each pricing round, keep at most SubProbNumColsPerBlock columns with
+   //  negative reduced cost per block (0 = no limit), the most negative
+   //  first, skipping columns whose cosine with a column already kept
+   //  for the block is > SubProbColsParallelLimit (1.0 = duplicates only)
+
+   int    SubProbNumColsPerBlock;
+   double SubProbColsParallelLimit;
+
+   //n = 0: price all blocks with a barrier (default)
+   //n > 0: asynchronous pricing, return to the master as soon as n blocks
+   //       have found columns with negative reduced cost (Phase II only)
+
+   int    SubProbAsyncBlockLimit;
+
+   //Keep one MIP session (Cbc) per block alive across pricing calls,
+   //  re-solve the root LP from the last basis and pass the last
+   //  SubProbMIPStartLimit solutions back as MIP starts
+
+   bool   SubProbPersistentMIP;
+   int    SubProbMIPStartLimit;
+
    //This option only works with Cpx:
    // DecompDualSimplex = 0,
    // DecompPrimSimplex = 1,
@@ -137,8 +171,13 @@ public:
    //0:RoundRobinRotate:    rotate through blocks in order 0...numBlocks-1
    //1:RoundRobinMostNegRC: choose the block with most neg reduced cost
    //(in last iter)
+   //2:RoundRobinAdaptive:  in between the full passes, price the fraction
+   //  RoundRobinBlockFrac of the blocks with the best expected improvement
+   //  per second (from the history of each block), unless the user picks
+   //  the blocks (DecompApp::solveRelaxedWhich)
 
    int    RoundRobinStrategy;
+   double RoundRobinBlockFrac;
 
    //solve master as IP at end of each node (this should only be done
    //  if there are more than one blocks)
@@ -176,9 +215,28 @@ public:
 
    int    InitCompactSolve;
 
-   bool    DualStab;
+   //dual stabilization (PC, Phase II only)
+   //0:DualStabNone
+   //1:DualStabWentges: price at alpha * center + (1 - alpha) * masterDual,
+   //  alpha = DualStabAlpha
+   //2:DualStabInOut:   as 1, but alpha is adjusted after each pricing call
+   //  from the direction of the subgradient (starting at DualStabAlpha)
+   //3:DualStabBoxStep: keep the master duals in a box of half-width
+   //  DualStabBoxWidth * (1 + |center|) around the center
+   //4:DualStabPenalty: as 3, but leaving the box is penalized instead of
+   //  forbidden (at most DualStabBoxPenalty of surplus per row)
+   //The center moves to the pricing duals whenever they improve the
+   //  Lagrangian bound. A pricing call which finds no column only because
+   //  of the stabilization (a mis-price) is repeated with a weaker one;
+   //  after DualStabMaxMisprice mis-prices in a row, it is dropped for
+   //  the rest of the node.
+
+   int    DualStab;
    double DualStabAlpha;
    double DualStabAlphaOrig;
+   double DualStabBoxWidth;
+   double DualStabBoxPenalty;
+   int    DualStabMaxMisprice;
 
    bool    BreakOutPartial; //DISABLED for now
 
@@ -205,6 +263,62 @@ public:
 
    int    BranchStrongIter;
 
+   /**
+    * Rule to choose the branching variable (x-space):
+    *   0: most fractional,
+    *   1: pseudo-cost (learned from the bound change of the children),
+    *   2: reliability (pseudo-cost, with strong branching on the
+    *      candidates whose pseudo-costs are not yet reliable).
+    * The score of a candidate is the product of its estimated down
+    * and up bound gains.
+    */
+   int    BranchRule;
+
+   /**
+    * Reliability branching: number of observations, in each direction,
+    * after which the pseudo-cost of a variable is trusted.
+    */
+   int    BranchReliability;
+
+   /**
+    * Reliability branching: maximum number of unreliable candidates
+    * (best by pseudo-cost score first) evaluated by strong branching.
+    */
+   int    BranchStrongCand;
+
+   /**
+    * Reliability branching: number of price (PC) or cut (CPM) iterations
+    * to process each child in strong branching.
+    */
+   int    BranchStrongCandIter;
+
+   /**
+    * Branching object tried before the variables (PC only); the
+    * variables are branched on if it finds none:
+    *   0: none,
+    *   1: Ryan-Foster, on a pair of set partitioning rows covered
+    *      fractionally by the same master columns (needs
+    *      BranchEnforceInSubProb),
+    *   2: the sum of the integer x's of a block.
+    * Objects given by DecompApp::APPchooseBranchRows come first.
+    */
+   int    BranchRowRule;
+
+   /**
+    * Start the first master solve of each node from the parent's basis,
+    * re-adding the parent's basic columns if they have been compressed
+    * out since (PC only).
+    */
+   int    NodeWarmStart;
+
+   /**
+    * Reduced cost fixing at the end of each node: tighten the bounds of
+    * the integer columns whose Lagrangian reduced cost exceeds the gap
+    * between the node bound and the incumbent. The node's children
+    * inherit the new bounds.
+    */
+   int    RedCostFixing;
+
    /**
     * Number of threads to use in DIP.
     *
@@ -285,6 +399,14 @@ public:
    // number of block candidates
    int NumBlocksCand;
 
+   // number of block candidates kept for the full solves after
+   // screening them all (0 = keep all, no screening)
+   int BlockCandKeep;
+
+   // time limit (seconds) of the root price-and-cut probe used to
+   // screen each block candidate (0 = no probe)
+   double BlockCandProbeTime;
+
    // time of concurrent CutOffTime to finalize
    // the choice of MILP solution method
 
@@ -303,6 +425,16 @@ public:
 
    int BlockNumInput;
 
+   // Hypergraph partitioner used for automatic block detection:
+   //   "Native" (built in), "hMetis" or "PaToH" (need to be linked in)
+   std::string HypergraphPartitioner;
+
+   // Allowed imbalance (%) of each bisection, as hMetis' ubfactor
+   int HypergraphUBFactor;
+
+   // Threads used by the native partitioner (0 = number of cores)
+   int HypergraphNumThreads;
+
    bool BlockFileOutput;
 
    // The tolerance for checking negative reduced cost
@@ -403,6 +535,8 @@ public:
       PARAM_getSetting("CompressColumnsSizeMultLimit",  CompressColumnsSizeMultLimit);
       PARAM_getSetting("CompressColumnsMasterGapStart",
                        CompressColumnsMasterGapStart);
+      PARAM_getSetting("ColArchiveMaxMB",      ColArchiveMaxMB);
+      PARAM_getSetting("ColArchiveMaxPerBlock", ColArchiveMaxPerBlock);
       PARAM_getSetting("CutDC",                CutDC);
       PARAM_getSetting("CutCGL",               CutCGL);
       PARAM_getSetting("CutCglKnapC",          CutCglKnapC);
@@ -416,12 +550,19 @@ public:
       PARAM_getSetting("SubProbGapLimitInexact", SubProbGapLimitInexact);
       PARAM_getSetting("SubProbTimeLimitExact",  SubProbTimeLimitExact);
       PARAM_getSetting("SubProbTimeLimitInexact", SubProbTimeLimitInexact);
+      PARAM_getSetting("SubProbInexactSolLimit", SubProbInexactSolLimit);
       PARAM_getSetting("NumConcurrentThreadsSubProb", NumConcurrentThreadsSubProb);
       PARAM_getSetting("NumThreadsIPSolver", NumThreadsIPSolver);
       PARAM_getSetting("SubProbNumSolLimit",     SubProbNumSolLimit);
+      PARAM_getSetting("SubProbNumColsPerBlock", SubProbNumColsPerBlock);
+      PARAM_getSetting("SubProbColsParallelLimit", SubProbColsParallelLimit);
+      PARAM_getSetting("SubProbAsyncBlockLimit", SubProbAsyncBlockLimit);
+      PARAM_getSetting("SubProbPersistentMIP",   SubProbPersistentMIP);
+      PARAM_getSetting("SubProbMIPStartLimit",   SubProbMIPStartLimit);
       PARAM_getSetting("SubProbSolverStartAlgo", SubProbSolverStartAlgo);
       PARAM_getSetting("RoundRobinInterval",   RoundRobinInterval);
       PARAM_getSetting("RoundRobinStrategy",   RoundRobinStrategy);
+      PARAM_getSetting("RoundRobinBlockFrac",  RoundRobinBlockFrac);
       PARAM_getSetting("SolveMasterAsMip",      SolveMasterAsMip);
       PARAM_getSetting("SolveMasterAsMipFreqNode", SolveMasterAsMipFreqNode);
       PARAM_getSetting("SolveMasterAsMipFreqPass", SolveMasterAsMipFreqPass);
@@ -435,12 +576,22 @@ public:
       PARAM_getSetting("InitCompactSolve",     InitCompactSolve);
       PARAM_getSetting("DualStab",             DualStab);
       PARAM_getSetting("DualStabAlpha",        DualStabAlpha);
+      PARAM_getSetting("DualStabBoxWidth",     DualStabBoxWidth);
+      PARAM_getSetting("DualStabBoxPenalty",   DualStabBoxPenalty);
+      PARAM_getSetting("DualStabMaxMisprice",  DualStabMaxMisprice);
       PARAM_getSetting("BreakOutPartial",      BreakOutPartial);
       PARAM_getSetting("BranchEnforceInSubProb",  BranchEnforceInSubProb);
       PARAM_getSetting("BranchEnforceInMaster",   BranchEnforceInMaster);
       PARAM_getSetting("MasterConvexityLessThan", MasterConvexityLessThan);
       PARAM_getSetting("ParallelColsLimit",       ParallelColsLimit);
       PARAM_getSetting("BranchStrongIter",        BranchStrongIter);
+      PARAM_getSetting("BranchRule",              BranchRule);
+      PARAM_getSetting("BranchReliability",       BranchReliability);
+      PARAM_getSetting("BranchStrongCand",        BranchStrongCand);
+      PARAM_getSetting("BranchStrongCandIter",    BranchStrongCandIter);
+      PARAM_getSetting("BranchRowRule",           BranchRowRule);
+      PARAM_getSetting("NodeWarmStart",           NodeWarmStart);
+      PARAM_getSetting("RedCostFixing",           RedCostFixing);
       PARAM_getSetting("DebugCheckBlocksColumns", DebugCheckBlocksColumns);
       PARAM_getSetting("DataDir",          DataDir);
       PARAM_getSetting("Instance",         Instance);
@@ -459,8 +610,13 @@ public:
       PARAM_getSetting("ColumnLB", ColumnLB);
       PARAM_getSetting("ObjectiveSense", ObjectiveSense);
       PARAM_getSetting("BlockNumInput", BlockNumInput);
+      PARAM_getSetting("HypergraphPartitioner", HypergraphPartitioner);
+      PARAM_getSetting("HypergraphUBFactor", HypergraphUBFactor);
+      PARAM_getSetting("HypergraphNumThreads", HypergraphNumThreads);
       PARAM_getSetting("Concurrent", Concurrent);
       PARAM_getSetting("NumBlocksCand", NumBlocksCand);
+      PARAM_getSetting("BlockCandKeep", BlockCandKeep);
+      PARAM_getSetting("BlockCandProbeTime", BlockCandProbeTime);
       PARAM_getSetting("CconcurrentCutOffTime", ConcurrentCutOffTime);
       PARAM_getSetting("CurrentWorkingDir", CurrentWorkingDir);
       PARAM_getSetting("SubProbParallel", SubProbParallel);
@@ -543,6 +699,9 @@ public:
                          CompressColumnsSizeMultLimit);
       UtilPrintParameter(os, sec, "CompressColumnsMasterGapStart",
                          CompressColumnsMasterGapStart);
+      UtilPrintParameter(os, sec, "ColArchiveMaxMB",     ColArchiveMaxMB);
+      UtilPrintParameter(os, sec, "ColArchiveMaxPerBlock",
+                         ColArchiveMaxPerBlock);
       UtilPrintParameter(os, sec, "CutDC",               CutDC);
       UtilPrintParameter(os, sec, "CutCGL",              CutCGL);
       UtilPrintParameter(os, sec, "CutCglKnapC",         CutCglKnapC);
@@ -560,14 +719,27 @@ public:
                          SubProbTimeLimitExact);
       UtilPrintParameter(os, sec, "SubProbTimeLimitInexact",
                          SubProbTimeLimitInexact);
+      UtilPrintParameter(os, sec, "SubProbInexactSolLimit",
+                         SubProbInexactSolLimit);
       UtilPrintParameter(os, sec, "NumConcurrentThreadsSubProb",
                          NumConcurrentThreadsSubProb);
       UtilPrintParameter(os, sec, "NumThreadsIPSolver",  NumThreadsIPSolver);
       UtilPrintParameter(os, sec, "SubProbNumSolLimit", SubProbNumSolLimit);
+      UtilPrintParameter(os, sec, "SubProbNumColsPerBlock",
+                         SubProbNumColsPerBlock);
+      UtilPrintParameter(os, sec, "SubProbColsParallelLimit",
+                         SubProbColsParallelLimit);
+      UtilPrintParameter(os, sec, "SubProbAsyncBlockLimit",
+                         SubProbAsyncBlockLimit);
+      UtilPrintParameter(os, sec, "SubProbPersistentMIP",
+                         SubProbPersistentMIP);
+      UtilPrintParameter(os, sec, "SubProbMIPStartLimit",
+                         SubProbMIPStartLimit);
       UtilPrintParameter(os, sec, "SubProbSolverStartAlgo",
                          SubProbSolverStartAlgo);
       UtilPrintParameter(os, sec, "RoundRobinInterval",  RoundRobinInterval);
       UtilPrintParameter(os, sec, "RoundRobinStrategy",  RoundRobinStrategy);
+      UtilPrintParameter(os, sec, "RoundRobinBlockFrac", RoundRobinBlockFrac);
       UtilPrintParameter(os, sec, "SolveMasterAsMip",     SolveMasterAsMip);
       UtilPrintParameter(os, sec, "SolveMasterAsMipFreqNode",
                          SolveMasterAsMipFreqNode);
@@ -587,6 +759,10 @@ public:
       UtilPrintParameter(os, sec, "InitCompactSolve",  InitCompactSolve);
       UtilPrintParameter(os, sec, "DualStab",          DualStab);
       UtilPrintParameter(os, sec, "DualStabAlpha",     DualStabAlpha);
+      UtilPrintParameter(os, sec, "DualStabBoxWidth",  DualStabBoxWidth);
+      UtilPrintParameter(os, sec, "DualStabBoxPenalty", DualStabBoxPenalty);
+      UtilPrintParameter(os, sec, "DualStabMaxMisprice",
+                         DualStabMaxMisprice);
       UtilPrintParameter(os, sec, "BreakOutPartial",   BreakOutPartial);
       UtilPrintParameter(os, sec, "BranchEnforceInSubProb",
                          BranchEnforceInSubProb);
@@ -596,6 +772,14 @@ public:
                          MasterConvexityLessThan);
       UtilPrintParameter(os, sec, "ParallelColsLimit", ParallelColsLimit);
       UtilPrintParameter(os, sec, "BranchStrongIter",  BranchStrongIter);
+      UtilPrintParameter(os, sec, "BranchRule",        BranchRule);
+      UtilPrintParameter(os, sec, "BranchReliability", BranchReliability);
+      UtilPrintParameter(os, sec, "BranchStrongCand",  BranchStrongCand);
+      UtilPrintParameter(os, sec,
+                         "BranchStrongCandIter", BranchStrongCandIter);
+      UtilPrintParameter(os, sec, "BranchRowRule",     BranchRowRule);
+      UtilPrintParameter(os, sec, "NodeWarmStart",     NodeWarmStart);
+      UtilPrintParameter(os, sec, "RedCostFixing",     RedCostFixing);
       UtilPrintParameter(os, sec,
                          "DebugCheckBlocksColumns", DebugCheckBlocksColumns);
       UtilPrintParameter(os, sec, "LogLevel",  LogLevel);
@@ -616,6 +800,8 @@ public:
       UtilPrintParameter(os, sec, "ObjectiveSense",  ObjectiveSense);
       UtilPrintParameter(os, sec, "Concurrent", Concurrent);
       UtilPrintParameter(os, sec, "NumBlocksCand", NumBlocksCand);
+      UtilPrintParameter(os, sec, "BlockCandKeep", BlockCandKeep);
+      UtilPrintParameter(os, sec, "BlockCandProbeTime", BlockCandProbeTime);
       UtilPrintParameter(os, sec, "ConcurrentCutOffTime", ConcurrentCutOffTime);
       UtilPrintParameter(os, sec,  "CurrentWorkingDir", CurrentWorkingDir);
       UtilPrintParameter(os, sec, "SubProbParallel", SubProbParallel);
@@ -624,6 +810,11 @@ public:
                          SubProbParallelChunksize);
       UtilPrintParameter(os, sec, "ConcurrentThreadsNum", ConcurrentThreadsNum);
       UtilPrintParameter(os, sec, "BlockNumInput", BlockNumInput);
+      UtilPrintParameter(os, sec, "HypergraphPartitioner",
+                         HypergraphPartitioner);
+      UtilPrintParameter(os, sec, "HypergraphUBFactor", HypergraphUBFactor);
+      UtilPrintParameter(os, sec, "HypergraphNumThreads",
+                         HypergraphNumThreads);
       UtilPrintParameter(os, sec, "BlockFileOutput", BlockFileOutput );
       UtilPrintParameter(os, sec, "RedCostEpsilon", RedCostEpsilon);
       UtilPrintParameter(os, sec, "PhaseIObjTol", PhaseIObjTol);
@@ -671,6 +862,8 @@ public:
       CompressColumnsIterFreq       = 2;
       CompressColumnsSizeMultLimit  = 1.20;
       CompressColumnsMasterGapStart = 0.20;
+      ColArchiveMaxMB               = 64.0;
+      ColArchiveMaxPerBlock         = 10;
       CutDC                = 0;
       CutCGL               = 0;
       CutCglKnapC          = 1;
@@ -684,12 +877,19 @@ public:
       SubProbGapLimitInexact = 0.1;    //10.00% gap
       SubProbTimeLimitExact   = DecompBigNum;
       SubProbTimeLimitInexact = DecompBigNum;
+      SubProbInexactSolLimit  = 0;
       NumConcurrentThreadsSubProb       = 4;
       NumThreadsIPSolver             = 1;
       SubProbNumSolLimit      = 10001;
+      SubProbNumColsPerBlock  = 10;
+      SubProbColsParallelLimit = 0.99;
+      SubProbAsyncBlockLimit  = 0;
+      SubProbPersistentMIP    = false;
+      SubProbMIPStartLimit    = 5;
       SubProbSolverStartAlgo = DecompDualSimplex;
       RoundRobinInterval   = 0;
       RoundRobinStrategy   = RoundRobinRotate;
+      RoundRobinBlockFrac  = 0.10;
       SolveMasterAsMip          = 1;//TODO: turn off if one block
       SolveMasterAsMipFreqNode  = 1;
       SolveMasterAsMipFreqPass  = 1000;
@@ -703,12 +903,22 @@ public:
       InitCompactSolve         = 0;
       DualStab                 = 0;
       DualStabAlpha            = 0.10;
+      DualStabBoxWidth         = 0.10;
+      DualStabBoxPenalty       = 1.0;
+      DualStabMaxMisprice      = 5;
       BreakOutPartial          = 0;
       BranchEnforceInSubProb   = 1;//usually much better if can
       BranchEnforceInMaster    = 0;
       MasterConvexityLessThan  = 0;
       ParallelColsLimit        = 1.0;
       BranchStrongIter         = 0;
+      BranchRule               = 0;
+      BranchReliability        = 4;
+      BranchStrongCand         = 8;
+      BranchStrongCandIter     = 5;
+      BranchRowRule            = 0;
+      NodeWarmStart            = 1;
+      RedCostFixing            = 1;
       DebugCheckBlocksColumns  = false;
       /*
        * parameters from MILPBlock and to be MILP
@@ -731,6 +941,8 @@ public:
       ObjectiveSense           = 1;
       Concurrent               = false;
       NumBlocksCand            = 4;
+      BlockCandKeep            = 2;
+      BlockCandProbeTime       = 1.0;
       ConcurrentCutOffTime     = 100;
       CurrentWorkingDir        = "";
       SubProbParallel          = true;
@@ -738,6 +950,9 @@ public:
       SubProbParallelChunksize = 1;
       ConcurrentThreadsNum     = 4;
       BlockNumInput            = 0;
+      HypergraphPartitioner    = "Native";
+      HypergraphUBFactor       = 5;
+      HypergraphNumThreads     = 0;
       BlockFileOutput          = true;
       RedCostEpsilon           = 0.0001;
       PhaseIObjTol             = 0.0005;
@@ -0,0 +1,128 @@
+//===========================================================================//
+// This file is part of the DIP Solver Framework.                            //
+//                                                                           //
+// DIP is distributed under the Eclipse Public License as part of the        //
+// COIN-OR repository (http://www.coin-or.org).                              //
+//                                                                           //
+// Authors: Matthew Galati, SAS Institute Inc. (matthew.galati@sas.com)      //
+//          Ted Ralphs, Lehigh University (ted@lehigh.edu)                   //
+//          Jiadong Wang, Lehigh University (jiw508@lehigh.edu)              //
+//                                                                           //
+// Copyright (C) 2002-2018, Lehigh University, Matthew Galati, Ted Ralphs    //
+// All Rights Reserved.                                                      //
+//===========================================================================//
+
+#ifndef DECOMP_PSEUDO_COST_INCLUDE
+#define DECOMP_PSEUDO_COST_INCLUDE
+
+//===========================================================================//
+/**
+ * \class DecompPseudoCost
+ * \brief Pseudo-costs of the integer columns (original space).
+ *
+ * The pseudo-cost of column j in one direction is the average gain in the
+ * node bound per unit of change of x[j], over the children (or strong
+ * branching evaluations) which branched on j in that direction. A column
+ * which has not been observed in a direction gets the average pseudo-cost
+ * of all the columns observed in that direction (1.0 if there are none).
+ *
+ * \see DecompAlgo::chooseBranchSet, DecompAlgo::updatePseudoCost
+ */
+//===========================================================================//
+#include "Decomp.h"
+
+//===========================================================================//
+class DecompPseudoCost {
+
+private:
+   /** Sum of the gains per unit, and number of observations, by column. */
+   std::vector<double> m_sumDown;
+   std::vector<double> m_sumUp;
+   std::vector<int>    m_numDown;
+   std::vector<int>    m_numUp;
+
+   /** Sum of the gains per unit, and number of observations, overall. */
+   double              m_totDown;
+   double              m_totUp;
+   int                 m_totNumDown;
+   int                 m_totNumUp;
+
+public:
+   void resize(const int nCols) {
+      m_sumDown.resize(nCols, 0.0);
+      m_sumUp.resize(nCols, 0.0);
+      m_numDown.resize(nCols, 0);
+      m_numUp.resize(nCols, 0);
+   }
+
+   /**
+    * Record the gain per unit of change of column j in direction dir
+    * (-1 down, 1 up).
+    */
+   void update(const int    j,
+               const int    dir,
+               const double gain) {
+      if (dir < 0) {
+         m_sumDown[j] += gain;
+         m_numDown[j]++;
+         m_totDown    += gain;
+         m_totNumDown++;
+      } else {
+         m_sumUp[j]   += gain;
+         m_numUp[j]++;
+         m_totUp      += gain;
+         m_totNumUp++;
+      }
+   }
+
+   inline double getDown(const int j) const {
+      if (m_numDown[j]) {
+         return m_sumDown[j] / m_numDown[j];
+      }
+
+      return m_totNumDown ? m_totDown / m_totNumDown : 1.0;
+   }
+
+   inline double getUp(const int j) const {
+      if (m_numUp[j]) {
+         return m_sumUp[j] / m_numUp[j];
+      }
+
+      return m_totNumUp ? m_totUp / m_totNumUp : 1.0;
+   }
+
+   /** Number of observations of column j in its least observed direction. */
+   inline int getNumReliable(const int j) const {
+      return std::min(m_numDown[j], m_numUp[j]);
+   }
+
+   /**
+    * Product rule: the score of a branching candidate whose children are
+    * expected to raise the bound by gainDown and gainUp.
+    */
+   static inline double score(const double gainDown,
+                              const double gainUp) {
+      const double eps = 1.0e-6;
+      return std::max(gainDown, eps) * std::max(gainUp, eps);
+   }
+
+public:
+   DecompPseudoCost() :
+      m_sumDown   (),
+      m_sumUp     (),
+      m_numDown   (),
+      m_numUp     (),
+      m_totDown   (0.0),
+      m_totUp     (0.0),
+      m_totNumDown(0),
+      m_totNumUp  (0) {
+   }
+
+   ~DecompPseudoCost() {}
+
+private:
+   DecompPseudoCost(const DecompPseudoCost&);
+   DecompPseudoCost& operator=(const DecompPseudoCost&);
+};
+
+#endif
@@ -29,16 +29,26 @@ bool DecompVar::doesSatisfyBounds(int                     denseLen,
                                   const double*           lbs,
                                   const double*           ubs)
 {
-   int            j;
+   int            i, j;
+   bool           isFeas = true;
    vector<int> ::const_iterator it;
-   map<int, int>::const_iterator mcit;
    DecompConstraintSet* modelRelax    = model.getModel();
    const vector<int>&   activeColumns  = modelRelax->getActiveColumns();
+   const int            sz             = m_s.getNumElements();
+   const int*           inds           = m_s.getIndices();
+   const double*        elems          = m_s.getElements();
    //---
    //--- activeColumns are in original space
    //---    denseArr, lbs, ubs are all in original space
    //---
-   fillDenseArr(denseLen, denseArr);//TODO: expensive...
+   //--- denseArr must be all zero on entry: only the nonzeros of s are
+   //---   scattered in (and cleared again on exit), so the cost is in
+   //---   the size of the block, not in the number of columns
+   //---
+   for (i = 0; i < sz; ++i) {
+      assert(inds[i] < denseLen);
+      denseArr[inds[i]] = elems[i];
+   }
 
    for (it = activeColumns.begin(); it != activeColumns.end(); ++it) {
       j  = *it;
@@ -46,11 +56,16 @@ bool DecompVar::doesSatisfyBounds(int                     denseLen,
 
       if (xj < (lbs[j] - DecompEpsilon) ||
             xj > (ubs[j] + DecompEpsilon)) {
-         return false;
+         isFeas = false;
+         break;
       }
    }
 
-   return true;
+   for (i = 0; i < sz; ++i) {
+      denseArr[inds[i]] = 0.0;
+   }
+
+   return isFeas;
 }
 
 // --------------------------------------------------------------------- //
@@ -38,7 +38,7 @@ private:
    double           m_origCost;
    double           m_redCost; //(c - uA'')s - alpha
    int              m_effCnt;  //effectiveness counter
-   std::string           m_strHash;
+   UtilHashKey      m_hash;    //numeric fingerprint of m_s
    int              m_blockId;
    int              m_colMasterIndex;
    double           m_norm;
@@ -62,8 +62,8 @@ public:
    inline double getUpperBound()     const {
       return COIN_DBL_MAX;   //TODO
    }
-   inline std::string getStrHash()        const {
-      return m_strHash;
+   inline UtilHashKey getHash()      const {
+      return m_hash;
    }
    inline int    getBlockId()        const {
       return m_blockId;
@@ -115,6 +115,13 @@ public:
       m_s.sortIncrIndex();
    }
 
+   /** Recompute the fingerprint of m_s (assumes m_s is sorted). */
+   inline UtilHashKey calcHash() {
+      return m_hash = UtilCreateNumericHash(m_s.getNumElements(),
+                                            m_s.getIndices(),
+                                            m_s.getElements());
+   }
+
    bool   isEquivalent(const DecompVar& dvar) {
       return m_s.isEquivalent(dvar.m_s);
    }
@@ -123,7 +130,7 @@ public:
       DecompVarList::const_iterator vi;
 
       for (vi = vars.begin(); vi != vars.end(); ++vi) {
-         if ((*vi)->getStrHash() == this->getStrHash()) {
+         if ((*vi)->getHash() == this->getHash()) {
             return true;
          }
       }
@@ -156,7 +163,7 @@ public:
       m_varType (source.m_varType),
       m_origCost(source.m_origCost),
       m_effCnt  (source.m_effCnt),
-      m_strHash (source.m_strHash),
+      m_hash    (source.m_hash),
       m_blockId (source.m_blockId),
       m_colMasterIndex (source.m_colMasterIndex),
       m_norm    (source.m_norm) {
@@ -169,7 +176,7 @@ public:
          m_origCost = rhs.m_origCost;
          m_redCost  = rhs.m_redCost;
          m_effCnt   = rhs.m_effCnt;
-         m_strHash  = rhs.m_strHash;
+         m_hash     = rhs.m_hash;
          m_blockId  = rhs.m_blockId;
          m_colMasterIndex = rhs.m_colMasterIndex;
       }
@@ -183,7 +190,7 @@ public:
       m_origCost(0.0),
       m_redCost (0.0),
       m_effCnt  (0),
-      m_strHash (),
+      m_hash    (0),
       m_blockId (0),
       m_colMasterIndex(-1),
       m_norm    (0.0) {
@@ -199,7 +206,7 @@ public:
       m_origCost(origCost),
       m_redCost (redCost),
       m_effCnt  (0),
-      m_strHash (),
+      m_hash    (0),
       m_blockId (0),
       m_colMasterIndex(-1),
       m_norm    (0.0) {
@@ -207,10 +214,9 @@ public:
 	 if (ind.size() > 0) {
 	    m_s.setConstant(static_cast<int>(ind.size()),
 			    &ind[0], els, DECOMP_TEST_DUPINDEX);
-	    m_strHash = UtilCreateStringHash(static_cast<int>(ind.size()),
-					     &ind[0], els);
 	    m_norm    = calcNorm();
 	    sortVar();
+	    calcHash();
 	 }
       }
 
@@ -223,7 +229,7 @@ public:
       m_origCost(origCost),
       m_redCost (redCost),
       m_effCnt  (0),
-      m_strHash (),
+      m_hash    (0),
       m_blockId (0),
       m_colMasterIndex(-1),
       m_norm    (0.0) {
@@ -231,10 +237,9 @@ public:
 	 if (ind.size() > 0) {
 	    m_s.setVector(static_cast<int>(ind.size()),
 			  &ind[0], &els[0], DECOMP_TEST_DUPINDEX);
-	    m_strHash = UtilCreateStringHash(static_cast<int>(ind.size()),
-					     &ind[0], &els[0]);
 	    m_norm    = calcNorm();
 	    sortVar();
+	    calcHash();
 	 }
       }
 
@@ -248,7 +253,7 @@ public:
       m_origCost(origCost),
       m_redCost (redCost),
       m_effCnt  (0),
-      m_strHash (),
+      m_hash    (0),
       m_blockId (0),
       m_colMasterIndex(-1),
       m_norm    (0.0) {
@@ -256,10 +261,9 @@ public:
 	 if (ind.size() > 0) {
 	    m_s.setVector(static_cast<int>(ind.size()),
 			  &ind[0], &els[0], DECOMP_TEST_DUPINDEX);
-	    m_strHash = UtilCreateStringHash(static_cast<int>(ind.size()),
-					     &ind[0], &els[0]);
 	    m_norm    = calcNorm();
 	    sortVar();
+	    calcHash();
 	 }
       }
 
@@ -272,15 +276,15 @@ public:
       m_origCost(origCost),
       m_redCost (0.0),
       m_effCnt  (0),
-      m_strHash (),
+      m_hash    (0),
       m_blockId (0),
       m_colMasterIndex(-1),
       m_norm    (0.0) {
 	 if (len > 0) {
 	    m_s.setVector(len, ind, els, DECOMP_TEST_DUPINDEX);
-	    m_strHash = UtilCreateStringHash(len, ind, els);
 	    m_norm    = calcNorm();
 	    sortVar();
+	    calcHash();
 	 }
       }
 
@@ -294,15 +298,15 @@ public:
       m_origCost(origCost),
       m_redCost (0.0),
       m_effCnt  (0),
-      m_strHash (),
+      m_hash    (0),
       m_blockId (0),
       m_colMasterIndex(-1),
       m_norm    (0.0) {
 	 if (len > 0) {
 	    m_s.setVector(len, ind, els, DECOMP_TEST_DUPINDEX);
-	    m_strHash = UtilCreateStringHash(len, ind, els);
 	    m_norm    = calcNorm();
 	    sortVar();
+	    calcHash();
 	 }
       }
 
@@ -315,15 +319,15 @@ public:
       m_origCost(origCost),
       m_redCost (0.0),
       m_effCnt  (0),
-      m_strHash (),
+      m_hash    (0),
       m_blockId (0),
       m_colMasterIndex(-1),
       m_norm    (0.0) {
 	 if (len > 0) {
 	    m_s.setConstant(len, ind, els, DECOMP_TEST_DUPINDEX);
-	    m_strHash = UtilCreateStringHash(len, ind, els);
 	    m_norm    = calcNorm();
 	    sortVar();
+	    calcHash();
 	 }
       }
 
@@ -337,15 +341,15 @@ public:
       m_origCost(origCost),
       m_redCost (0.0),
       m_effCnt  (0),
-      m_strHash (),
+      m_hash    (0),
       m_blockId (0),
       m_colMasterIndex(-1),
       m_norm    (0.0) {
 	 if (len > 0) {
 	    m_s.setConstant(len, ind, els, DECOMP_TEST_DUPINDEX);
-	    m_strHash = UtilCreateStringHash(len, ind, els);
 	    m_norm    = calcNorm();
 	    sortVar();
+	    calcHash();
 	 }
       }
 
@@ -359,15 +363,15 @@ public:
       m_origCost(origCost),
       m_redCost (redCost),
       m_effCnt  (0),
-      m_strHash (),
+      m_hash    (0),
       m_blockId (0),
       m_colMasterIndex(-1),
       m_norm    (0.0) {
 	 if (len > 0) {
 	    m_s.setVector(len, ind, els, DECOMP_TEST_DUPINDEX);
-	    m_strHash = UtilCreateStringHash(len, ind, els);
 	    m_norm    = calcNorm();
 	    sortVar();
+	    calcHash();
 	 }
       }
 
@@ -382,15 +386,15 @@ public:
       m_origCost(origCost),
       m_redCost (redCost),
       m_effCnt  (0),
-      m_strHash (),
+      m_hash    (0),
       m_blockId (0),
       m_colMasterIndex(-1),
       m_norm    (0.0) {
 	 if (len > 0) {
 	    m_s.setVector(len, ind, els, DECOMP_TEST_DUPINDEX);
-	    m_strHash = UtilCreateStringHash(len, ind, els);
 	    m_norm    = calcNorm();
 	    sortVar();
+	    calcHash();
 	 }
       }
 
@@ -404,16 +408,16 @@ public:
       m_origCost(origCost),
       m_redCost (redCost),
       m_effCnt  (0),
-      m_strHash (),
+      m_hash    (0),
       m_blockId (0),
       m_colMasterIndex(-1),
       m_norm    (0.0) {
 	 UtilPackedVectorFromDense(denseLen, denseArray, DecompEpsilon, m_s);
 	 
 	 if (m_s.getNumElements() > 0) {
-	    m_strHash = UtilCreateStringHash(denseLen, denseArray);
 	    m_norm    = calcNorm();
 	    sortVar();
+	    calcHash();
 	 }
       }
 
@@ -23,19 +23,25 @@ bool DecompWaitingCol::setReducedCost(const double*       u,
                                       const DecompStatus    stat)
 {
    double redCost;
+   //---
+   //--- u.(A''s), same (SIMD) kernel as the column archive
+   //---
+   const double uCol = UtilSparseDot(m_col->getNumElements(),
+                                     m_col->getIndices(),
+                                     m_col->getElements(), u);
 
    if (stat == STAT_FEASIBLE) {
       // ---
       // --- RC[s] = c[s] - u (A''s) - alpha
       // ---
-      redCost = m_var->getOriginalCost() - m_col->dotProduct(u);
+      redCost = m_var->getOriginalCost() - uCol;
       m_var->setReducedCost(redCost);
       return redCost <= -0.0000000001;//m_app->m_param.dualTol;
    } else {
       // ---
       // --- RC[s] = u (A''s) + alpha -> dual ray
       // ---
-      redCost = -m_col->dotProduct(u);
+      redCost = -uCol;
       return redCost <= -0.0000000001;//m_app->m_param.dualTol;
    }
 }
@@ -56,129 +62,184 @@ bool DecompWaitingCol::setReducedCost(const double*       u,
 
 
 // --------------------------------------------------------------------- //
-bool DecompVarPool::isParallel(const DecompVarList&     vars,
-                               const DecompWaitingCol& wcol,
-                               const double             maxCosine)
+void DecompVarColIndex::insert(const DecompVar* var)
+{
+   const int      slot = static_cast<int>(m_slotVar.size());
+   const int      len  = var->m_s.getNumElements();
+   const int*     ind  = var->m_s.getIndices();
+   m_slotVar.push_back(var);
+   m_varSlot[var] = slot;
+
+   for (int i = 0; i < len; i++) {
+      if (ind[i] >= static_cast<int>(m_colSlots.size())) {
+         m_colSlots.resize(ind[i] + 1);
+      }
+
+      m_colSlots[ind[i]].push_back(slot);
+   }
+}
+
+// --------------------------------------------------------------------- //
+void DecompVarColIndex::erase(const DecompVar* var)
+{
+   std::map<const DecompVar*, int>::iterator mi = m_varSlot.find(var);
+
+   if (mi == m_varSlot.end()) {
+      return;
+   }
+
+   m_slotVar[mi->second] = NULL;
+   m_varSlot.erase(mi);
+   m_nDead++;
+
+   if (m_nDead > static_cast<int>(m_varSlot.size())) {
+      compact();
+   }
+}
+
+// --------------------------------------------------------------------- //
+void DecompVarColIndex::compact()
+{
+   std::vector<const DecompVar*> liveVars;
+   std::vector<const DecompVar*>::const_iterator vi;
+
+   for (vi = m_slotVar.begin(); vi != m_slotVar.end(); ++vi) {
+      if (*vi) {
+         liveVars.push_back(*vi);
+      }
+   }
+
+   clear();
+
+   for (vi = liveVars.begin(); vi != liveVars.end(); ++vi) {
+      insert(*vi);
+   }
+}
+
+// --------------------------------------------------------------------- //
+void DecompVarColIndex::clear()
+{
+   m_slotVar.clear();
+   m_colSlots.clear();
+   m_varSlot.clear();
+   m_nDead = 0;
+}
+
+// --------------------------------------------------------------------- //
+bool DecompVarColIndex::isParallel(const DecompVar* var,
+                                   const double     maxCosine) const
 {
-   DecompVarList::const_iterator vi;
-   int            j1, j2, index1, index2;
-   double         cosine;
-   DecompVar*     var    = wcol.getVarPtr();
    const int      block1 = var->getBlockId();
    const int      len1   = var->m_s.getNumElements();
    const int*     ind1   = var->m_s.getIndices();
    const double* els1   = var->m_s.getElements();
    const double   norm1  = var->getNorm();
+   const int      nCols  = static_cast<int>(m_colSlots.size());
    bool           isPara = false;
 
    if (len1 == 0) {
       return false;
    }
 
-   for (vi = vars.begin(); vi != vars.end(); ++vi) {
-      //---
-      //--- if different blocks, it doesn't matter if rest of var
-      //---   is close to parallel
-      //---
-      const int      len2 = (*vi)->m_s.getNumElements();
+   if (m_dot.size() < m_slotVar.size()) {
+      m_dot.resize(m_slotVar.size(), 0.0);
+   }
+
+   //---
+   //--- accumulate var1*var2 only for the vars that share a column
+   //---   with var1 (all the others have cosine=0)
+   //---
+   m_touched.clear();
 
-      if ((*vi)->getBlockId() != block1 ||
-            len2                == 0) {
+   for (int i = 0; i < len1; i++) {
+      if (ind1[i] >= nCols) {
          continue;
       }
 
-      const int*     ind2 = (*vi)->m_s.getIndices();
-
-      const double* els2 = (*vi)->m_s.getElements();
-
-      const double   norm2 = (*vi)->getNorm();
-
-      index1              = 0;
+      const std::vector<int>& slots = m_colSlots[ind1[i]];
+      std::vector<int>::const_iterator si;
 
-      index2              = 0;
+      for (si = slots.begin(); si != slots.end(); ++si) {
+         const DecompVar* var2 = m_slotVar[*si];
 
-      cosine              = 0.0;
-
-      //---
-      //--- calculate var1*var2 (both sparse)
-      //---   var indices are assumed to be sorted increasing
-      //---
-      while (1) {
-         j1 = ind1[index1];
-         j2 = ind2[index2];
+         if (!var2 || var2->getBlockId() != block1) {
+            continue;
+         }
 
-         if (j1 == j2) {
-            cosine += els1[index1] * els2[index2];
-            index1++;
-            index2++;
+         //---
+         //--- var2 has this column exactly once, find its coefficient
+         //---
+         const int      len2 = var2->m_s.getNumElements();
+         const int*     ind2 = var2->m_s.getIndices();
+         const int*     pos  = std::lower_bound(ind2, ind2 + len2, ind1[i]);
 
-            if (index2 >= len2 || index1 >= len1) {
-               break;
-            }
-         } else if (j1 > j2) {
-            index2++;
+         if (m_dot[*si] == 0.0) {
+            m_touched.push_back(*si);
+         }
 
-            if (index2 >= len2) {
-               break;
-            }
-         } else {
-            index1++;
+         m_dot[*si] += els1[i] * var2->m_s.getElements()[pos - ind2];
 
-            if (index1 >= len1) {
-               break;
-            }
+         if (m_dot[*si] == 0.0) {
+            //keep the slot marked as touched
+            m_dot[*si] = DecompZero;
          }
       }
+   }
 
-      cosine /= norm1;
-      cosine /= norm2;
-      cosine = fabs(cosine);
+   std::vector<int>::const_iterator ti;
 
-      if (cosine > maxCosine) {
+   for (ti = m_touched.begin(); ti != m_touched.end(); ++ti) {
+      const double cosine = fabs(m_dot[*ti]) / norm1
+                            / m_slotVar[*ti]->getNorm();
+      m_dot[*ti] = 0.0;
+
+      if (!isPara && cosine > maxCosine) {
          isPara = true;
-         printf("parallel: cosine=%g\n", cosine);
-         break;
       }
-
-      //printf("not parallel: cosine=%g\n", cosine);
    }
 
    return isPara;
 }
 
 // --------------------------------------------------------------------- //
-bool DecompVarPool::isDuplicate(const DecompVarList&     vars,
-                                const DecompWaitingCol& wcol)
+bool DecompVarPool::isParallel(const DecompVarColIndex& varsColIndex,
+                               const DecompWaitingCol&  wcol,
+                               const double             maxCosine) const
 {
-   DecompVarList::const_iterator vi;
-   DecompVar* var = wcol.getVarPtr();
-
-   for (vi = vars.begin(); vi != vars.end(); ++vi) {
-      if (((*vi)->getBlockId() == var->getBlockId()) &&
-            ((*vi)->getStrHash() == var->getStrHash())) {
-         return true;
-      }
-   }
+   return varsColIndex.isParallel(wcol.getVarPtr(), maxCosine);
+}
 
-   return false;
+// --------------------------------------------------------------------- //
+bool DecompVarPool::isDuplicate(const DecompVarHashIndex& varsIndex,
+                                const DecompWaitingCol&   wcol) const
+{
+   return varsIndex.contains(wcol.getVarPtr());
 }
 
 // --------------------------------------------------------------------- //
-bool DecompVarPool::isDuplicate(const DecompWaitingCol& wcol)
+bool DecompVarPool::isDuplicate(const DecompWaitingCol& wcol) const
 {
-   vector<DecompWaitingCol>::const_iterator vi;
-   DecompVar* var1 = wcol.getVarPtr();
+   return m_hashIndex.contains(wcol.getVarPtr());
+}
 
-   for (vi = begin(); vi != end(); ++vi) {
-      DecompVar* var2 = (*vi).getVarPtr();
+// --------------------------------------------------------------------- //
+void DecompVarPool::addCol(const DecompWaitingCol& wcol)
+{
+   push_back(wcol);
+   m_hashIndex.insert(wcol.getVarPtr());
+}
 
-      if ((var1->getBlockId() == var2->getBlockId()) &&
-            (var1->getStrHash() == var2->getStrHash())) {
-         return true;
-      }
+// --------------------------------------------------------------------- //
+void DecompVarPool::eraseCols(DecompVarPool::iterator first,
+                              DecompVarPool::iterator last)
+{
+   for (DecompVarPool::iterator vi = first; vi != last; ++vi) {
+      m_hashIndex.erase((*vi).getVarPtr());
+      (*vi).deleteCol();
+      (*vi).clearVar();
    }
 
-   return false;
+   erase(first, last);
 }
 
 /*-------------------------------------------------------------------------*/
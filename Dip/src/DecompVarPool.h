@@ -30,6 +30,110 @@ public:
    }
 };
 
+// --------------------------------------------------------------------- //
+/**
+   Per-block hash index of variable fingerprints (DecompVar::getHash).
+   Used to make duplicate detection O(1) against the master columns and
+   the columns waiting in the pool.
+*/
+class DecompVarHashIndex {
+private:
+   std::vector<UtilHashSet> m_blocks;
+
+public:
+   inline bool contains(const int b, const UtilHashKey hash) const {
+      return b < static_cast<int>(m_blocks.size()) &&
+             m_blocks[b].contains(hash);
+   }
+   inline bool contains(const DecompVar* var) const {
+      return contains(var->getBlockId(), var->getHash());
+   }
+   inline void insert(const int b, const UtilHashKey hash) {
+      if (b >= static_cast<int>(m_blocks.size())) {
+         m_blocks.resize(b + 1);
+      }
+
+      m_blocks[b].insert(hash);
+   }
+   inline void insert(const DecompVar* var) {
+      insert(var->getBlockId(), var->getHash());
+   }
+   inline void insert(const DecompVarList& vars) {
+      DecompVarList::const_iterator vi;
+
+      for (vi = vars.begin(); vi != vars.end(); ++vi) {
+         insert(*vi);
+      }
+   }
+   inline void erase(const int b, const UtilHashKey hash) {
+      if (b < static_cast<int>(m_blocks.size())) {
+         m_blocks[b].erase(hash);
+      }
+   }
+   inline void erase(const DecompVar* var) {
+      erase(var->getBlockId(), var->getHash());
+   }
+   inline void clear() {
+      m_blocks.clear();
+   }
+
+public:
+   DecompVarHashIndex() : m_blocks() {}
+   ~DecompVarHashIndex() {}
+};
+
+// --------------------------------------------------------------------- //
+/**
+   Inverted index from original (x-space) columns to the variables whose
+   m_s contains them. Used to test a new variable for parallelism against
+   only those variables it shares a nonzero with, instead of computing the
+   cosine against every variable in the same block.
+
+   Deleted variables are dropped lazily from the column lists; the index
+   is compacted once the dead entries outnumber the live ones.
+*/
+class DecompVarColIndex {
+private:
+   std::vector<const DecompVar*>    m_slotVar; //slot -> var (NULL if erased)
+   std::vector< std::vector<int> >  m_colSlots; //orig col -> slots
+   std::map<const DecompVar*, int> m_varSlot; //var -> slot
+   int                              m_nDead;
+
+   //scratch for isParallel
+   mutable std::vector<double>      m_dot;
+   mutable std::vector<int>         m_touched;
+
+private:
+   void compact();
+
+public:
+   void insert(const DecompVar* var);
+   inline void insert(const DecompVarList& vars) {
+      DecompVarList::const_iterator vi;
+
+      for (vi = vars.begin(); vi != vars.end(); ++vi) {
+         insert(*vi);
+      }
+   }
+   void erase(const DecompVar* var);
+   void clear();
+
+   /** Is var parallel (|cosine| > maxCosine) to some indexed var
+       from the same block? */
+   bool isParallel(const DecompVar* var,
+                   const double     maxCosine) const;
+
+public:
+   DecompVarColIndex() :
+      m_slotVar (),
+      m_colSlots(),
+      m_varSlot (),
+      m_nDead   (0),
+      m_dot     (),
+      m_touched () {}
+   ~DecompVarColIndex() {}
+};
+
 // --------------------------------------------------------------------- //
 class DecompVarPool : public std::vector<DecompWaitingCol> {
 private:
@@ -39,6 +143,7 @@ private:
 private:
    static const char* classTag;
    bool m_colsAreValid;
+   DecompVarHashIndex m_hashIndex;
 
 public:
    const inline bool colsAreValid() const {
@@ -51,12 +156,22 @@ public:
    void print(double infinity, std::ostream* os = &std::cout) const;  //THINK: virtual??
    void reExpand(const DecompConstraintSet& modelCore,
                  const double                tolZero);
-   bool isDuplicate(const DecompWaitingCol& wcol);
-   bool isDuplicate(const DecompVarList&     vars,
-                    const DecompWaitingCol& wcol);
-   bool isParallel(const DecompVarList&     vars,
-                   const DecompWaitingCol& wcol,
-                   const double             maxCosine);
+   bool isDuplicate(const DecompWaitingCol& wcol) const;
+   bool isDuplicate(const DecompVarHashIndex& varsIndex,
+                    const DecompWaitingCol&   wcol) const;
+
+   /** Append a waiting column to the pool (and its hash index). */
+   void addCol(const DecompWaitingCol& wcol);
+
+   /** Remove the columns in [first, last) from the pool. The column memory
+       is freed, the variable pointers are cleared (ownership has been
+       passed on to the master). */
+   void eraseCols(DecompVarPool::iterator first,
+                  DecompVarPool::iterator last);
+
+   bool isParallel(const DecompVarColIndex& varsColIndex,
+                   const DecompWaitingCol&  wcol,
+                   const double             maxCosine) const;
    bool setReducedCosts(const double*             u,
                         const DecompStatus          stat,
                         DecompVarPool::iterator   first,
@@ -68,7 +183,8 @@ public:
 
 public:
    DecompVarPool() :
-      m_colsAreValid(true) {}
+      m_colsAreValid(true),
+      m_hashIndex   () {}
 
    ~DecompVarPool() {
       //---
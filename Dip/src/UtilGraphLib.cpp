@@ -32,6 +32,9 @@
 #include <cmath>
 #include <cstdio>
 #include <cstring>
+#include <limits>
+#include <queue>
+#include <set>
 using namespace std;
 
 /* TODO - deal with logging, error handling, etc */
@@ -583,4 +586,629 @@ int UtilGraphLib::compute_icost(const int wtype, const int va, const int vb)
    return ( cost );
 }
 
+// ==========================================================================
+// Separation on support graphs
+// ==========================================================================
+
+//---
+//--- a contraction of the support graph: original vertex v is in
+//---   supervertex comp[v] (0 <= comp[v] < nSuper), the edges between
+//---   supervertices are merged and stored in both directions (CSR)
+//---
+struct UtilSuperGraph {
+   int                   nSuper;
+   vector<int>           comp;
+   vector< vector<int> > members;
+   vector<int>           adjBeg;
+   vector<int>           adjNode;
+   vector<double>        adjVal;
+   vector<double>        degree;
+};
+
+// ==========================================================================
+static int UtilFindRoot(vector<int>& parent,
+                        int          u)
+{
+   while (parent[u] != u) {
+      parent[u] = parent[parent[u]];
+      u         = parent[u];
+   }
+
+   return u;
+}
+
+// ==========================================================================
+static void UtilBuildSuperGraph(const vector<int>&    edgeList,
+                                const vector<double>& edgeValue,
+                                UtilSuperGraph&       g)
+{
+   const int nVerts = static_cast<int>(g.comp.size());
+   const int nEdges = static_cast<int>(edgeValue.size());
+   int       v, k;
+   g.members.assign(g.nSuper, vector<int>());
+
+   for (v = 0; v < nVerts; v++) {
+      g.members[g.comp[v]].push_back(v);
+   }
+
+   vector< pair< pair<int, int>, double > > arcs;
+   arcs.reserve(2 * nEdges);
+
+   for (k = 0; k < nEdges; k++) {
+      const int a = g.comp[edgeList[2 * k]];
+      const int b = g.comp[edgeList[2 * k + 1]];
+
+      if (a == b) {
+         continue;
+      }
+
+      arcs.push_back(make_pair(make_pair(a, b), edgeValue[k]));
+      arcs.push_back(make_pair(make_pair(b, a), edgeValue[k]));
+   }
+
+   sort(arcs.begin(), arcs.end());
+   g.adjBeg.assign(g.nSuper + 1, 0);
+   g.adjNode.clear();
+   g.adjVal.clear();
+   g.degree.assign(g.nSuper, 0.0);
+
+   for (k = 0; k < static_cast<int>(arcs.size()); k++) {
+      const int a = arcs[k].first.first;
+
+      if (k > 0 && arcs[k].first == arcs[k - 1].first) {
+         g.adjVal.back() += arcs[k].second;
+      } else {
+         g.adjNode.push_back(arcs[k].first.second);
+         g.adjVal.push_back(arcs[k].second);
+         g.adjBeg[a + 1]++;
+      }
+
+      g.degree[a] += arcs[k].second;
+   }
+
+   for (v = 0; v < g.nSuper; v++) {
+      g.adjBeg[v + 1] += g.adjBeg[v];
+   }
+}
+
+// ==========================================================================
+static void UtilContractSuperGraph(const vector< pair<int, int> >& pairs,
+                                   const vector<int>&              edgeList,
+                                   const vector<double>&           edgeValue,
+                                   UtilSuperGraph&                 g)
+{
+   const int   nVerts = static_cast<int>(g.comp.size());
+   vector<int> parent(g.nSuper);
+   vector<int> label(g.nSuper, -1);
+   int         s, nSuper = 0;
+
+   for (s = 0; s < g.nSuper; s++) {
+      parent[s] = s;
+   }
+
+   for (s = 0; s < static_cast<int>(pairs.size()); s++) {
+      const int ra = UtilFindRoot(parent, pairs[s].first);
+      const int rb = UtilFindRoot(parent, pairs[s].second);
+
+      if (ra != rb) {
+         parent[ra] = rb;
+      }
+   }
+
+   for (s = 0; s < g.nSuper; s++) {
+      const int r = UtilFindRoot(parent, s);
+
+      if (label[r] < 0) {
+         label[r] = nSuper++;
+      }
+   }
+
+   for (s = 0; s < nVerts; s++) {
+      g.comp[s] = label[UtilFindRoot(parent, g.comp[s])];
+   }
+
+   g.nSuper = nSuper;
+   UtilBuildSuperGraph(edgeList, edgeValue, g);
+}
+
+// ==========================================================================
+//---
+//--- record the cut with value and shore, as the shore without vertex 0
+//---
+static void UtilRecordCut(const int            nVerts,
+                          const double         value,
+                          const vector<int>&   shore,
+                          const double         cutoff,
+                          const double         tol,
+                          double&              best,
+                          vector<int>&         minSide,
+                          set< vector<int> >&  found)
+{
+   const bool isViolated = value < cutoff - tol;
+
+   if (value >= best && !isViolated) {
+      return;
+   }
+
+   vector<int> side;
+
+   if (find(shore.begin(), shore.end(), 0) == shore.end()) {
+      side = shore;
+   } else {
+      vector<bool> inShore(nVerts, false);
+
+      for (size_t i = 0; i < shore.size(); i++) {
+         inShore[shore[i]] = true;
+      }
+
+      for (int v = 1; v < nVerts; v++) {
+         if (!inShore[v]) {
+            side.push_back(v);
+         }
+      }
+   }
+
+   sort(side.begin(), side.end());
+
+   if (value < best) {
+      best    = value;
+      minSide = side;
+   }
+
+   if (isViolated) {
+      found.insert(side);
+   }
+}
+
+// ==========================================================================
+void UtilSupportGraph(const int        nEdges,
+                      const double*    x,
+                      vector<int>&     edgeList,
+                      vector<double>&  edgeValue,
+                      const double     tol)
+{
+   edgeList.clear();
+   edgeValue.clear();
+
+   for (int e = 0; e < nEdges; e++) {
+      if (x[e] <= tol) {
+         continue;
+      }
+
+      pair<int, int> uv = UtilBothEndsU(e);
+      edgeList.push_back(uv.first);
+      edgeList.push_back(uv.second);
+      edgeValue.push_back(x[e]);
+   }
+}
+
+// ==========================================================================
+double UtilMinCut(const int                nVerts,
+                  const vector<int>&       edgeList,
+                  const vector<double>&    edgeValue,
+                  vector<int>&             minSide,
+                  vector< vector<int> >&   cuts,
+                  const double             cutoff,
+                  const double             tol)
+{
+   //---
+   //--- edges are contracted when their connectivity is proved to be at
+   //---   least the value of a cut already recorded (less this tolerance)
+   //---
+   const double       contractTol = 1.0e-9;
+   double             best        = numeric_limits<double>::max();
+   set< vector<int> > found;
+   int                s, k;
+   minSide.clear();
+   cuts.clear();
+
+   if (nVerts < 2) {
+      return 0.0;
+   }
+
+   UtilSuperGraph g;
+   g.nSuper = nVerts;
+   g.comp.resize(nVerts);
+
+   for (s = 0; s < nVerts; s++) {
+      g.comp[s] = s;
+   }
+
+   UtilBuildSuperGraph(edgeList, edgeValue, g);
+   //---
+   //--- if the support graph is not connected, each of its components
+   //---   is a cut of value 0
+   //---
+   vector<int> label(nVerts, -1);
+   vector<int> shore;
+   int         nComp = 0;
+
+   for (s = 0; s < nVerts; s++) {
+      if (label[s] >= 0) {
+         continue;
+      }
+
+      vector<int> stack(1, s);
+      label[s] = nComp;
+
+      while (!stack.empty()) {
+         const int u = stack.back();
+         stack.pop_back();
+
+         for (k = g.adjBeg[u]; k < g.adjBeg[u + 1]; k++) {
+            if (label[g.adjNode[k]] < 0) {
+               label[g.adjNode[k]] = nComp;
+               stack.push_back(g.adjNode[k]);
+            }
+         }
+      }
+
+      nComp++;
+   }
+
+   if (nComp > 1) {
+      for (int c = 0; c < nComp; c++) {
+         shore.clear();
+
+         for (s = 0; s < nVerts; s++) {
+            if (label[s] == c) {
+               shore.push_back(s);
+            }
+         }
+
+         UtilRecordCut(nVerts, 0.0, shore, cutoff, tol, best, minSide, found);
+      }
+
+      cuts.assign(found.begin(), found.end());
+      return 0.0;
+   }
+
+   vector< pair<int, int> > pairs;
+
+   while (g.nSuper > 1) {
+      const int n = g.nSuper;
+
+      //---
+      //--- the supervertices themselves are cuts
+      //---
+      for (s = 0; s < n; s++) {
+         UtilRecordCut(nVerts, g.degree[s], g.members[s], cutoff, tol,
+                       best, minSide, found);
+      }
+
+      //---
+      //--- Padberg-Rinaldi shrinking: a cut which separates u and v has
+      //---   value at least min(d(u), d(v)) if
+      //---     (1) c(u,v) >= min(d(u), d(v)), or
+      //---     (2) c(u,v) + c(u,w) >= d(u) and c(u,v) + c(v,w) >= d(v)
+      //---         for some common neighbor w
+      //---
+      vector<double> cA(n, 0.0);
+      pairs.clear();
+
+      for (int a = 0; a < n; a++) {
+         for (k = g.adjBeg[a]; k < g.adjBeg[a + 1]; k++) {
+            cA[g.adjNode[k]] = g.adjVal[k];
+         }
+
+         for (k = g.adjBeg[a]; k < g.adjBeg[a + 1]; k++) {
+            const int    b   = g.adjNode[k];
+            const double cAB = g.adjVal[k];
+
+            if (b < a) {
+               continue;
+            }
+
+            if (cAB >= min(g.degree[a], g.degree[b]) - contractTol) {
+               pairs.push_back(make_pair(a, b));
+               continue;
+            }
+
+            for (int l = g.adjBeg[b]; l < g.adjBeg[b + 1]; l++) {
+               const int w = g.adjNode[l];
+
+               if (w == a || cA[w] <= 0.0) {
+                  continue;
+               }
+
+               if (cAB + cA[w]       >= g.degree[a] - contractTol &&
+                     cAB + g.adjVal[l] >= g.degree[b] - contractTol) {
+                  pairs.push_back(make_pair(a, b));
+                  break;
+               }
+            }
+         }
+
+         for (k = g.adjBeg[a]; k < g.adjBeg[a + 1]; k++) {
+            cA[g.adjNode[k]] = 0.0;
+         }
+      }
+
+      if (!pairs.empty()) {
+         UtilContractSuperGraph(pairs, edgeList, edgeValue, g);
+         continue;
+      }
+
+      //---
+      //--- Nagamochi-Ibaraki: scan the supervertices in a maximum
+      //---   adjacency ordering; when edge (x,y) is scanned, the
+      //---   connectivity of x and y is at least r(y) (the sum of the
+      //---   edges from the scanned supervertices to y), so the edge can
+      //---   be contracted if r(y) >= best. Each prefix of the ordering
+      //---   is a cut as well; the smallest one is recorded.
+      //---
+      vector<double>  r(n, 0.0);
+      vector<bool>    scanned(n, false);
+      vector<int>     order;
+      priority_queue< pair<double, int> > heap;
+      double          prefixVal  = 0.0;
+      double          bestPrefix = numeric_limits<double>::max();
+      int             bestLen    = 0;
+      order.reserve(n);
+      heap.push(make_pair(0.0, 0));
+
+      while (!heap.empty()) {
+         const pair<double, int> top = heap.top();
+         const int               x   = top.second;
+         heap.pop();
+
+         if (scanned[x] || top.first < r[x]) {
+            continue;
+         }
+
+         scanned[x] = true;
+         order.push_back(x);
+         prefixVal += g.degree[x] - 2.0 * r[x];
+
+         if (static_cast<int>(order.size()) < n && prefixVal < bestPrefix) {
+            bestPrefix = prefixVal;
+            bestLen    = static_cast<int>(order.size());
+         }
+
+         for (k = g.adjBeg[x]; k < g.adjBeg[x + 1]; k++) {
+            const int y = g.adjNode[k];
+
+            if (scanned[y]) {
+               continue;
+            }
+
+            r[y] += g.adjVal[k];
+
+            if (r[y] >= best - contractTol) {
+               pairs.push_back(make_pair(x, y));
+            }
+
+            heap.push(make_pair(r[y], y));
+         }
+      }
+
+      if (bestLen > 1) {
+         shore.clear();
+
+         for (s = 0; s < bestLen; s++) {
+            const vector<int>& mem = g.members[order[s]];
+            shore.insert(shore.end(), mem.begin(), mem.end());
+         }
+
+         UtilRecordCut(nVerts, bestPrefix, shore, cutoff, tol,
+                       best, minSide, found);
+      }
+
+      //---
+      //--- the last two supervertices of the ordering can always be
+      //---   contracted (their connectivity is d(last))
+      //---
+      if (pairs.empty()) {
+         pairs.push_back(make_pair(order[n - 2], order[n - 1]));
+      }
+
+      UtilContractSuperGraph(pairs, edgeList, edgeValue, g);
+   }
+
+   cuts.assign(found.begin(), found.end());
+   return best;
+}
+
+// ==========================================================================
+int UtilSeparateSubtours(const int                nVerts,
+                         const vector<int>&       edgeList,
+                         const vector<double>&    edgeValue,
+                         vector< vector<int> >&   sets,
+                         const double             tol)
+{
+   vector<int>           minSide;
+   vector< vector<int> > cuts;
+   sets.clear();
+   UtilMinCut(nVerts, edgeList, edgeValue, minSide, cuts, 2.0, tol);
+
+   //---
+   //--- a violated cut with one vertex on a shore is a violated degree
+   //---   constraint, not a subtour
+   //---
+   for (size_t c = 0; c < cuts.size(); c++) {
+      const int size = static_cast<int>(cuts[c].size());
+
+      if (size >= 2 && size <= nVerts - 2) {
+         sets.push_back(cuts[c]);
+      }
+   }
+
+   return static_cast<int>(sets.size());
+}
+
+// ==========================================================================
+int UtilSeparateCapacityCuts(const int                nVerts,
+                             const vector<int>&       edgeList,
+                             const vector<double>&    edgeValue,
+                             const int*               demand,
+                             const int                capacity,
+                             vector< vector<int> >&   sets,
+                             const int                maxCuts,
+                             const double             tol)
+{
+   const int nEdges = static_cast<int>(edgeValue.size());
+   int       u, v, k;
+   sets.clear();
+
+   if (nVerts < 3 || capacity <= 0) {
+      return 0;
+   }
+
+   //---
+   //--- adjacency of the support graph (CSR) and x(delta(v))
+   //---
+   vector<int>    adjBeg(nVerts + 1, 0);
+   vector<int>    adjNode(2 * nEdges);
+   vector<double> adjVal(2 * nEdges);
+   vector<double> degree(nVerts, 0.0);
+
+   for (k = 0; k < nEdges; k++) {
+      adjBeg[edgeList[2 * k] + 1]++;
+      adjBeg[edgeList[2 * k + 1] + 1]++;
+   }
+
+   for (v = 0; v < nVerts; v++) {
+      adjBeg[v + 1] += adjBeg[v];
+   }
 
+   vector<int> next(adjBeg.begin(), adjBeg.end() - 1);
+
+   for (k = 0; k < nEdges; k++) {
+      u = edgeList[2 * k];
+      v = edgeList[2 * k + 1];
+      adjNode[next[u]]   = v;
+      adjVal[next[u]++]  = edgeValue[k];
+      adjNode[next[v]]   = u;
+      adjVal[next[v]++]  = edgeValue[k];
+      degree[u]         += edgeValue[k];
+      degree[v]         += edgeValue[k];
+   }
+
+   set< vector<int> > found;
+   vector<int>        S;
+   //---
+   //--- the connected components of the support graph without the depot
+   //---
+   vector<int> label(nVerts, -1);
+
+   for (int seed = 1; seed < nVerts; seed++) {
+      if (label[seed] >= 0) {
+         continue;
+      }
+
+      S.assign(1, seed);
+      label[seed] = seed;
+
+      for (size_t i = 0; i < S.size(); i++) {
+         for (k = adjBeg[S[i]]; k < adjBeg[S[i] + 1]; k++) {
+            u = adjNode[k];
+
+            if (u != 0 && label[u] < 0) {
+               label[u] = seed;
+               S.push_back(u);
+            }
+         }
+      }
+
+      if (S.size() < 2) {
+         continue;
+      }
+
+      double cutVal = 0.0;
+      int    dem    = 0;
+
+      for (size_t i = 0; i < S.size(); i++) {
+         dem += demand[S[i]];
+
+         for (k = adjBeg[S[i]]; k < adjBeg[S[i] + 1]; k++) {
+            if (label[adjNode[k]] != seed) {
+               cutVal += adjVal[k];
+            }
+         }
+      }
+
+      if (cutVal < 2.0 * ((dem + capacity - 1) / capacity) - tol) {
+         sort(S.begin(), S.end());
+         found.insert(S);
+      }
+   }
+
+   //---
+   //--- grow a set from each customer, adding the customer j (not the
+   //---   depot) with the largest x(j, S); check each set on the way
+   //---
+   vector<double> attach(nVerts, 0.0);
+   vector<bool>   inS(nVerts, false);
+   vector<int>    frontier;
+
+   for (int seed = 1; seed < nVerts; seed++) {
+      if (static_cast<int>(found.size()) >= maxCuts) {
+         break;
+      }
+
+      double cutVal = degree[seed];
+      int    dem    = demand[seed];
+      S.assign(1, seed);
+      frontier.clear();
+      inS[seed] = true;
+      v         = seed;
+
+      while (true) {
+         for (k = adjBeg[v]; k < adjBeg[v + 1]; k++) {
+            u = adjNode[k];
+
+            if (u == 0 || inS[u]) {
+               continue;
+            }
+
+            if (attach[u] <= 0.0) {
+               frontier.push_back(u);
+            }
+
+            attach[u] += adjVal[k];
+         }
+
+         if (static_cast<int>(S.size()) >= nVerts - 2) {
+            break;
+         }
+
+         int best = -1;
+
+         for (size_t i = 0; i < frontier.size(); i++) {
+            if (best < 0 || attach[frontier[i]] > attach[frontier[best]]) {
+               best = static_cast<int>(i);
+            }
+         }
+
+         if (best < 0) {
+            break;
+         }
+
+         v               = frontier[best];
+         frontier[best]  = frontier.back();
+         frontier.pop_back();
+         cutVal         += degree[v] - 2.0 * attach[v];
+         dem            += demand[v];
+         inS[v]          = true;
+         S.push_back(v);
+
+         if (cutVal < 2.0 * ((dem + capacity - 1) / capacity) - tol) {
+            vector<int> sortedS(S);
+            sort(sortedS.begin(), sortedS.end());
+            found.insert(sortedS);
+         }
+      }
+
+      for (size_t i = 0; i < S.size(); i++) {
+         inS[S[i]]    = false;
+         attach[S[i]] = 0.0;
+      }
+
+      for (size_t i = 0; i < frontier.size(); i++) {
+         attach[frontier[i]] = 0.0;
+      }
+   }
+
+   sets.assign(found.begin(), found.end());
+   return static_cast<int>(sets.size());
+}
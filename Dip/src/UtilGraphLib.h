@@ -29,6 +29,7 @@
 #include "UtilMacros.h"
 
 #include <string>
+#include <vector>
 
 // ----------------------------------------------------------------------- //
 class UtilGraphLib {
@@ -83,4 +84,59 @@ public:
                       const int vb);
 };
 
+// ----------------------------------------------------------------------- //
+// Separation on the support graph of a point x on the edges of a complete
+// undirected graph (edge e = UtilIndexU(u, v)). A support graph is given by
+// an edge list (the ends of edge k are edgeList[2k], edgeList[2k+1]) and
+// the values of x on those edges.
+// ----------------------------------------------------------------------- //
+
+/** Build the support graph (the edges with x[e] > tol) of x. */
+void UtilSupportGraph(const int             nEdges,
+                      const double*         x,
+                      std::vector<int>&     edgeList,
+                      std::vector<double>&  edgeValue,
+                      const double          tol = 1.0e-6);
+
+/**
+ * Global minimum cut of the support graph: Padberg-Rinaldi shrinking
+ * followed by Nagamochi-Ibaraki contraction. Returns its value and one of
+ * its shores (minSide). Each cut found on the way with a value below
+ * cutoff - tol is also returned in cuts. Shores never contain vertex 0.
+ */
+double UtilMinCut(const int                        nVerts,
+                  const std::vector<int>&          edgeList,
+                  const std::vector<double>&       edgeValue,
+                  std::vector<int>&                minSide,
+                  std::vector< std::vector<int> >& cuts,
+                  const double                     cutoff = 0.0,
+                  const double                     tol    = 1.0e-6);
+
+/**
+ * Exact separation of the subtour elimination constraints
+ * x(delta(S)) >= 2. Returns the number of violated sets S (2 <= |S| <=
+ * nVerts - 2) found, which is at least one if there is a violated one.
+ */
+int UtilSeparateSubtours(const int                        nVerts,
+                         const std::vector<int>&          edgeList,
+                         const std::vector<double>&       edgeValue,
+                         std::vector< std::vector<int> >& sets,
+                         const double                     tol = 1.0e-6);
+
+/**
+ * Heuristic separation of the rounded capacity inequalities
+ * x(delta(S)) >= 2 ceil(d(S) / capacity), S a set of customers (vertex 0
+ * is the depot). Tries the connected components of the support graph
+ * without the depot, then grows a set from each customer by adding the
+ * customer most connected to it. Returns the number of violated sets.
+ */
+int UtilSeparateCapacityCuts(const int                        nVerts,
+                             const std::vector<int>&          edgeList,
+                             const std::vector<double>&       edgeValue,
+                             const int*                       demand,
+                             const int                        capacity,
+                             std::vector< std::vector<int> >& sets,
+                             const int                        maxCuts = 100,
+                             const double                     tol = 1.0e-6);
+
 #endif
@@ -19,6 +19,7 @@
 using namespace std;
 
 #include "UtilMacros.h"
+#include "UtilHash.h"
 #include "Decomp.h"
 
 //http://burtleburtle.net/bob/hash/evahash.html or just map?
@@ -110,3 +111,162 @@ string UtilCreateStringHash(const int      len,
 }
 
 
+
+// --------------------------------------------------------------------- //
+static inline UtilHashKey UtilHashMix(UtilHashKey h)
+{
+   //splitmix64 finalizer
+   h ^= h >> 30;
+   h *= 0xbf58476d1ce4e5b9ULL;
+   h ^= h >> 27;
+   h *= 0x94d049bb133111ebULL;
+   h ^= h >> 31;
+   return h;
+}
+
+// --------------------------------------------------------------------- //
+UtilHashKey UtilCreateNumericHash(const int      len,
+                                  const int*     ind,
+                                  const double* els,
+                                  const int      precision)
+{
+   const double scale = pow(10.0, precision);
+   UtilHashKey  h     = 0x84222325cbf29ce4ULL;
+
+   for (int i = 0; i < len; i++) {
+      if (UtilIsZero(els[i])) {
+         continue;
+      }
+
+      const double      q  = floor(els[i] * scale + 0.5);
+      const UtilHashKey qk = static_cast<UtilHashKey>(static_cast<long long>(q));
+      h = UtilHashMix(h ^ static_cast<UtilHashKey>(ind[i]));
+      h = UtilHashMix(h ^ qk);
+   }
+
+   return h;
+}
+
+// --------------------------------------------------------------------- //
+int UtilHashSet::findSlot(const UtilHashKey key) const
+{
+   const int cap = static_cast<int>(m_keys.size());
+
+   if (cap == 0) {
+      return -1;
+   }
+
+   const int mask = cap - 1;
+   int       slot = static_cast<int>(UtilHashMix(key) & mask);
+
+   for (int probe = 0; probe < cap; probe++) {
+      if (m_counts[slot] == 0) {
+         return -1;
+      }
+
+      if (m_counts[slot] > 0 && m_keys[slot] == key) {
+         return slot;
+      }
+
+      slot = (slot + 1) & mask;
+   }
+
+   return -1;
+}
+
+// --------------------------------------------------------------------- //
+void UtilHashSet::rehash(const int capacity)
+{
+   std::vector<UtilHashKey> oldKeys;
+   std::vector<int>         oldCounts;
+   oldKeys.swap(m_keys);
+   oldCounts.swap(m_counts);
+   m_keys.assign(capacity, 0);
+   m_counts.assign(capacity, 0);
+   m_used = m_size;
+   const int mask = capacity - 1;
+
+   for (size_t i = 0; i < oldKeys.size(); i++) {
+      if (oldCounts[i] <= 0) {
+         continue;
+      }
+
+      int slot = static_cast<int>(UtilHashMix(oldKeys[i]) & mask);
+
+      while (m_counts[slot] != 0) {
+         slot = (slot + 1) & mask;
+      }
+
+      m_keys[slot]   = oldKeys[i];
+      m_counts[slot] = oldCounts[i];
+   }
+}
+
+// --------------------------------------------------------------------- //
+void UtilHashSet::insert(const UtilHashKey key)
+{
+   int slot = findSlot(key);
+
+   if (slot >= 0) {
+      m_counts[slot]++;
+      return;
+   }
+
+   //---
+   //--- keep the load (including tombstones) at or below 1/2, after a
+   //---   rehash the live keys take at most 1/4 of the table
+   //---
+   int cap = static_cast<int>(m_keys.size());
+
+   if (2 * (m_used + 1) > cap) {
+      int newCap = 16;
+
+      while (4 * (m_size + 1) > newCap) {
+         newCap *= 2;
+      }
+
+      rehash(newCap);
+      cap = newCap;
+   }
+
+   const int mask = cap - 1;
+   slot = static_cast<int>(UtilHashMix(key) & mask);
+
+   while (m_counts[slot] > 0) {
+      slot = (slot + 1) & mask;
+   }
+
+   if (m_counts[slot] == 0) {
+      m_used++;
+   }
+
+   m_keys[slot]   = key;
+   m_counts[slot] = 1;
+   m_size++;
+}
+
+// --------------------------------------------------------------------- //
+bool UtilHashSet::erase(const UtilHashKey key)
+{
+   const int slot = findSlot(key);
+
+   if (slot < 0) {
+      return false;
+   }
+
+   if (--m_counts[slot] == 0) {
+      m_counts[slot] = -1;
+      m_size--;
+   }
+
+   return true;
+}
+
+// --------------------------------------------------------------------- //
+void UtilHashSet::clear()
+{
+   m_keys.clear();
+   m_counts.clear();
+   m_size = 0;
+   m_used = 0;
+}
@@ -17,6 +17,10 @@
 #define UTIL_HASH_INCLUDED
 
 #include <string>
+#include <vector>
+
+/** 64-bit numeric fingerprint of a sparse vector. */
+typedef unsigned long long UtilHashKey;
 
 std::string UtilCreateStringHash(const int      len,
                                  const double* els,
@@ -38,4 +42,54 @@ std::string UtilCreateStringHash(const int      len,
 				 const double   infinity,
                                  const int      precision = 6);
 
+
+/**
+   Numeric (string-free) fingerprint of a sparse vector. Elements are
+   quantized to the given number of decimal places and zeros are skipped,
+   so the key matches for vectors that UtilCreateStringHash would consider
+   equal. The indices are assumed to be sorted.
+*/
+UtilHashKey UtilCreateNumericHash(const int      len,
+                                  const int*     ind,
+                                  const double* els,
+                                  const int      precision = 6);
+
+// --------------------------------------------------------------------- //
+/**
+   Open-addressing (linear probing) hash set of UtilHashKey's. Keys are
+   reference counted, so the same key can be inserted (and erased) more
+   than once. Erased slots are marked as tombstones and reclaimed on the
+   next rehash.
+*/
+class UtilHashSet {
+private:
+   std::vector<UtilHashKey> m_keys;
+   std::vector<int>         m_counts; //0=empty, -1=tombstone, >0=live
+   int                      m_size;   //number of live keys
+   int                      m_used;   //number of live keys + tombstones
+
+private:
+   int  findSlot(const UtilHashKey key) const;
+   void rehash(const int capacity);
+
+public:
+   bool contains(const UtilHashKey key) const {
+      return findSlot(key) >= 0;
+   }
+   void insert(const UtilHashKey key);
+   bool erase(const UtilHashKey key);
+   void clear();
+   inline int size() const {
+      return m_size;
+   }
+
+public:
+   UtilHashSet() :
+      m_keys  (),
+      m_counts(),
+      m_size  (0),
+      m_used  (0) {}
+   ~UtilHashSet() {}
+};
+
 #endif
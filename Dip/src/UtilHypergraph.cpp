@@ -0,0 +1,901 @@
+//===========================================================================//
+// This file is part of the DIP Solver Framework.                            //
+//                                                                           //
+// DIP is distributed under the Eclipse Public License as part of the        //
+// COIN-OR repository (http://www.coin-or.org).                              //
+//                                                                           //
+// Authors: Matthew Galati, SAS Institute Inc. (matthew.galati@sas.com)      //
+//          Ted Ralphs, Lehigh University (ted@lehigh.edu)                   //
+//          Jiadong Wang, Lehigh University (jiw508@lehigh.edu)              //
+//                                                                           //
+// Copyright (C) 2002-2018, Lehigh University, Matthew Galati, Ted Ralphs    //
+// All Rights Reserved.                                                      //
+//===========================================================================//
+
+//===========================================================================//
+#include "UtilHypergraph.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>
+#include <vector>
+#ifdef _OPENMP
+#include "omp.h"
+#endif
+
+//===========================================================================//
+//--- coarsening stops once a hypergraph has this many vertices or fewer
+static const int    UtilHgCoarsenTo     = 120;
+//--- coarsening stops if a level removes less than this fraction
+static const double UtilHgMinReduction  = 0.10;
+//--- hyperedges with more pins are ignored when matching and growing,
+//---   they say little about which vertices belong together
+static const int    UtilHgMaxNetSize    = 256;
+//--- number of greedy growing trials on the coarsest hypergraph
+static const int    UtilHgInitTrials    = 8;
+//--- FM passes per level
+static const int    UtilHgFMPasses      = 8;
+
+//===========================================================================//
+/**
+ * Hypergraph in compressed form: the pins of net e are
+ * eind[eptr[e]..eptr[e+1]-1], the nets of vertex v are
+ * vind[vptr[v]..vptr[v+1]-1]. All nets have at least two pins.
+ */
+struct UtilHg {
+   int              nV;
+   int              nE;
+   std::vector<int> vwgt;
+   std::vector<int> ewgt;
+   std::vector<int> eptr;
+   std::vector<int> eind;
+   std::vector<int> vptr;
+   std::vector<int> vind;
+
+   UtilHg() : nV(0), nE(0) {}
+
+   void buildIncidence() {
+      int v, e, i;
+      vptr.assign(nV + 1, 0);
+
+      for (i = 0; i < eptr[nE]; i++) {
+         vptr[eind[i] + 1]++;
+      }
+
+      for (v = 0; v < nV; v++) {
+         vptr[v + 1] += vptr[v];
+      }
+
+      std::vector<int> fill(vptr.begin(), vptr.end() - 1);
+      vind.resize(eptr[nE]);
+
+      for (e = 0; e < nE; e++) {
+         for (i = eptr[e]; i < eptr[e + 1]; i++) {
+            vind[fill[eind[i]]++] = e;
+         }
+      }
+   }
+
+   int totalVWgt() const {
+      int v, w = 0;
+
+      for (v = 0; v < nV; v++) {
+         w += vwgt[v];
+      }
+
+      return w;
+   }
+};
+
+//===========================================================================//
+/** Small xorshift generator, so that every task has its own stream. */
+struct UtilHgRand {
+   unsigned long long m_state;
+
+   UtilHgRand(const int seed) :
+      m_state(0x9E3779B97F4A7C15ULL * (static_cast<unsigned long long>(seed)
+                                       + 1)) {}
+
+   /** Uniform in [0, n), n > 0. */
+   int next(const int n) {
+      m_state ^= m_state >> 12;
+      m_state ^= m_state << 25;
+      m_state ^= m_state >> 27;
+      return static_cast<int>(((m_state * 0x2545F4914F6CDD1DULL) >> 33)
+                              % static_cast<unsigned long long>(n));
+   }
+};
+
+//===========================================================================//
+/** Result of a bisection: (balance violation, cut) compared lexically. */
+struct UtilHgBisection {
+   std::vector<int> part;
+   int              viol;
+   int              cut;
+
+   UtilHgBisection() : viol(0), cut(0) {}
+
+   bool isBetter(const int thisViol, const int thisCut) const {
+      return thisViol < viol || (thisViol == viol && thisCut < cut);
+   }
+};
+
+//===========================================================================//
+static int UtilHgViolation(const int* W,
+                           const int* maxW)
+{
+   return std::max(0, W[0] - maxW[0]) + std::max(0, W[1] - maxW[1]);
+}
+
+//===========================================================================//
+static int UtilHgCounts(const UtilHg&           H,
+                        const std::vector<int>& part,
+                        std::vector<int>&       pc,
+                        int*                    W)
+{
+   int v, e, i, cut = 0;
+   W[0] = W[1] = 0;
+
+   for (v = 0; v < H.nV; v++) {
+      W[part[v]] += H.vwgt[v];
+   }
+
+   pc.assign(2 * H.nE, 0);
+
+   for (e = 0; e < H.nE; e++) {
+      for (i = H.eptr[e]; i < H.eptr[e + 1]; i++) {
+         pc[2 * e + part[H.eind[i]]]++;
+      }
+
+      if (pc[2 * e] && pc[2 * e + 1]) {
+         cut += H.ewgt[e];
+      }
+   }
+
+   return cut;
+}
+
+//===========================================================================//
+/** Change of the cut if v moves to the other side (positive is better). */
+static int UtilHgGain(const UtilHg&           H,
+                      const std::vector<int>& part,
+                      const std::vector<int>& pc,
+                      const int               v)
+{
+   int j, e, a = part[v], b = 1 - a, g = 0;
+
+   for (j = H.vptr[v]; j < H.vptr[v + 1]; j++) {
+      e = H.vind[j];
+
+      if (pc[2 * e + a] == 1) {
+         g += H.ewgt[e];
+      } else if (pc[2 * e + b] == 0) {
+         g -= H.ewgt[e];
+      }
+   }
+
+   return g;
+}
+
+//===========================================================================//
+/**
+ * Fiduccia-Mattheyses refinement of a bisection. Each pass moves the best
+ * legal vertex at a time (gains kept in a lazy heap per side), remembers
+ * the best prefix of moves and rolls back the rest. Stops when a pass
+ * brings no improvement.
+ */
+static void UtilHgRefineFM(const UtilHg&     H,
+                           std::vector<int>& part,
+                           const int*        maxW,
+                           const int         maxPasses,
+                           int&              viol,
+                           int&              cut)
+{
+   typedef std::pair<int, int> GainVertex;
+   int                      v, u, e, i, j, s, pass;
+   int                      W[2];
+   std::vector<int>         pc;
+   std::vector<int>         gain(H.nV, 0);
+   std::vector<int>         locked(H.nV, -1);
+   std::vector<int>         mark(H.nV, -1);
+   std::vector<int>         moves;
+   std::vector<int>         touched;
+   int                      stamp = 0;
+   const int                maxBad = std::min(H.nV, 50 + H.nV / 100);
+   cut  = UtilHgCounts(H, part, pc, W);
+   viol = UtilHgViolation(W, maxW);
+
+   for (pass = 0; pass < maxPasses; pass++) {
+      std::priority_queue<GainVertex> heap[2];
+
+      //---
+      //--- start from the boundary: vertices on at least one cut net
+      //---
+      for (v = 0; v < H.nV; v++) {
+         gain[v] = UtilHgGain(H, part, pc, v);
+
+         for (j = H.vptr[v]; j < H.vptr[v + 1]; j++) {
+            e = H.vind[j];
+
+            if (pc[2 * e] && pc[2 * e + 1]) {
+               heap[part[v]].push(GainVertex(gain[v], v));
+               break;
+            }
+         }
+      }
+
+      int curCut  = cut;
+      int curViol = viol;
+      int bestCut  = cut;
+      int bestViol = viol;
+      int bestLen  = 0;
+      int nBad     = 0;
+      moves.clear();
+
+      while (true) {
+         //---
+         //--- pick the best legal move out of either side
+         //---
+         int from = -1;
+
+         for (s = 0; s < 2; s++) {
+            while (!heap[s].empty()) {
+               const GainVertex& top = heap[s].top();
+
+               if (locked[top.second] == pass    ||
+                     part[top.second]   != s       ||
+                     gain[top.second]   != top.first) {
+                  heap[s].pop();
+               } else {
+                  break;
+               }
+            }
+
+            if (heap[s].empty() ||
+                  W[1 - s] + H.vwgt[heap[s].top().second] > maxW[1 - s]) {
+               continue;
+            }
+
+            if (from < 0                                          ||
+                  heap[s].top().first > heap[from].top().first     ||
+                  (heap[s].top().first == heap[from].top().first &&
+                   W[s] > W[from])) {
+               from = s;
+            }
+         }
+
+         if (from < 0) {
+            break;
+         }
+
+         v = heap[from].top().second;
+         heap[from].pop();
+         const int to = 1 - from;
+         locked[v] = pass;
+         curCut   -= gain[v];
+         part[v]   = to;
+         W[from]  -= H.vwgt[v];
+         W[to]    += H.vwgt[v];
+         curViol   = UtilHgViolation(W, maxW);
+         moves.push_back(v);
+         //---
+         //--- update pin counts and the gains of the free pins (the usual
+         //---   FM rules: only nets with at most one pin on either side
+         //---   before or after the move matter)
+         //---
+         touched.clear();
+         stamp++;
+
+         for (j = H.vptr[v]; j < H.vptr[v + 1]; j++) {
+            e = H.vind[j];
+            const int w     = H.ewgt[e];
+            const int nTo   = pc[2 * e + to]++;
+            const int nFrom = --pc[2 * e + from];
+
+            if (nTo > 1 && nFrom > 1) {
+               continue;
+            }
+
+            for (i = H.eptr[e]; i < H.eptr[e + 1]; i++) {
+               u = H.eind[i];
+
+               if (locked[u] == pass) {
+                  continue;
+               }
+
+               const int delta =
+                  (nTo == 0 ? w : 0) -
+                  (nTo == 1 && part[u] == to ? w : 0) -
+                  (nFrom == 0 ? w : 0) +
+                  (nFrom == 1 && part[u] == from ? w : 0);
+
+               if (delta == 0) {
+                  continue;
+               }
+
+               gain[u] += delta;
+
+               if (mark[u] != stamp) {
+                  mark[u] = stamp;
+                  touched.push_back(u);
+               }
+            }
+         }
+
+         for (i = 0; i < static_cast<int>(touched.size()); i++) {
+            u = touched[i];
+            heap[part[u]].push(GainVertex(gain[u], u));
+         }
+
+         if (curViol < bestViol ||
+               (curViol == bestViol && curCut < bestCut)) {
+            bestViol = curViol;
+            bestCut  = curCut;
+            bestLen  = static_cast<int>(moves.size());
+            nBad     = 0;
+         } else if (++nBad > maxBad) {
+            break;
+         }
+      }
+
+      //---
+      //--- roll back the moves after the best prefix
+      //---
+      for (i = static_cast<int>(moves.size()) - 1; i >= bestLen; i--) {
+         v = moves[i];
+         const int from = part[v];
+         const int to   = 1 - from;
+         part[v]   = to;
+         W[from]  -= H.vwgt[v];
+         W[to]    += H.vwgt[v];
+
+         for (j = H.vptr[v]; j < H.vptr[v + 1]; j++) {
+            e = H.vind[j];
+            pc[2 * e + from]--;
+            pc[2 * e + to]++;
+         }
+      }
+
+      const bool improved = bestViol < viol ||
+                            (bestViol == viol && bestCut < cut);
+      viol = bestViol;
+      cut  = bestCut;
+
+      if (!improved) {
+         break;
+      }
+   }
+}
+
+//===========================================================================//
+/**
+ * One level of coarsening. Vertices are visited in random order and
+ * matched with the unmatched neighbor they share the most hyperedge
+ * weight with (each net weighted by 1/(size-1)). Vertices left without
+ * a partner are paired among themselves so that loosely connected
+ * vertices do not stall the coarsening. Returns false if the level
+ * would not shrink the hypergraph enough.
+ */
+static bool UtilHgCoarsen(const UtilHg&     fine,
+                          UtilHg&           coarse,
+                          std::vector<int>& cmap,
+                          const int         maxVWgt,
+                          UtilHgRand&       rnd)
+{
+   int                 v, u, e, i, j, k;
+   const int           nV = fine.nV;
+   std::vector<int>    order(nV);
+   std::vector<int>    match(nV, -1);
+   std::vector<double> score(nV, 0.0);
+   std::vector<int>    touched;
+   int                 lonely = -1;
+
+   for (v = 0; v < nV; v++) {
+      order[v] = v;
+   }
+
+   for (v = nV - 1; v > 0; v--) {
+      std::swap(order[v], order[rnd.next(v + 1)]);
+   }
+
+   for (k = 0; k < nV; k++) {
+      v = order[k];
+
+      if (match[v] >= 0) {
+         continue;
+      }
+
+      touched.clear();
+
+      for (j = fine.vptr[v]; j < fine.vptr[v + 1]; j++) {
+         e = fine.vind[j];
+         const int size = fine.eptr[e + 1] - fine.eptr[e];
+
+         if (size > UtilHgMaxNetSize) {
+            continue;
+         }
+
+         const double w = fine.ewgt[e] / static_cast<double>(size - 1);
+
+         for (i = fine.eptr[e]; i < fine.eptr[e + 1]; i++) {
+            u = fine.eind[i];
+
+            if (u == v || match[u] >= 0 ||
+                  fine.vwgt[u] + fine.vwgt[v] > maxVWgt) {
+               continue;
+            }
+
+            if (score[u] == 0.0) {
+               touched.push_back(u);
+            }
+
+            score[u] += w;
+         }
+      }
+
+      int    best      = -1;
+      double bestScore = 0.0;
+
+      for (i = 0; i < static_cast<int>(touched.size()); i++) {
+         u = touched[i];
+
+         if (score[u] > bestScore ||
+               (best >= 0 && score[u] == bestScore &&
+                fine.vwgt[u] < fine.vwgt[best])) {
+            best      = u;
+            bestScore = score[u];
+         }
+
+         score[u] = 0.0;
+      }
+
+      if (best < 0 && lonely >= 0 && match[lonely] == lonely &&
+            fine.vwgt[lonely] + fine.vwgt[v] <= maxVWgt) {
+         best   = lonely;
+         lonely = -1;
+      }
+
+      if (best >= 0) {
+         match[v]    = best;
+         match[best] = v;
+      } else {
+         match[v] = v;
+         lonely   = v;
+      }
+   }
+
+   //---
+   //--- number the coarse vertices
+   //---
+   int nC = 0;
+   cmap.assign(nV, -1);
+
+   for (v = 0; v < nV; v++) {
+      if (cmap[v] < 0) {
+         cmap[v] = cmap[match[v]] = nC++;
+      }
+   }
+
+   if (nC > (1.0 - UtilHgMinReduction) * nV) {
+      return false;
+   }
+
+   coarse.nV = nC;
+   coarse.vwgt.assign(nC, 0);
+
+   for (v = 0; v < nV; v++) {
+      coarse.vwgt[cmap[v]] += fine.vwgt[v];
+   }
+
+   //---
+   //--- contract the nets, dropping those left with a single pin
+   //---
+   std::vector<int> seen(nC, -1);
+   coarse.eptr.assign(1, 0);
+   coarse.eind.clear();
+   coarse.ewgt.clear();
+   coarse.eind.reserve(fine.eptr[fine.nE]);
+
+   for (e = 0; e < fine.nE; e++) {
+      const int start = static_cast<int>(coarse.eind.size());
+
+      for (i = fine.eptr[e]; i < fine.eptr[e + 1]; i++) {
+         const int c = cmap[fine.eind[i]];
+
+         if (seen[c] != e) {
+            seen[c] = e;
+            coarse.eind.push_back(c);
+         }
+      }
+
+      if (static_cast<int>(coarse.eind.size()) - start < 2) {
+         coarse.eind.resize(start);
+      } else {
+         coarse.ewgt.push_back(fine.ewgt[e]);
+         coarse.eptr.push_back(static_cast<int>(coarse.eind.size()));
+      }
+   }
+
+   coarse.nE = static_cast<int>(coarse.ewgt.size());
+   coarse.buildIncidence();
+   return true;
+}
+
+//===========================================================================//
+/**
+ * Greedy growing on the coarsest hypergraph: breadth-first from a random
+ * vertex (restarting at random when the front dies out) until side 0
+ * has its target weight.
+ */
+static void UtilHgGrow(const UtilHg&     H,
+                       std::vector<int>& part,
+                       const int         target0,
+                       const int         maxW0,
+                       UtilHgRand&       rnd)
+{
+   int               v, u, e, i, j;
+   int               W0       = 0;
+   int               nVisited = 0;
+   std::vector<char> visited(H.nV, 0);
+   std::queue<int>   front;
+   part.assign(H.nV, 1);
+
+   while (W0 < target0 && nVisited < H.nV) {
+      if (front.empty()) {
+         v = rnd.next(H.nV);
+
+         while (visited[v]) {
+            v = (v + 1) % H.nV;
+         }
+
+         visited[v] = 1;
+         nVisited++;
+         front.push(v);
+      }
+
+      v = front.front();
+      front.pop();
+
+      if (W0 + H.vwgt[v] > maxW0) {
+         continue;
+      }
+
+      part[v] = 0;
+      W0     += H.vwgt[v];
+
+      for (j = H.vptr[v]; j < H.vptr[v + 1]; j++) {
+         e = H.vind[j];
+
+         if (H.eptr[e + 1] - H.eptr[e] > UtilHgMaxNetSize) {
+            continue;
+         }
+
+         for (i = H.eptr[e]; i < H.eptr[e + 1]; i++) {
+            u = H.eind[i];
+
+            if (!visited[u]) {
+               visited[u] = 1;
+               nVisited++;
+               front.push(u);
+            }
+         }
+      }
+   }
+}
+
+//===========================================================================//
+/**
+ * Multilevel bisection of H into sides with weight fractions frac0 and
+ * 1-frac0, each allowed to exceed its share by a factor (1+eps).
+ */
+static void UtilHgBisect(const UtilHg&    H,
+                         const double     frac0,
+                         const double     eps,
+                         const int        seed,
+                         UtilHgBisection& result)
+{
+   int                          l, t, v;
+   UtilHgRand                   rnd(seed);
+   const int                    totW = H.totalVWgt();
+   int                          maxW[2];
+   const int                    target0 = static_cast<int>(frac0 * totW + 0.5);
+   maxW[0] = std::max(target0,
+                      static_cast<int>(frac0 * totW * (1.0 + eps)));
+   maxW[1] = std::max(totW - target0,
+                      static_cast<int>((1.0 - frac0) * totW * (1.0 + eps)));
+   const int maxVWgt = std::max(1, static_cast<int>
+                                (std::ceil(1.5 * totW / UtilHgCoarsenTo)));
+   //---
+   //--- coarsen
+   //---
+   std::vector<UtilHg*>          levels;
+   std::vector<std::vector<int> > cmaps;
+   const UtilHg*                 cur = &H;
+
+   while (cur->nV > UtilHgCoarsenTo) {
+      UtilHg*          coarse = new UtilHg;
+      std::vector<int> cmap;
+
+      if (!UtilHgCoarsen(*cur, *coarse, cmap, maxVWgt, rnd)) {
+         delete coarse;
+         break;
+      }
+
+      levels.push_back(coarse);
+      cmaps.push_back(cmap);
+      cur = coarse;
+   }
+
+   //---
+   //--- initial bisection: best of several grown + refined trials
+   //---
+   std::vector<int> trial;
+   int              viol, cut;
+   result.part.clear();
+
+   for (t = 0; t < UtilHgInitTrials; t++) {
+      UtilHgGrow(*cur, trial, target0, maxW[0], rnd);
+      UtilHgRefineFM(*cur, trial, maxW, UtilHgFMPasses, viol, cut);
+
+      if (result.part.empty() || result.isBetter(viol, cut)) {
+         result.part.swap(trial);
+         result.viol = viol;
+         result.cut  = cut;
+      }
+   }
+
+   //---
+   //--- uncoarsen: project and refine on every level
+   //---
+   for (l = static_cast<int>(levels.size()) - 1; l >= 0; l--) {
+      const UtilHg&           fine = l ? *levels[l - 1] : H;
+      const std::vector<int>& cmap = cmaps[l];
+      std::vector<int>        finePart(fine.nV);
+
+      for (v = 0; v < fine.nV; v++) {
+         finePart[v] = result.part[cmap[v]];
+      }
+
+      UtilHgRefineFM(fine, finePart, maxW, UtilHgFMPasses,
+                     result.viol, result.cut);
+      result.part.swap(finePart);
+      delete levels[l];
+   }
+}
+
+//===========================================================================//
+/** Sub-hypergraph of one side; nets cut by the bisection are dropped. */
+static void UtilHgExtract(const UtilHg&           H,
+                          const std::vector<int>& bisection,
+                          const int               side,
+                          const std::vector<int>& label,
+                          UtilHg&                 sub,
+                          std::vector<int>&       subLabel)
+{
+   int              v, e, i;
+   std::vector<int> newId(H.nV, -1);
+   sub.nV = 0;
+
+   for (v = 0; v < H.nV; v++) {
+      if (bisection[v] == side) {
+         newId[v] = sub.nV++;
+         sub.vwgt.push_back(H.vwgt[v]);
+         subLabel.push_back(label[v]);
+      }
+   }
+
+   sub.eptr.assign(1, 0);
+
+   for (e = 0; e < H.nE; e++) {
+      for (i = H.eptr[e]; i < H.eptr[e + 1]; i++) {
+         if (newId[H.eind[i]] < 0) {
+            break;
+         }
+      }
+
+      if (i < H.eptr[e + 1]) {
+         continue;
+      }
+
+      for (i = H.eptr[e]; i < H.eptr[e + 1]; i++) {
+         sub.eind.push_back(newId[H.eind[i]]);
+      }
+
+      sub.ewgt.push_back(H.ewgt[e]);
+      sub.eptr.push_back(static_cast<int>(sub.eind.size()));
+   }
+
+   sub.nE = static_cast<int>(sub.ewgt.size());
+   sub.buildIncidence();
+}
+
+//===========================================================================//
+static void UtilHgRecurseHalves(const UtilHg&           sub0,
+                                const std::vector<int>& label0,
+                                const UtilHg&           sub1,
+                                const std::vector<int>& label1,
+                                const int               nParts,
+                                const int               partBase,
+                                const double            eps,
+                                const int               seed,
+                                int*                    part);
+
+//===========================================================================//
+/**
+ * Split H into nParts parts numbered from partBase. label maps the
+ * vertices of H back to the original ones. With nRuns > 1 (only at the
+ * top, outside of any parallel region) the bisection is tried with
+ * nRuns seeds in parallel and the recursion runs as OpenMP tasks.
+ */
+static void UtilHgRecurse(const UtilHg&           H,
+                          const std::vector<int>& label,
+                          const int               nParts,
+                          const int               partBase,
+                          const double            eps,
+                          const int               seed,
+                          const int               nRuns,
+                          int*                    part)
+{
+   int v, r;
+
+   if (nParts == 1 || H.nV <= 1) {
+      for (v = 0; v < H.nV; v++) {
+         part[label[v]] = partBase;
+      }
+
+      return;
+   }
+
+   const int    nParts0 = nParts / 2;
+   const double frac0   = nParts0 / static_cast<double>(nParts);
+   std::vector<UtilHgBisection> runs(nRuns);
+#ifdef _OPENMP
+   #pragma omp parallel for schedule(dynamic) num_threads(nRuns) if (nRuns > 1)
+#endif
+
+   for (r = 0; r < nRuns; r++) {
+      UtilHgBisect(H, frac0, eps, seed + 7919 * r, runs[r]);
+   }
+
+   int best = 0;
+
+   for (r = 1; r < nRuns; r++) {
+      if (runs[best].isBetter(runs[r].viol, runs[r].cut)) {
+         best = r;
+      }
+   }
+
+   UtilHg           sub0, sub1;
+   std::vector<int> label0, label1;
+   UtilHgExtract(H, runs[best].part, 0, label, sub0, label0);
+   UtilHgExtract(H, runs[best].part, 1, label, sub1, label1);
+   runs.clear();
+
+   //---
+   //--- the two halves are independent; below the top, we are already
+   //---   running as a task of the team started here
+   //---
+   if (nRuns > 1) {
+#ifdef _OPENMP
+      #pragma omp parallel num_threads(nRuns)
+      #pragma omp single
+#endif
+      UtilHgRecurseHalves(sub0, label0, sub1, label1, nParts, partBase,
+                          eps, seed, part);
+   } else {
+      UtilHgRecurseHalves(sub0, label0, sub1, label1, nParts, partBase,
+                          eps, seed, part);
+   }
+}
+
+//===========================================================================//
+static void UtilHgRecurseHalves(const UtilHg&           sub0,
+                                const std::vector<int>& label0,
+                                const UtilHg&           sub1,
+                                const std::vector<int>& label1,
+                                const int               nParts,
+                                const int               partBase,
+                                const double            eps,
+                                const int               seed,
+                                int*                    part)
+{
+   const int nParts0 = nParts / 2;
+#ifdef _OPENMP
+   #pragma omp task
+#endif
+   UtilHgRecurse(sub0, label0, nParts0, partBase,
+                 eps, 2 * seed + 1, 1, part);
+#ifdef _OPENMP
+   #pragma omp task
+#endif
+   UtilHgRecurse(sub1, label1, nParts - nParts0, partBase + nParts0,
+                 eps, 2 * seed + 2, 1, part);
+#ifdef _OPENMP
+   #pragma omp taskwait
+#endif
+}
+
+//===========================================================================//
+int UtilHypergraphPartition(const int  nvtxs,
+                            const int  nhedges,
+                            const int* vwgts,
+                            const int* eptr,
+                            const int* eind,
+                            const int* hewgts,
+                            const int  nparts,
+                            const int  ubfactor,
+                            const int  nThreads,
+                            const int  seed,
+                            int*       part)
+{
+   int    v, e, i;
+   UtilHg H;
+   H.nV = nvtxs;
+   H.vwgt.resize(nvtxs);
+
+   for (v = 0; v < nvtxs; v++) {
+      H.vwgt[v] = vwgts ? vwgts[v] : 1;
+      part[v]   = 0;
+   }
+
+   //---
+   //--- copy the nets, skipping repeated pins and nets with one pin
+   //---
+   std::vector<int> seen(nvtxs, -1);
+   H.eptr.assign(1, 0);
+   H.eind.reserve(eptr[nhedges]);
+
+   for (e = 0; e < nhedges; e++) {
+      const int start = static_cast<int>(H.eind.size());
+
+      for (i = eptr[e]; i < eptr[e + 1]; i++) {
+         if (seen[eind[i]] != e) {
+            seen[eind[i]] = e;
+            H.eind.push_back(eind[i]);
+         }
+      }
+
+      if (static_cast<int>(H.eind.size()) - start < 2) {
+         H.eind.resize(start);
+      } else {
+         H.ewgt.push_back(hewgts ? hewgts[e] : 1);
+         H.eptr.push_back(static_cast<int>(H.eind.size()));
+      }
+   }
+
+   H.nE = static_cast<int>(H.ewgt.size());
+   H.buildIncidence();
+
+   if (nparts > 1) {
+      std::vector<int> label(nvtxs);
+
+      for (v = 0; v < nvtxs; v++) {
+         label[v] = v;
+      }
+
+      //---
+      //--- as in HMETIS_PartRecursive, each bisection may deviate
+      //---   ubfactor percent from an even split
+      //---
+      const double eps = 2.0 * std::max(1, ubfactor) / 100.0;
+      UtilHgRecurse(H, label, nparts, 0, eps, seed,
+                    std::max(1, nThreads), part);
+   }
+
+   //---
+   //--- number of cut nets
+   //---
+   int cut = 0;
+
+   for (e = 0; e < nhedges; e++) {
+      for (i = eptr[e] + 1; i < eptr[e + 1]; i++) {
+         if (part[eind[i]] != part[eind[eptr[e]]]) {
+            cut += hewgts ? hewgts[e] : 1;
+            break;
+         }
+      }
+   }
+
+   return cut;
+}
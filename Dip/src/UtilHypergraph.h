@@ -0,0 +1,53 @@
+//===========================================================================//
+// This file is part of the DIP Solver Framework.                            //
+//                                                                           //
+// DIP is distributed under the Eclipse Public License as part of the        //
+// COIN-OR repository (http://www.coin-or.org).                              //
+//                                                                           //
+// Authors: Matthew Galati, SAS Institute Inc. (matthew.galati@sas.com)      //
+//          Ted Ralphs, Lehigh University (ted@lehigh.edu)                   //
+//          Jiadong Wang, Lehigh University (jiw508@lehigh.edu)              //
+//                                                                           //
+// Copyright (C) 2002-2018, Lehigh University, Matthew Galati, Ted Ralphs    //
+// All Rights Reserved.                                                      //
+//===========================================================================//
+
+#ifndef UTIL_HYPERGRAPH_INCLUDED
+#define UTIL_HYPERGRAPH_INCLUDED
+
+//===========================================================================//
+/**
+ * Built-in multilevel hypergraph partitioner, used for automatic block
+ * detection when DIP is not linked against hMetis or PaToH.
+ *
+ * The input follows the hMetis conventions: vertices are 0..nvtxs-1 and
+ * the pins of hyperedge e are eind[eptr[e]..eptr[e+1]-1]. Weights may be
+ * NULL (unit weights).
+ *
+ * The partition is computed by recursive bisection. Each bisection is a
+ * V-cycle: coarsening by heavy-connectivity matching, greedy growing on
+ * the coarsest hypergraph, then Fiduccia-Mattheyses refinement on every
+ * level. ubfactor has the meaning of HMETIS_PartRecursive: every
+ * bisection may be off by ubfactor percent from an even split. With
+ * nThreads > 1, the top bisection is tried with nThreads seeds in
+ * parallel and the two halves of every bisection are partitioned (and
+ * refined) as independent OpenMP tasks.
+ *
+ * On return, part[v] is in [0, nparts). The function returns the
+ * weighted number of cut hyperedges (those with pins in more than one
+ * part).
+ */
+//===========================================================================//
+int UtilHypergraphPartition(const int  nvtxs,
+                            const int  nhedges,
+                            const int* vwgts,
+                            const int* eptr,
+                            const int* eind,
+                            const int* hewgts,
+                            const int  nparts,
+                            const int  ubfactor,
+                            const int  nThreads,
+                            const int  seed,
+                            int*       part);
+
+#endif
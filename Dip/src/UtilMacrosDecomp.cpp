@@ -17,6 +17,9 @@
 #include "DecompApp.h"
 #define SPACES " \t\r\n"
 //===========================================================================//
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -59,6 +62,73 @@ void UtilPackedVectorFromDense(const int          len,
    }
 }
 
+// ------------------------------------------------------------------------- //
+double UtilSparseDot(const int      len,
+                     const int*     ind,
+                     const double* els,
+                     const double* x)
+{
+   int    i   = 0;
+   double sum = 0.0;
+#if defined(__AVX512F__)
+
+   if (len >= 8) {
+      __m512d acc = _mm512_setzero_pd();
+
+      for (; i + 8 <= len; i += 8) {
+         const __m256i vInd
+            = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ind + i));
+         acc = _mm512_fmadd_pd(_mm512_loadu_pd(els + i),
+                               _mm512_i32gather_pd(vInd, x, 8), acc);
+      }
+
+      sum = _mm512_reduce_add_pd(acc);
+   }
+
+#elif defined(__AVX2__)
+
+   if (len >= 4) {
+      __m256d acc = _mm256_setzero_pd();
+      double  part[4];
+
+      for (; i + 4 <= len; i += 4) {
+         const __m128i vInd
+            = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ind + i));
+         const __m256d vX = _mm256_i32gather_pd(x, vInd, 8);
+#ifdef __FMA__
+         acc = _mm256_fmadd_pd(_mm256_loadu_pd(els + i), vX, acc);
+#else
+         acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_loadu_pd(els + i), vX));
+#endif
+      }
+
+      _mm256_storeu_pd(part, acc);
+      sum = (part[0] + part[1]) + (part[2] + part[3]);
+   }
+
+#endif
+
+   for (; i < len; i++) {
+      sum += els[i] * x[ind[i]];
+   }
+
+   return sum;
+}
+
+// ------------------------------------------------------------------------- //
+void UtilSparseColsDot(const int      nCols,
+                       const int*     colBeg,
+                       const int*     ind,
+                       const double* els,
+                       const double* x,
+                       double*       out)
+{
+   for (int k = 0; k < nCols; k++) {
+      const int beg = colBeg[k];
+      out[k] = UtilSparseDot(colBeg[k + 1] - beg, ind + beg, els + beg, x);
+   }
+}
+
 // ------------------------------------------------------------------------- //
 void UtilPrintPackedVector(const CoinPackedVector& v,
                            ostream*                 os,
@@ -185,6 +185,29 @@ void UtilPackedVectorFromDense(const int          len,
                                const double       etol,
                                CoinPackedVector& v);
 
+// ------------------------------------------------------------------------- //
+/**
+ * Sparse times dense dot product: sum{i < len} els[i] * x[ind[i]].
+ *
+ * Uses AVX-512 or AVX2 gathers if DIP is compiled for them (for example,
+ * with -march=native), scalar code otherwise.
+ */
+double UtilSparseDot(const int      len,
+                     const int*     ind,
+                     const double* els,
+                     const double* x);
+
+/**
+ * x times each column of a (CSC) block of columns:
+ *   out[k] = sum{i = colBeg[k], ..., colBeg[k+1]-1} els[i] * x[ind[i]].
+ */
+void UtilSparseColsDot(const int      nCols,
+                       const int*     colBeg,
+                       const int*     ind,
+                       const double* els,
+                       const double* x,
+                       double*       out);
+
 void UtilPrintPackedVector(const CoinPackedVector& v,
                            std::ostream*                 os  = &std::cout,
                            DecompApp*               app = 0);